@@ -0,0 +1,51 @@
+#include "stateup/core/executor.hpp"
+#include "stateup/tree/nodes/action.hpp"
+#include "stateup/tree/nodes/parallel.hpp"
+#include "stateup/tree/tree.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+using namespace stateup::tree;
+
+// A Parallel over eight condition-like children that each take well under a microsecond. With a pool threshold
+// of zero every child goes through the executor, as before adaptive dispatch; with the default threshold the
+// measured children are ticked inline and the executor is never touched.
+
+namespace {
+    constexpr int kChildren = 8;
+    constexpr int kTicks = 20'000;
+
+    double run(std::chrono::nanoseconds threshold, stateup::core::ThreadPool &pool) {
+        auto parallel = std::make_shared<Parallel>(Parallel::Policy::RequireAll, Parallel::Policy::RequireOne);
+        parallel->setExecutor(&pool);
+        parallel->setPoolThreshold(threshold);
+        for (int c = 0; c < kChildren; ++c) {
+            parallel->addChild(std::make_shared<Action>([c](Blackboard &bb) {
+                return bb.get<int>("limit").value_or(0) > c ? Status::Success : Status::Running;
+            }));
+        }
+        Tree tree(parallel);
+        tree.blackboard().set("limit", 0);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < kTicks; ++t) {
+            tree.tick();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / kTicks;
+    }
+} // namespace
+
+int main() {
+    stateup::core::ThreadPool pool(4);
+    const double pooledNs = run(std::chrono::nanoseconds(0), pool);
+    const double adaptiveNs = run(stateup::core::kDefaultPoolThreshold, pool);
+
+    std::cout << kChildren << " cheap children, " << kTicks << " ticks\n"
+              << std::fixed << std::setprecision(0) << "always pooled: " << std::setw(8) << pooledNs << " ns/tick\n"
+              << "adaptive:      " << std::setw(8) << adaptiveNs << " ns/tick  (" << std::setprecision(1)
+              << pooledNs / adaptiveNs << "x)\n";
+    return 0;
+}
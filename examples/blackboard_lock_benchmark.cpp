@@ -0,0 +1,57 @@
+#include "stateup/tree/structure/blackboard.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace stateup::tree;
+
+static const char *policyName(LockPolicy policy) {
+    switch (policy) {
+    case LockPolicy::None:
+        return "None";
+    case LockPolicy::Mutex:
+        return "Mutex";
+    case LockPolicy::SharedMutex:
+        return "SharedMutex";
+    case LockPolicy::Sharded:
+        return "Sharded";
+    }
+    return "?";
+}
+
+int main() {
+    constexpr int kKeys = 32;
+    constexpr int kIterations = 2'000'000;
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < kKeys; ++i) {
+        keys.push_back("key_" + std::to_string(i));
+    }
+
+    std::cout << "Blackboard get/set hot path, " << kIterations << " ops per row\n";
+    for (auto policy : {LockPolicy::None, LockPolicy::Mutex, LockPolicy::SharedMutex, LockPolicy::Sharded}) {
+        Blackboard bb(policy);
+        for (int i = 0; i < kKeys; ++i) {
+            bb.set(keys[i], i);
+        }
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; ++i) {
+            bb.set(keys[i % kKeys], i);
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        long long sum = 0;
+        for (int i = 0; i < kIterations; ++i) {
+            sum += bb.get<int>(keys[i % kKeys]).value_or(0);
+        }
+        auto t2 = std::chrono::steady_clock::now();
+
+        auto setNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / kIterations;
+        auto getNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / kIterations;
+        std::cout << std::left << std::setw(12) << policyName(policy) << std::fixed << std::setprecision(1)
+                  << " set: " << setNs << " ns/op, get: " << getNs << " ns/op (checksum " << sum << ")\n";
+    }
+    return 0;
+}
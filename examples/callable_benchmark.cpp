@@ -0,0 +1,97 @@
+#include <stateup/stateup.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace stateup;
+using namespace stateup::tree;
+
+// Callback-bound ticks: a sequence of 32 inverted actions, and a state machine checking 32 transition conditions
+// that never fire. Every callback captures three pointers, which is more than std::function stores inline, so
+// with std::function each call first chases a pointer to a heap block. Inplace callables keep the capture inside
+// the node. The last line ticks 5,000 copies of the tree in turn, so every tick starts with its nodes out of cache.
+
+namespace {
+    constexpr int kCallbacks = 32;
+    constexpr int kTicks = 200'000;
+    constexpr int kColdTrees = 5'000;
+    constexpr int kColdRuns = 20;
+
+    struct Counters {
+        long calls = 0;
+        long threshold = 1;
+        long scale = 1;
+    };
+
+    template <typename F> double nsPerTick(F &&tick) {
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < kTicks; ++t) {
+            tick();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / kTicks;
+    }
+} // namespace
+
+int main() {
+    Counters counters;
+    long *calls = &counters.calls;
+    const long *threshold = &counters.threshold;
+    const long *scale = &counters.scale;
+
+    Builder builder;
+    builder.sequence();
+    for (int i = 0; i < kCallbacks; ++i) {
+        builder.inverter().action([calls, threshold, scale](Blackboard &) {
+            *calls += *scale;
+            return *calls >= *threshold ? Status::Failure : Status::Success;
+        });
+    }
+    Tree tree(builder.end().buildRoot(), LockPolicy::None);
+
+    state::StateMachine machine;
+    auto idle = std::make_shared<state::State>("Idle");
+    auto walk = std::make_shared<state::State>("Walk");
+    machine.addState(idle);
+    machine.addState(walk);
+    machine.setInitialState(idle);
+    for (int i = 0; i < kCallbacks; ++i) {
+        machine.addTransition(idle, walk, [calls, threshold, scale](Blackboard &) {
+            *calls += *scale;
+            return *calls < *threshold;
+        });
+    }
+
+    // The same tree many times over, ticked round-robin, so each tick finds its nodes out of cache
+    std::vector<std::unique_ptr<Tree>> forest;
+    forest.reserve(kColdTrees);
+    for (int t = 0; t < kColdTrees; ++t) {
+        Builder cold;
+        cold.sequence();
+        for (int i = 0; i < kCallbacks; ++i) {
+            cold.inverter().action([calls, threshold, scale](Blackboard &) {
+                *calls += *scale;
+                return *calls >= *threshold ? Status::Failure : Status::Success;
+            });
+        }
+        forest.push_back(std::make_unique<Tree>(cold.end().buildRoot(), LockPolicy::None));
+    }
+
+    const double treeNs = nsPerTick([&] { tree.tick(); });
+    const double machineNs = nsPerTick([&] { machine.tick(); });
+    auto start = std::chrono::steady_clock::now();
+    for (int run = 0; run < kColdRuns; ++run) {
+        for (auto &cold : forest)
+            cold->tick();
+    }
+    auto end = std::chrono::steady_clock::now();
+    const double coldNs = std::chrono::duration<double, std::nano>(end - start).count() / (kColdRuns * kColdTrees);
+
+    std::cout << kCallbacks << " callbacks per tick, " << kTicks << " ticks (" << counters.calls << " calls)\n"
+              << std::fixed << std::setprecision(0) << "tree:          " << treeNs << " ns/tick\n"
+              << "state machine: " << machineNs << " ns/tick\n"
+              << "cold trees:    " << coldNs << " ns/tick (" << kColdTrees << " trees, round-robin)\n";
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include "stateup/tree/builder.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace stateup::tree;
+
+// 2401-node tree (root sequence, 400 selectors of an inverted action and three actions) ticked as the pointer
+// tree and as a CompiledTree. Callbacks are trivial so the numbers show traversal cost.
+
+constexpr int kGroups = 400;
+constexpr int kTicks = 5'000;
+
+static void describe(Builder &builder, long &counter) {
+    builder.lockPolicy(LockPolicy::None).sequence();
+    for (int g = 0; g < kGroups; ++g) {
+        builder.selector()
+            .inverter()
+            .action([&counter](Blackboard &) {
+                ++counter;
+                return Status::Success;
+            })
+            .action([&counter](Blackboard &) {
+                ++counter;
+                return Status::Failure;
+            })
+            .action([&counter](Blackboard &) {
+                ++counter;
+                return Status::Success;
+            })
+            .action([&counter](Blackboard &) {
+                ++counter;
+                return Status::Success;
+            })
+            .end();
+    }
+    builder.end();
+}
+
+template <typename TreeT> static double nsPerTick(TreeT &tree) {
+    for (int i = 0; i < 100; ++i) // warm up
+        tree.tick();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kTicks; ++i)
+        tree.tick();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / kTicks;
+}
+
+int main() {
+    long pointerCalls = 0, compiledCalls = 0;
+
+    Builder pointerBuilder;
+    describe(pointerBuilder, pointerCalls);
+    auto tree = pointerBuilder.build();
+
+    Builder compiledBuilder;
+    describe(compiledBuilder, compiledCalls);
+    auto compiled = compiledBuilder.buildCompiled();
+
+    double pointerNs = nsPerTick(tree);
+    double compiledNs = nsPerTick(compiled);
+
+    std::cout << "Tick cost of a " << compiled.size() << "-node tree, " << kTicks << " ticks per row\n"
+              << std::fixed << std::setprecision(0) << "pointer tree:  " << std::setw(8) << pointerNs
+              << " ns/tick\ncompiled tree: " << std::setw(8) << compiledNs << " ns/tick  (" << std::setprecision(2)
+              << pointerNs / compiledNs << "x)\n";
+    if (pointerCalls != compiledCalls) {
+        std::cout << "  mismatch between modes!\n";
+    }
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <stateup/stateup.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace stateup::tree;
+
+// A mostly idle guard tree: a selector over 40 sensor checks that each read two keys and a few derived values,
+// followed by an idle action. Only one sensor changes every 100 ticks. The plain tree evaluates every check each
+// tick; the cached tree wraps each check in cached() and the whole selector once more, so a tick without writes
+// is one revision comparison and a tick after a write re-runs only the check that read the changed key.
+
+namespace {
+    constexpr int kSensors = 40;
+    constexpr int kTicks = 200'000;
+
+    Status check(Blackboard &bb, int sensor) {
+        const std::string prefix = "sensor" + std::to_string(sensor);
+        const double value = bb.get<double>(prefix + ".value").value_or(0.0);
+        const double limit = bb.get<double>(prefix + ".limit").value_or(1.0);
+        double filtered = value;
+        for (int i = 0; i < 8; ++i) {
+            filtered = 0.5 * filtered + 0.5 * value;
+        }
+        return filtered > limit ? Status::Success : Status::Failure;
+    }
+
+    Tree build(bool cached) {
+        Builder builder;
+        builder.lockPolicy(LockPolicy::None);
+        if (cached)
+            builder.cached();
+        builder.selector();
+        for (int s = 0; s < kSensors; ++s) {
+            if (cached)
+                builder.cached();
+            builder.action([s](Blackboard &bb) { return check(bb, s); });
+        }
+        return builder.action([](Blackboard &) { return Status::Success; }).end().build();
+    }
+
+    double run(Tree &tree) {
+        auto &bb = tree.blackboard();
+        for (int s = 0; s < kSensors; ++s) {
+            bb.set("sensor" + std::to_string(s) + ".value", 0.2);
+            bb.set("sensor" + std::to_string(s) + ".limit", 1.0);
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < kTicks; ++t) {
+            if (t % 100 == 0)
+                bb.set("sensor" + std::to_string(t / 100 % kSensors) + ".value", 0.1 + 0.001 * (t % 7));
+            tree.tick();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / kTicks;
+    }
+} // namespace
+
+int main() {
+    Tree plain = build(false);
+    Tree cached = build(true);
+    const double plainNs = run(plain);
+    const double cachedNs = run(cached);
+
+    std::cout << kSensors << " sensor checks, " << kTicks << " ticks, one input change per 100 ticks\n"
+              << std::fixed << std::setprecision(0) << "plain:   " << std::setw(6) << plainNs << " ns/tick\n"
+              << "cached:  " << std::setw(6) << cachedNs << " ns/tick  (" << std::setprecision(1)
+              << plainNs / cachedNs << "x)\n";
+    return 0;
+}
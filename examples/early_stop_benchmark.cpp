@@ -1,3 +1,4 @@
+#include "stateup/core/executor.hpp"
 #include "stateup/tree/builder.hpp"
 #include "stateup/tree/tree.hpp"
 #include <chrono>
@@ -12,33 +13,45 @@ static Status fast_success(Blackboard &) {
 }
 
 static Status slow_failure(Blackboard &) {
-    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    // Cooperative cancellation: a concurrent Parallel asks losing children to stop
+    for (int i = 0; i < 20 && !cancellationRequested(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
     return Status::Failure;
 }
 
-int main() {
+static void run(const char *label, bool concurrent, stateup::core::ThreadPool &pool) {
     // Build a parallel tree that succeeds when any child succeeds (RequireOne)
     Builder b;
-    b.parallel(Parallel::Policy::RequireOne, Parallel::Policy::RequireOne)
-        .action(slow_failure)
-        .action(slow_failure)
-        .action(fast_success)
-        .end();
+    b.executor(&pool);
+    if (concurrent)
+        b.concurrentParallel(Parallel::Policy::RequireOne, Parallel::Policy::RequireAll);
+    else
+        b.parallel(Parallel::Policy::RequireOne, Parallel::Policy::RequireAll);
+    b.action(slow_failure).action(slow_failure).action(fast_success).end();
 
     Tree t = b.build();
 
     auto t0 = std::chrono::steady_clock::now();
     auto status = t.tick();
+    auto firstTick = std::chrono::steady_clock::now() - t0;
     while (status == Status::Running) {
-        status = t.tick();
+        status = t.tickWhenReady();
     }
     auto t1 = std::chrono::steady_clock::now();
 
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
-    std::cout << "Parallel finished with status: "
+    std::cout << label << " parallel finished with status: "
               << (status == Status::Success   ? "Success"
                   : status == Status::Failure ? "Failure"
                                               : "Running")
-              << ", elapsed: " << ms << " ms\n";
+              << ", elapsed: " << ms << " ms, first tick returned after "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(firstTick).count() << " ms\n";
+}
+
+int main() {
+    stateup::core::ThreadPool pool(3);
+    run("Blocking  ", false, pool);
+    run("Concurrent", true, pool);
     return 0;
 }
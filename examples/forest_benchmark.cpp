@@ -0,0 +1,126 @@
+#include <stateup/stateup.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace stateup;
+using namespace stateup::tree;
+
+// Scales a fleet of pea harvesters from 1k to 100k agents. Each agent runs the harvester loop from
+// pea_harvester_demo_fixed.cpp in reduced form: step four PI-controlled components, retune the worst one when
+// the machine is not optimal, and harvest until the hopper is full. Agents are TreeInstances of one definition
+// in a Forest, ticked with tickUnfinished() on the calling thread and across a thread pool.
+
+namespace {
+    constexpr std::array<const char *, 4> kComponents = {"wheel", "beater", "fan", "sieve"};
+    constexpr std::array<double, 4> kSetpoints = {120.0, 95.0, 75.0, 6.0};
+    constexpr int kFrames = 20;
+
+    double efficiency(Blackboard &bb, size_t c) {
+        const double setpoint = bb.get<double>(std::string(kComponents[c]) + ".setpoint").value_or(1.0);
+        const double value = bb.get<double>(std::string(kComponents[c]) + ".value").value_or(0.0);
+        return std::max(0.0, 1.0 - std::abs(setpoint - value) / setpoint);
+    }
+
+    TreeDefinition::Ptr harvester() {
+        return TreeDefinition::define([](Builder &builder) {
+            builder.sequence()
+                .action([](Blackboard &bb) {
+                    for (const char *name : kComponents) {
+                        const std::string key(name);
+                        double value = bb.get<double>(key + ".value").value_or(0.0);
+                        double error = bb.get<double>(key + ".setpoint").value_or(0.0) - value;
+                        double integral = bb.get<double>(key + ".integral").value_or(0.0) + error * 0.1;
+                        double output = std::clamp(1.5 * error + 0.1 * integral, -50.0, 50.0);
+                        bb.set(key + ".integral", integral);
+                        bb.set(key + ".value", std::max(0.0, value + output * 0.1));
+                    }
+                    return Status::Success;
+                })
+                .selector()
+                .action([](Blackboard &bb) {
+                    for (size_t c = 0; c < kComponents.size(); ++c) {
+                        if (efficiency(bb, c) < 0.95)
+                            return Status::Failure;
+                    }
+                    return Status::Success;
+                })
+                .action([](Blackboard &bb) {
+                    size_t worst = 0;
+                    for (size_t c = 1; c < kComponents.size(); ++c) {
+                        if (efficiency(bb, c) < efficiency(bb, worst))
+                            worst = c;
+                    }
+                    bb.set(std::string(kComponents[worst]) + ".integral", 0.0);
+                    return Status::Success;
+                })
+                .end()
+                .action([](Blackboard &bb) {
+                    double overall = 0.0;
+                    for (size_t c = 0; c < kComponents.size(); ++c) {
+                        overall += efficiency(bb, c) / kComponents.size();
+                    }
+                    double hopper = bb.get<double>("hopper").value_or(0.0) + 150.0 * overall * 0.5;
+                    bb.set("hopper", hopper);
+                    return hopper >= bb.get<double>("capacity").value_or(0.0) ? Status::Success : Status::Running;
+                })
+                .end();
+        });
+    }
+
+    void fill(Forest<TreeInstance> &fleet, const TreeDefinition::Ptr &definition, size_t agents) {
+        fleet.reserve(agents);
+        for (size_t i = 0; i < agents; ++i) {
+            auto &bb = fleet.emplace(definition, LockPolicy::None).blackboard();
+            for (size_t c = 0; c < kComponents.size(); ++c) {
+                bb.set(std::string(kComponents[c]) + ".setpoint", kSetpoints[c]);
+                bb.set(std::string(kComponents[c]) + ".value", kSetpoints[c] * (0.6 + 0.01 * (i % 30)));
+            }
+            bb.set("capacity", 400.0 + 100.0 * (i % 16)); // agents finish over several frames
+        }
+    }
+
+    // Average ns per ticked agent, and how many agents finished within kFrames
+    std::pair<double, size_t> run(Forest<TreeInstance> &fleet) {
+        size_t ticked = 0;
+        Forest<TreeInstance>::Counts counts;
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < kFrames; ++frame) {
+            counts = fleet.tickUnfinished();
+            ticked += counts.ticked;
+        }
+        auto end = std::chrono::steady_clock::now();
+        return {std::chrono::duration<double, std::nano>(end - start).count() / ticked, counts.finished()};
+    }
+} // namespace
+
+int main() {
+    const size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    core::ThreadPool pool(threads);
+    auto definition = harvester();
+
+    std::cout << "Pea harvester fleet, " << kFrames << " frames of tickUnfinished(), " << threads << " threads\n";
+    for (size_t agents : {1'000, 10'000, 100'000}) {
+        Forest<TreeInstance> inlineFleet;
+        fill(inlineFleet, definition, agents);
+        auto [inlineNs, inlineDone] = run(inlineFleet);
+
+        Forest<TreeInstance> pooledFleet(&pool);
+        fill(pooledFleet, definition, agents);
+        auto [pooledNs, pooledDone] = run(pooledFleet);
+
+        std::cout << std::setw(7) << agents << " agents  inline: " << std::fixed << std::setprecision(0)
+                  << std::setw(6) << inlineNs << " ns/agent-tick  pool: " << std::setw(6) << pooledNs
+                  << " ns/agent-tick  (" << std::setprecision(1) << inlineNs / pooledNs << "x)  finished "
+                  << pooledDone << "/" << agents << "\n";
+        if (inlineDone != pooledDone) {
+            std::cout << "  mismatch between modes!\n";
+        }
+    }
+    return 0;
+}
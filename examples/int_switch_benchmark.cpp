@@ -0,0 +1,69 @@
+#include <stateup/stateup.hpp>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace stateup::tree;
+
+// A mode switch over 12 modes, ticked with the mode changing every tick: SwitchNode builds a std::string key and
+// hashes it each time, IntSwitchNode indexes a table by a dense enum, and by sparse integer ids through a perfect
+// hash. Mode names are long enough that the string key does not fit the small-string buffer.
+
+namespace {
+    constexpr int kModes = 12;
+    constexpr int kTicks = 2'000'000;
+
+    enum class Mode : std::int64_t {};
+
+    const std::string &modeName(int mode) {
+        static const std::string names[kModes] = {
+            "mode.idle.waiting",      "mode.patrol.outer_ring", "mode.patrol.inner_ring", "mode.investigate.noise",
+            "mode.investigate.sight", "mode.chase.on_foot",     "mode.chase.in_vehicle",  "mode.attack.melee",
+            "mode.attack.ranged",     "mode.retreat.to_cover",  "mode.retreat.to_base",   "mode.dead.ragdoll"};
+        return names[mode];
+    }
+
+    std::int64_t sparseId(int mode) { return static_cast<std::int64_t>(mode) * 1'000'003 + 17; }
+
+    NodePtr leaf() {
+        return std::make_shared<Action>([](Blackboard &) { return Status::Success; });
+    }
+
+    template <typename Select> double nsPerTick(Tree &tree, Select &&select) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kTicks; ++i) {
+            select(i % kModes);
+            tree.tick();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / kTicks;
+    }
+} // namespace
+
+int main() {
+    // The selectors read a plain variable, so the timings compare dispatch rather than blackboard reads
+    int mode = 0;
+
+    auto strings = std::make_shared<SwitchNode>([&mode](Blackboard &) { return modeName(mode); });
+    auto dense = std::make_shared<EnumSwitchNode<Mode>>([&mode](Blackboard &) { return static_cast<Mode>(mode); });
+    auto sparse = std::make_shared<IntSwitchNode>([&mode](Blackboard &) { return sparseId(mode); });
+    for (int m = 0; m < kModes; ++m) {
+        strings->addCase(modeName(m), leaf());
+        dense->addCase(static_cast<Mode>(m), leaf());
+        sparse->addCase(sparseId(m), leaf());
+    }
+
+    Tree stringTree(strings, LockPolicy::None);
+    Tree denseTree(dense, LockPolicy::None);
+    Tree sparseTree(sparse, LockPolicy::None);
+    auto set = [&mode](int m) { mode = m; };
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "string SwitchNode:           " << nsPerTick(stringTree, set) << " ns/tick\n";
+    std::cout << "EnumSwitchNode, dense table: " << nsPerTick(denseTree, set) << " ns/tick\n";
+    std::cout << "IntSwitchNode, perfect hash: " << nsPerTick(sparseTree, set) << " ns/tick\n";
+    return 0;
+}
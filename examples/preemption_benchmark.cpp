@@ -0,0 +1,58 @@
+#include <stateup/stateup.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+using namespace stateup::tree;
+
+// A ReactiveSequence guards a 5,000-node task tree: 50 sequences of 99 actions each under one root sequence. The
+// first action keeps running, and the guard flips every other tick, so every second tick preempts the task
+// (halt + reset) and the next one starts it again. Halt and reset only follow the running path, so a preemption
+// costs the depth of the tree rather than its size.
+
+namespace {
+    constexpr int kBranches = 50;
+    constexpr int kLeaves = 99;
+    constexpr int kTicks = 100'000;
+
+    NodePtr buildTask(int &nodes) {
+        Builder builder;
+        builder.sequence();
+        ++nodes;
+        for (int b = 0; b < kBranches; ++b) {
+            builder.sequence();
+            ++nodes;
+            for (int l = 0; l < kLeaves; ++l) {
+                if (b == 0 && l == 0)
+                    builder.action([](Blackboard &) { return Status::Running; });
+                else
+                    builder.action([](Blackboard &) { return Status::Success; });
+                ++nodes;
+            }
+            builder.end();
+        }
+        return builder.end().buildRoot();
+    }
+} // namespace
+
+int main() {
+    int nodes = 0;
+    auto guard = std::make_shared<ReactiveSequence>();
+    guard->addChild(buildTask(nodes), [](Blackboard &bb) { return bb.get<bool>("go").value_or(false); });
+    ++nodes;
+    Tree tree(guard, LockPolicy::None);
+
+    auto &bb = tree.blackboard();
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < kTicks; ++t) {
+        bb.set("go", t % 2 == 0);
+        tree.tick();
+    }
+    auto end = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count() / kTicks;
+
+    std::cout << nodes << "-node tree, " << kTicks << " ticks, preempted every second tick\n"
+              << std::fixed << std::setprecision(0) << ns << " ns/tick\n";
+    return 0;
+}
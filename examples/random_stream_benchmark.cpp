@@ -0,0 +1,35 @@
+#include <stateup/core/random.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+// Uniform picks among 8 options, as RandomSelector makes them, from the mt19937 the selectors and transitions used to
+// keep per thread and from the counter-based RandomStream each of them now owns.
+
+namespace {
+    constexpr int kPicks = 2'000'000;
+
+    template <typename Rng> double nsPerPick(Rng &rng) {
+        std::uniform_int_distribution<size_t> pick(0, 7);
+        auto start = std::chrono::steady_clock::now();
+        size_t sink = 0;
+        for (int i = 0; i < kPicks; ++i)
+            sink += pick(rng);
+        auto end = std::chrono::steady_clock::now();
+        volatile size_t keep = sink;
+        (void)keep;
+        return std::chrono::duration<double, std::nano>(end - start).count() / kPicks;
+    }
+} // namespace
+
+int main() {
+    std::mt19937 twister(std::random_device{}());
+    stateup::core::RandomStream stream(0, 42);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "engine state:  mt19937 " << sizeof(twister) << " B, RandomStream " << sizeof(stream) << " B\n";
+    std::cout << "mt19937:       " << nsPerPick(twister) << " ns/pick\n";
+    std::cout << "RandomStream:  " << nsPerPick(stream) << " ns/pick\n";
+    return 0;
+}
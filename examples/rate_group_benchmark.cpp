@@ -0,0 +1,84 @@
+#include <stateup/stateup.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+using namespace stateup::tree;
+using namespace std::chrono_literals;
+
+// A 1 kHz tree with three branches under a Parallel: a cheap safety check that must run every tick, a planning
+// branch that needs 10 Hz and a housekeeping branch that needs 1 Hz. Planning and housekeeping are expensive.
+// Without rate groups every tick pays for all three; with throttle() the slow branches run at their own rate and
+// return their last status in between. Ten seconds run on a SimulatedClock, so the rates are exact and the
+// measured time is only the tree's work.
+
+namespace {
+    constexpr int kTicks = 10'000; // 10 s at 1 kHz
+    constexpr int kPlanningWork = 20'000;
+    constexpr int kHousekeepingWork = 200'000;
+
+    struct Counters {
+        long safety = 0, planning = 0, housekeeping = 0;
+    };
+
+    Status busy(int iterations) {
+        volatile unsigned sink = 0;
+        for (int i = 0; i < iterations; ++i)
+            sink = sink + static_cast<unsigned>(i);
+        return Status::Success;
+    }
+
+    Tree build(Counters &counters, bool throttled) {
+        Builder builder;
+        builder.parallel(Parallel::Policy::RequireAll, Parallel::Policy::RequireOne)
+            .lockPolicy(LockPolicy::None)
+            .action([&counters](Blackboard &) {
+                ++counters.safety;
+                return Status::Success;
+            });
+        if (throttled)
+            builder.throttle(100ms);
+        builder.action([&counters](Blackboard &) {
+            ++counters.planning;
+            return busy(kPlanningWork);
+        });
+        if (throttled)
+            builder.throttle(1s);
+        builder.action([&counters](Blackboard &) {
+            ++counters.housekeeping;
+            return busy(kHousekeepingWork);
+        });
+        return builder.end().build();
+    }
+
+    double run(Counters &counters, bool throttled) {
+        Tree tree = build(counters, throttled);
+        auto clock = std::make_shared<SimulatedClock>();
+        tree.setClock(clock);
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < kTicks; ++t) {
+            tree.tick();
+            clock->advance(1ms);
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / kTicks;
+    }
+
+    void report(const char *label, double usPerTick, const Counters &counters) {
+        std::cout << label << std::fixed << std::setprecision(2) << usPerTick << " us/tick (safety "
+                  << counters.safety << ", planning " << counters.planning << ", housekeeping " << counters.housekeeping
+                  << ")\n";
+    }
+} // namespace
+
+int main() {
+    Counters everyTick, rateGroups;
+    const double plainUs = run(everyTick, false);
+    const double throttledUs = run(rateGroups, true);
+
+    std::cout << kTicks << " ticks at 1 kHz (10 s simulated)\n";
+    report("every branch every tick: ", plainUs, everyTick);
+    report("rate groups:             ", throttledUs, rateGroups);
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <stateup/stateup.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+using namespace stateup;
+using namespace stateup::tree;
+using namespace std::chrono_literals;
+
+// A guard's day at 60 ticks per second, run on a SimulatedClock instead of the wall clock. The behavior tree
+// searches for up to 45 s at a time (Timeout) before falling back to reporting in; the state machine switches
+// between day and night shifts with 12 h timed transitions. All of that time is simulated, so 24 hours of ticks
+// finish in seconds and every run sees exactly the same timings.
+
+int main() {
+    constexpr auto kTickPeriod = std::chrono::microseconds(16'667);
+    constexpr auto kDay = 24h;
+
+    auto clock = std::make_shared<SimulatedClock>();
+
+    long searchTicks = 0, reports = 0;
+    auto tree = Builder()
+                    .selector()
+                    .decorator(decorators::Timeout(45.0f))
+                    .action([&searchTicks](Blackboard &) {
+                        ++searchTicks;
+                        return Status::Running;
+                    })
+                    .action([&reports](Blackboard &) {
+                        ++reports;
+                        return Status::Success;
+                    })
+                    .end()
+                    .build();
+    tree.setClock(clock);
+
+    auto machine = state::Builder()
+                       .state("day")
+                       .transitionToAfter("night", 12h)
+                       .state("night")
+                       .transitionToAfter("day", 12h)
+                       .initial("day")
+                       .build();
+    machine->setClock(clock);
+    machine->enableTransitionHistory();
+
+    long ticks = 0;
+    const auto end = clock->now() + kDay;
+    const auto start = std::chrono::steady_clock::now();
+    while (clock->now() < end) {
+        tree.tick();
+        machine->tick();
+        clock->advance(kTickPeriod);
+        ++ticks;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "simulated 24 h: " << ticks << " ticks of a tree and a state machine\n"
+              << std::fixed << std::setprecision(2) << "wall time:      " << seconds << " s ("
+              << std::setprecision(0) << seconds * 1e9 / ticks << " ns/tick)\n"
+              << "search ticks:   " << searchTicks << ", reports " << reports << "\n"
+              << "shift changes:  " << machine->getTransitionHistory().size() - 1 << " (now "
+              << machine->getCurrentStateName() << ")\n";
+    return 0;
+}
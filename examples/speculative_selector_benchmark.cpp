@@ -0,0 +1,58 @@
+#include <stateup/core/executor.hpp>
+#include <stateup/stateup.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+using namespace stateup::tree;
+using namespace std::chrono_literals;
+
+// A fallback chain of six planners, tried in order: each one queries a service (about 300 us) and only the last
+// finds a plan. A plain Selector pays for every failed query before the next one starts; marked pure, the
+// planners of a speculativeSelector() query at once and the first success in order wins. The queries block
+// rather than compute, so they overlap even on a single core; CPU-bound fallbacks gain with the core count.
+
+namespace {
+    constexpr int kPlanners = 6;
+    constexpr int kTicks = 200;
+    constexpr auto kQuery = 300us;
+
+    Tree build(stateup::core::ThreadPool &pool, bool speculative) {
+        Builder builder;
+        builder.executor(&pool);
+        if (speculative)
+            builder.speculativeSelector();
+        else
+            builder.selector();
+        for (int i = 0; i < kPlanners; ++i) {
+            builder.pure().action([i](Blackboard &) {
+                std::this_thread::sleep_for(kQuery);
+                return i == kPlanners - 1 ? Status::Success : Status::Failure;
+            });
+        }
+        return builder.end().build();
+    }
+
+    double run(stateup::core::ThreadPool &pool, bool speculative) {
+        Tree tree = build(pool, speculative);
+        tree.tick(); // warm up the cost estimates
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < kTicks; ++t)
+            tree.tick();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / kTicks;
+    }
+} // namespace
+
+int main() {
+    stateup::core::ThreadPool pool(kPlanners);
+    const double plainUs = run(pool, false);
+    const double speculativeUs = run(pool, true);
+
+    std::cout << kPlanners << " fallbacks, " << kQuery.count() << " us each, the last one succeeds\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "selector:             " << plainUs << " us/tick\n";
+    std::cout << "speculative selector: " << speculativeUs << " us/tick (" << plainUs / speculativeUs << "x)\n";
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <stateup/stateup.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace stateup::tree;
+namespace st = stateup::tree::static_tree;
+
+// The same 17-leaf tree built twice: once from runtime nodes with the Builder, once as a static tree type. Leaves
+// only bump a counter, so the numbers are the cost of the tree itself: virtual calls, std::function calls and
+// pointer chasing for the runtime tree, inlined code over one flat state object for the static one.
+
+namespace {
+    constexpr int kTicks = 2'000'000;
+    long counter = 0;
+
+    bool armed(Blackboard &) { return ++counter > 0; }
+    Status work(Blackboard &) {
+        ++counter;
+        return Status::Success;
+    }
+    Status flaky(Blackboard &) { return ++counter % 2 ? Status::Success : Status::Failure; }
+
+    using Work = st::act<&work>;
+    using Step = st::seq<Work, Work, Work, Work>;
+    using Static = st::seq<st::cond<&armed>, st::sel<st::inv<Work>, st::retry<3, st::act<&flaky>>>, Step, Step,
+                           st::sel<st::inv<Work>, Work>, Step>;
+
+    NodePtr buildDynamic() {
+        Builder builder;
+        builder.sequence()
+            .action([](Blackboard &bb) { return armed(bb) ? Status::Success : Status::Failure; })
+            .selector()
+            .inverter()
+            .action(&work)
+            .retry(3)
+            .action(&flaky)
+            .end();
+        auto step = [&builder] {
+            builder.sequence().action(&work).action(&work).action(&work).action(&work).end();
+        };
+        step();
+        step();
+        builder.selector().inverter().action(&work).action(&work).end();
+        step();
+        return builder.end().buildRoot();
+    }
+
+    template <typename F> double nsPerTick(F &&tick) {
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < kTicks; ++t) {
+            tick();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / kTicks;
+    }
+} // namespace
+
+int main() {
+    Blackboard bb;
+    int successes = 0;
+
+    NodePtr dynamic = buildDynamic();
+    const double dynamicNs = nsPerTick([&] { successes += dynamic->tick(bb) == Status::Success; });
+
+    st::StaticTree<Static> fixed;
+    const double staticNs = nsPerTick([&] { successes += fixed.tick(bb) == Status::Success; });
+
+    std::cout << kTicks << " ticks of a 17-leaf tree (" << successes << " successes, counter " << counter << ")\n"
+              << std::fixed << std::setprecision(1) << "runtime nodes: " << dynamicNs << " ns/tick\n"
+              << "static tree:   " << staticNs << " ns/tick\n";
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "stateup/tree/builder.hpp"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+using namespace stateup::tree;
+
+// Heap bytes per agent for 10,000 agents running the same 71-node behavior: one full Tree per agent built
+// through Builder, versus TreeInstances of one shared TreeDefinition. Every agent gets a blackboard with the
+// same four keys in both cases.
+
+static std::size_t g_liveBytes = 0;
+
+void *operator new(std::size_t size) {
+    auto *block = static_cast<std::size_t *>(std::malloc(size + sizeof(std::max_align_t)));
+    if (!block)
+        throw std::bad_alloc();
+    *block = size;
+    g_liveBytes += size;
+    return reinterpret_cast<char *>(block) + sizeof(std::max_align_t);
+}
+
+void operator delete(void *ptr) noexcept {
+    if (!ptr)
+        return;
+    auto *block = reinterpret_cast<std::size_t *>(static_cast<char *>(ptr) - sizeof(std::max_align_t));
+    g_liveBytes -= *block;
+    std::free(block);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept { operator delete(ptr); }
+
+constexpr int kAgents = 10'000;
+constexpr int kBranches = 10;
+
+static void describe(Builder &builder) {
+    builder.selector();
+    for (int b = 0; b < kBranches; ++b) {
+        builder.sequence()
+            .action([b](Blackboard &bb) { return bb.get<int>("mode").value_or(0) == b ? Status::Success : Status::Failure; })
+            .retry(3)
+            .action([](Blackboard &bb) {
+                bb.set("x", bb.get<double>("x").value_or(0.0) + 1.0);
+                return Status::Success;
+            })
+            .inverter()
+            .action([](Blackboard &bb) { return bb.get<double>("x").value_or(0.0) > 100.0 ? Status::Success
+                                                                                            : Status::Failure; })
+            .action([](Blackboard &bb) {
+                bb.set("energy", bb.get<double>("energy").value_or(100.0) - 0.1);
+                return Status::Running;
+            })
+            .end();
+    }
+    builder.end();
+}
+
+static void seed(Blackboard &bb, int agent) {
+    bb.set("mode", agent % kBranches);
+    bb.set("x", 0.0);
+    bb.set("energy", 100.0);
+    bb.set("id", agent);
+}
+
+int main() {
+    std::size_t perTree = 0, perInstance = 0, definitionBytes = 0;
+    {
+        const std::size_t before = g_liveBytes;
+        std::vector<std::unique_ptr<Tree>> trees;
+        trees.reserve(kAgents);
+        for (int i = 0; i < kAgents; ++i) {
+            Builder builder;
+            describe(builder.lockPolicy(LockPolicy::None));
+            trees.push_back(std::make_unique<Tree>(builder.buildRoot(), LockPolicy::None));
+            seed(trees.back()->blackboard(), i);
+            trees.back()->tick();
+        }
+        perTree = (g_liveBytes - before) / kAgents;
+    }
+    {
+        const std::size_t before = g_liveBytes;
+        auto definition = TreeDefinition::define(describe);
+        definitionBytes = g_liveBytes - before;
+        std::vector<std::unique_ptr<TreeInstance>> agents;
+        agents.reserve(kAgents);
+        for (int i = 0; i < kAgents; ++i) {
+            agents.push_back(std::make_unique<TreeInstance>(definition, LockPolicy::None));
+            seed(agents.back()->blackboard(), i);
+            agents.back()->tick();
+        }
+        perInstance = (g_liveBytes - before - definitionBytes) / kAgents;
+        std::cout << kAgents << " agents, " << definition->size() << "-node behavior\n";
+    }
+
+    std::cout << "Tree per agent:      " << std::setw(7) << perTree << " bytes\n"
+              << "TreeInstance:        " << std::setw(7) << perInstance << " bytes  (shared definition "
+              << definitionBytes << " bytes once)\n"
+              << std::fixed << std::setprecision(1) << "reduction:           " << std::setw(7)
+              << static_cast<double>(perTree) / perInstance << "x\n";
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "stateup/tree/typed_tree.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace stateup::tree;
+
+// 201-node tree (root sequence, 40 sequences of 4 actions) ticked with string-keyed blackboard access and
+// with a typed context. Every action reads two values and writes one.
+
+struct Controller {
+    double position = 0.0;
+    double velocity = 1.0;
+    double error = 0.0;
+    int ticks = 0;
+};
+
+constexpr int kGroups = 40;
+constexpr int kActionsPerGroup = 4;
+constexpr int kTicks = 20'000;
+
+static Tree buildBlackboardTree(LockPolicy policy) {
+    Builder builder;
+    builder.lockPolicy(policy).sequence();
+    for (int g = 0; g < kGroups; ++g) {
+        builder.sequence()
+            .action([](Blackboard &bb) {
+                bb.set("position", bb.get<double>("position").value_or(0.0) + bb.get<double>("velocity").value_or(0.0));
+                return Status::Success;
+            })
+            .action([](Blackboard &bb) {
+                bb.set("error", 10.0 - bb.get<double>("position").value_or(0.0));
+                return Status::Success;
+            })
+            .action([](Blackboard &bb) {
+                bb.set("velocity", bb.get<double>("error").value_or(0.0) * 0.01);
+                return Status::Success;
+            })
+            .action([](Blackboard &bb) {
+                bb.set("ticks", bb.get<int>("ticks").value_or(0) + 1);
+                return Status::Success;
+            })
+            .end();
+    }
+    return builder.end().build();
+}
+
+static TypedTree<Controller> buildTypedTree(LockPolicy policy) {
+    TypedBuilder<Controller> builder;
+    builder.lockPolicy(policy).sequence();
+    for (int g = 0; g < kGroups; ++g) {
+        builder.sequence()
+            .action([](Controller &c) {
+                c.position += c.velocity;
+                return Status::Success;
+            })
+            .action([](Controller &c) {
+                c.error = 10.0 - c.position;
+                return Status::Success;
+            })
+            .action([](Controller &c) {
+                c.velocity = c.error * 0.01;
+                return Status::Success;
+            })
+            .action([](Controller &c) {
+                ++c.ticks;
+                return Status::Success;
+            })
+            .end();
+    }
+    return builder.end().build();
+}
+
+template <typename TreeT> static double nsPerTick(TreeT &tree) {
+    for (int i = 0; i < 100; ++i) // warm up
+        tree.tick();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kTicks; ++i)
+        tree.tick();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / kTicks;
+}
+
+int main() {
+    std::cout << "Tick cost of a " << 1 + kGroups * (1 + kActionsPerGroup) << "-node tree, " << kTicks
+              << " ticks per row\n";
+    for (auto policy : {LockPolicy::None, LockPolicy::Mutex}) {
+        const char *name = policy == LockPolicy::None ? "None" : "Mutex";
+
+        auto untyped = buildBlackboardTree(policy);
+        untyped.blackboard().set("position", 0.0);
+        untyped.blackboard().set("velocity", 1.0);
+        double blackboardNs = nsPerTick(untyped);
+
+        auto typed = buildTypedTree(policy);
+        double typedNs = nsPerTick(typed);
+
+        std::cout << std::left << std::setw(6) << name << std::fixed << std::setprecision(0)
+                  << " blackboard: " << std::setw(8) << blackboardNs << " ns/tick  typed context: " << std::setw(8)
+                  << typedNs << " ns/tick  (" << std::setprecision(1) << blackboardNs / typedNs << "x)\n";
+        if (untyped.blackboard().get<int>("ticks").value_or(0) != typed.context().ticks) {
+            std::cout << "  mismatch between modes!\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <stateup/stateup.hpp>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace stateup::tree;
+
+// 5,000 agents choose between 8 behaviours, each scored from 3 of 6 blackboard inputs. Every frame a tenth of
+// the agents see new inputs. Callback scoring reads and curves every input of every option on every tick;
+// consideration scoring re-scores an agent only when one of its inputs changed. UtilityModel::scoreBatch()
+// scores the whole crowd in one structure-of-arrays pass for callers that keep the inputs themselves.
+
+namespace {
+    constexpr size_t kAgents = 5'000;
+    constexpr int kOptions = 8;
+    constexpr int kFrames = 50;
+    const char *const kInputs[] = {"hunger", "fatigue", "danger", "ammo", "health", "distance"};
+
+    float logistic(float x, float midpoint, float steepness) {
+        return 1.0f / (1.0f + std::exp(-steepness * (x - midpoint)));
+    }
+
+    std::vector<Consideration> considerations(int option) {
+        return {{kInputs[option % 6], ResponseCurve::linear(1.0f, 0.0f)},
+                {kInputs[(option + 1) % 6], ResponseCurve::logistic(0.5f, 8.0f)},
+                {kInputs[(option + 3) % 6], ResponseCurve::piecewise({{0.0f, 1.0f}, {0.5f, 0.6f}, {1.0f, 0.1f}})}};
+    }
+
+    UtilitySelector::UtilityFunc callback(int option) {
+        auto curve = std::make_shared<const ResponseCurve>(
+            ResponseCurve::piecewise({{0.0f, 1.0f}, {0.5f, 0.6f}, {1.0f, 0.1f}}));
+        return [option, curve](Blackboard &bb) {
+            const float a = bb.get<float>(kInputs[option % 6]).value_or(0.0f);
+            const float b = bb.get<float>(kInputs[(option + 1) % 6]).value_or(0.0f);
+            const float c = bb.get<float>(kInputs[(option + 3) % 6]).value_or(0.0f);
+            return std::min(std::max(a, 0.0f), 1.0f) * logistic(b, 0.5f, 8.0f) * (*curve)(c);
+        };
+    }
+
+    float input(size_t agent, int key, int frame) {
+        return static_cast<float>((agent * 7 + static_cast<size_t>(key) * 13 + static_cast<size_t>(frame)) % 100) /
+               100.0f;
+    }
+
+    double run(bool curves) {
+        std::vector<std::unique_ptr<Tree>> agents;
+        for (size_t a = 0; a < kAgents; ++a) {
+            auto selector = std::make_shared<UtilitySelector>();
+            for (int o = 0; o < kOptions; ++o) {
+                auto idle = std::make_shared<Action>([](Blackboard &) { return Status::Success; });
+                if (curves)
+                    selector->addChild(idle, considerations(o));
+                else
+                    selector->addChild(idle, callback(o));
+            }
+            agents.push_back(std::make_unique<Tree>(selector, LockPolicy::None));
+            for (int k = 0; k < 6; ++k)
+                agents.back()->blackboard().set(kInputs[k], input(a, k, 0));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 1; frame <= kFrames; ++frame) {
+            for (size_t a = static_cast<size_t>(frame) % 10; a < kAgents; a += 10)
+                agents[a]->blackboard().set("danger", input(a, 2, frame));
+            for (auto &agent : agents)
+                agent->tick();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / kFrames;
+    }
+
+    double runBatch() {
+        UtilityModel model;
+        for (int o = 0; o < kOptions; ++o)
+            model.addOption(considerations(o));
+        std::vector<float> inputs(model.inputCount() * kAgents);
+        std::vector<float> scores(model.optionCount() * kAgents);
+        for (size_t slot = 0; slot < model.inputCount(); ++slot) {
+            for (size_t a = 0; a < kAgents; ++a)
+                inputs[slot * kAgents + a] = input(a, static_cast<int>(slot), 0);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < kFrames; ++frame)
+            model.scoreBatch(inputs.data(), kAgents, scores.data());
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / kFrames;
+    }
+} // namespace
+
+int main() {
+    const double callbackMs = run(false);
+    const double curveMs = run(true);
+    const double batchMs = runBatch();
+
+    std::cout << kAgents << " agents, " << kOptions << " options x 3 considerations, " << kFrames << " frames\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "callback scoring:       " << callbackMs << " ms/frame\n";
+    std::cout << "cached considerations:  " << curveMs << " ms/frame (" << callbackMs / curveMs << "x)\n";
+    std::cout << "scoreBatch, all agents: " << batchMs << " ms/frame\n";
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include <stateup/core/alias_table.hpp>
+#include <stateup/stateup.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace stateup::tree;
+
+// Weighted picks among 8 to 1,024 options: a cumulative scan over the weights (what the selectors and weighted
+// transitions used to do on every pick) against a draw from an alias table built once. Then whole
+// WeightedRandomSelector ticks at the same widths, with fixed weights so the table is never rebuilt.
+
+namespace {
+    constexpr int kPicks = 200'000;
+
+    template <typename F> double nsPerPick(F &&pick) {
+        auto start = std::chrono::steady_clock::now();
+        size_t sink = 0;
+        for (int i = 0; i < kPicks; ++i)
+            sink += pick();
+        auto end = std::chrono::steady_clock::now();
+        volatile size_t keep = sink;
+        (void)keep;
+        return std::chrono::duration<double, std::nano>(end - start).count() / kPicks;
+    }
+
+    std::vector<float> weightsFor(size_t count) {
+        std::vector<float> weights(count);
+        for (size_t i = 0; i < count; ++i)
+            weights[i] = 1.0f + static_cast<float>(i % 7);
+        return weights;
+    }
+} // namespace
+
+int main() {
+    std::mt19937 rng(1);
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "options   scan ns/pick   alias ns/pick   selector ns/tick\n";
+    for (size_t count : {8, 64, 512, 1024}) {
+        const std::vector<float> weights = weightsFor(count);
+
+        const double scanNs = nsPerPick([&] {
+            float total = 0.0f;
+            for (float w : weights)
+                total += w;
+            const float roll = std::uniform_real_distribution<float>(0.0f, total)(rng);
+            float cumulative = 0.0f;
+            for (size_t i = 0; i < weights.size(); ++i) {
+                cumulative += weights[i];
+                if (roll <= cumulative)
+                    return i;
+            }
+            return weights.size() - 1;
+        });
+
+        stateup::core::AliasTable table(weights);
+        const double aliasNs = nsPerPick([&] { return table.sample(rng); });
+
+        auto selector = std::make_shared<WeightedRandomSelector>();
+        for (size_t i = 0; i < count; ++i) {
+            const float weight = weights[i];
+            selector->addChild(std::make_shared<Action>([](Blackboard &) { return Status::Success; }),
+                               [weight](Blackboard &) { return weight; });
+        }
+        Tree tree(selector, LockPolicy::None);
+        const double tickNs = nsPerPick([&] { return static_cast<size_t>(tree.tick()); });
+
+        std::cout << std::setw(7) << count << std::setw(15) << scanNs << std::setw(16) << aliasNs << std::setw(19)
+                  << tickNs << "\n";
+    }
+    return 0;
+}
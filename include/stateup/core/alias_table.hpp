@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace stateup::core {
+
+    // Weighted sampling in O(1) per draw with Vose's alias method. build() costs O(n) and reuses its storage, so
+    // callers keep one table and rebuild it only when the weights change. Each column i of the table keeps
+    // index i with probability prob[i] and otherwise yields alias[i]; a draw picks a column uniformly and flips
+    // that biased coin. Negative weights count as zero, and zero-weight entries are never drawn. Not thread-safe
+    // to build while sampling; sampling alone only reads.
+    class AliasTable {
+      public:
+        AliasTable() = default;
+        explicit AliasTable(const std::vector<float> &weights) { build(weights); }
+
+        // False, leaving the table empty, when no weight is positive
+        bool build(const std::vector<float> &weights) { return build(weights.data(), weights.size()); }
+        bool build(const float *weights, std::size_t count) {
+            prob_.clear();
+            alias_.clear();
+            double total = 0.0;
+            for (std::size_t i = 0; i < count; ++i)
+                total += weights[i] > 0.0f ? weights[i] : 0.0f;
+            total_ = total;
+            if (!(total > 0.0))
+                return false;
+
+            prob_.resize(count);
+            alias_.resize(count);
+            scaled_.resize(count);
+            small_.clear();
+            large_.clear();
+            for (std::size_t i = 0; i < count; ++i) {
+                scaled_[i] = (weights[i] > 0.0f ? weights[i] : 0.0) * static_cast<double>(count) / total;
+                (scaled_[i] < 1.0 ? small_ : large_).push_back(static_cast<std::uint32_t>(i));
+            }
+            while (!small_.empty() && !large_.empty()) {
+                const std::uint32_t less = small_.back();
+                const std::uint32_t more = large_.back();
+                small_.pop_back();
+                prob_[less] = static_cast<float>(scaled_[less]);
+                alias_[less] = more;
+                scaled_[more] -= 1.0 - scaled_[less];
+                if (scaled_[more] < 1.0) {
+                    large_.pop_back();
+                    small_.push_back(more);
+                }
+            }
+            // What is left is 1 up to rounding
+            for (std::uint32_t i : large_) {
+                prob_[i] = 1.0f;
+                alias_[i] = i;
+            }
+            for (std::uint32_t i : small_) {
+                prob_[i] = 1.0f;
+                alias_[i] = i;
+            }
+            return true;
+        }
+
+        bool empty() const { return prob_.empty(); }
+        std::size_t size() const { return prob_.size(); }
+        // Sum of the positive weights the table was built from
+        double total() const { return total_; }
+
+        // Index of the drawn weight; the table must not be empty
+        template <typename Rng> std::size_t sample(Rng &rng) const {
+            std::uniform_int_distribution<std::size_t> column(0, prob_.size() - 1);
+            std::uniform_real_distribution<float> coin(0.0f, 1.0f);
+            const std::size_t i = column(rng);
+            return coin(rng) < prob_[i] ? i : alias_[i];
+        }
+
+      private:
+        std::vector<float> prob_;
+        std::vector<std::uint32_t> alias_;
+        double total_ = 0.0;
+        // Build scratch, kept so rebuilds do not allocate
+        std::vector<double> scaled_;
+        std::vector<std::uint32_t> small_;
+        std::vector<std::uint32_t> large_;
+    };
+
+} // namespace stateup::core
@@ -0,0 +1,56 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+namespace stateup::core {
+
+    // Running estimate of how long a callback takes, used to decide whether handing it to a ThreadPool is worth
+    // the dispatch cost. Exponentially weighted (alpha 1/4) over timed runs; until the first measurement the
+    // callback counts as expensive. Once measured, only one run in kSampleEvery is timed, so cheap callbacks do
+    // not pay two clock reads per call. Not thread-safe: each estimate belongs to one callback, run by one thread
+    // at a time.
+    class CostEstimate {
+      public:
+        static constexpr std::uint32_t kSampleEvery = 8;
+
+        bool measured() const { return ewmaNs_ >= 0; }
+        std::chrono::nanoseconds estimate() const { return std::chrono::nanoseconds(measured() ? ewmaNs_ : 0); }
+
+        bool expensive(std::chrono::nanoseconds threshold) const {
+            return !measured() || std::chrono::nanoseconds(ewmaNs_) >= threshold;
+        }
+
+        bool shouldSample() { return !measured() || (++runs_ % kSampleEvery) == 0; }
+
+        void record(std::chrono::nanoseconds elapsed) {
+            const std::int64_t sample = elapsed.count();
+            ewmaNs_ = measured() ? ewmaNs_ + (sample - ewmaNs_) / 4 : sample;
+        }
+
+        // Run f(), timing it when sampled
+        template <typename F> decltype(auto) run(F &&f) {
+            if (!shouldSample())
+                return f();
+            struct Timer {
+                CostEstimate &owner;
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                ~Timer() { owner.record(std::chrono::steady_clock::now() - start); }
+            } timer{*this};
+            return f();
+        }
+
+        void reset() {
+            ewmaNs_ = -1;
+            runs_ = 0;
+        }
+
+      private:
+        std::int64_t ewmaNs_ = -1;
+        std::uint32_t runs_ = 0;
+    };
+
+    // Below this estimated cost a callback runs inline instead of on a pool: a bulk dispatch costs a few
+    // microseconds of queueing and wakeups per job
+    inline constexpr std::chrono::nanoseconds kDefaultPoolThreshold = std::chrono::microseconds(20);
+
+} // namespace stateup::core
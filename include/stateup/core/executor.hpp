@@ -17,6 +17,7 @@ namespace stateup::core {
                 threads = 1;
             for (size_t i = 0; i < threads; ++i) {
                 workers_.emplace_back([this] {
+                    workerOf_ = this;
                     for (;;) {
                         std::function<void()> task;
                         {
@@ -53,46 +54,70 @@ namespace stateup::core {
             return p->get_future();
         }
 
+        // Runs f(0) .. f(n - 1) and returns once all of them have. Called from one of this pool's own workers (e.g.
+        // a SequenceGroup under a pooled Parallel child, both on defaultPool()), the caller claims indices alongside
+        // the other workers, so the bulk completes even when every worker is busy.
         template <class F> void bulk(F &&f, size_t n) {
-            std::promise<void> done;
-            std::atomic<size_t> remaining{n};
-            auto fut = done.get_future();
-            for (size_t i = 0; i < n; ++i) {
-                submit([&, i] {
-                    f(i);
-                    if (remaining.fetch_sub(1) == 1)
-                        done.set_value();
-                });
-            }
-            fut.get();
+            runClaimed(n, [&f](size_t i) { f(i); });
         }
 
         // Early-stop bulk: f(i) returns true if work should continue, false to signal stop
         template <class F> void bulk_early_stop(F &&f, size_t n, std::atomic<bool> &stop) {
-            std::promise<void> done;
-            std::atomic<size_t> remaining{n};
-            auto fut = done.get_future();
-            for (size_t i = 0; i < n; ++i) {
-                submit([&, i] {
-                    if (!stop.load(std::memory_order_relaxed)) {
-                        bool cont = f(i);
-                        if (!cont) {
-                            stop.store(true, std::memory_order_relaxed);
-                        }
+            runClaimed(n, [&f, &stop](size_t i) {
+                if (!stop.load(std::memory_order_relaxed)) {
+                    bool cont = f(i);
+                    if (!cont) {
+                        stop.store(true, std::memory_order_relaxed);
                     }
-                    if (remaining.fetch_sub(1) == 1)
-                        done.set_value();
-                });
-            }
-            fut.get();
+                }
+            });
         }
 
       private:
+        // Indices are claimed from a shared counter; helpers that find none left return without touching `run`,
+        // which may be gone by then
+        template <class Run> void runClaimed(size_t n, Run run) {
+            if (n == 0)
+                return;
+            struct Claims {
+                std::atomic<size_t> next{0};
+                std::atomic<size_t> done{0};
+                std::mutex m;
+                std::condition_variable cv;
+            };
+            auto claims = std::make_shared<Claims>();
+            auto work = [claims, n, &run] {
+                for (size_t i = claims->next.fetch_add(1); i < n; i = claims->next.fetch_add(1)) {
+                    run(i);
+                    if (claims->done.fetch_add(1) + 1 == n) {
+                        std::lock_guard<std::mutex> lk(claims->m);
+                        claims->cv.notify_all();
+                    }
+                }
+            };
+            const bool nested = workerOf_ == this;
+            for (size_t i = nested ? 1 : 0; i < n; ++i)
+                submit(work);
+            if (nested)
+                work();
+            std::unique_lock<std::mutex> lk(claims->m);
+            claims->cv.wait(lk, [&] { return claims->done.load() == n; });
+        }
+
         std::mutex m_;
         std::condition_variable cv_;
         std::queue<std::function<void()>> q_;
         std::vector<std::thread> workers_;
         bool stop_;
+
+        inline static thread_local const ThreadPool *workerOf_ = nullptr;
     };
 
+    // Pool for nodes and state machines that were given no executor, shared by all of them and sized to the
+    // hardware; created on first use
+    inline ThreadPool &defaultPool() {
+        static ThreadPool pool;
+        return pool;
+    }
+
 } // namespace stateup::core
@@ -0,0 +1,121 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Bytes of captured state a node or state callback may carry; set through the STATEUP_INPLACE_CAPACITY CMake cache
+// variable. 32 holds a std::function or four pointers.
+#ifndef STATEUP_INPLACE_CAPACITY
+#define STATEUP_INPLACE_CAPACITY 32
+#endif
+
+namespace stateup::core {
+
+    inline constexpr std::size_t kInplaceCapacity = STATEUP_INPLACE_CAPACITY;
+
+    template <typename Signature, std::size_t Capacity = kInplaceCapacity> class InplaceFunction;
+
+    namespace detail {
+        template <typename T> inline constexpr bool isStdFunction = false;
+        template <typename S> inline constexpr bool isStdFunction<std::function<S>> = true;
+    } // namespace detail
+
+    // Move-only replacement for std::function that stores the callable inside itself and never allocates. A
+    // callable larger than Capacity (or over-aligned) is a compile error rather than a silent heap block: capture
+    // less, capture a pointer to the state, or raise the capacity. Like std::function, operator() is const but
+    // calls the target as non-const, so a stateful functor needs no `mutable`; being move-only, that state is never
+    // duplicated behind the owner's back. Empty std::function objects and null function pointers produce an empty
+    // InplaceFunction. Moves are noexcept; a callable whose move throws (a captured const std::string copies on
+    // move) terminates if that copy fails to allocate.
+    template <typename R, typename... Args, std::size_t Capacity> class InplaceFunction<R(Args...), Capacity> {
+      public:
+        InplaceFunction() noexcept = default;
+        InplaceFunction(std::nullptr_t) noexcept {}
+
+        template <typename F, typename D = std::decay_t<F>>
+            requires(!std::is_same_v<D, InplaceFunction> && std::is_invocable_r_v<R, D &, Args...>)
+        InplaceFunction(F &&f) {
+            static_assert(sizeof(D) <= Capacity, "callable does not fit in InplaceFunction; capture less or raise "
+                                                 "STATEUP_INPLACE_CAPACITY");
+            static_assert(alignof(D) <= alignof(std::max_align_t), "over-aligned callable");
+            // A function named directly (not a pointer variable) is never null
+            constexpr bool nullable = !std::is_function_v<std::remove_reference_t<F>> &&
+                                      (std::is_pointer_v<D> || std::is_member_pointer_v<D> || detail::isStdFunction<D>);
+            if constexpr (nullable) {
+                if (!f)
+                    return;
+            }
+            ::new (static_cast<void *>(storage_)) D(std::forward<F>(f));
+            invoke_ = &invokeTarget<D>;
+            if constexpr (!std::is_trivially_copyable_v<D>)
+                manage_ = &manageTarget<D>;
+        }
+
+        InplaceFunction(InplaceFunction &&other) noexcept { take(other); }
+        InplaceFunction &operator=(InplaceFunction &&other) noexcept {
+            if (this != &other) {
+                destroy();
+                take(other);
+            }
+            return *this;
+        }
+        InplaceFunction &operator=(std::nullptr_t) noexcept {
+            destroy();
+            return *this;
+        }
+        InplaceFunction(const InplaceFunction &) = delete;
+        InplaceFunction &operator=(const InplaceFunction &) = delete;
+        ~InplaceFunction() { destroy(); }
+
+        R operator()(Args... args) const {
+            if (!invoke_)
+                throw std::bad_function_call();
+            return invoke_(const_cast<unsigned char *>(storage_), std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const noexcept { return invoke_ != nullptr; }
+        friend bool operator==(const InplaceFunction &f, std::nullptr_t) noexcept { return !f; }
+
+      private:
+        template <typename D> static R invokeTarget(void *target, Args &&...args) {
+            if constexpr (std::is_void_v<R>)
+                std::invoke(*static_cast<D *>(target), std::forward<Args>(args)...);
+            else
+                return std::invoke(*static_cast<D *>(target), std::forward<Args>(args)...);
+        }
+
+        // Move-constructs the target into `to` and destroys it in `from`; with `to` null, only destroys
+        template <typename D> static void manageTarget(void *to, void *from) noexcept {
+            D *source = static_cast<D *>(from);
+            if (to)
+                ::new (to) D(std::move(*source));
+            source->~D();
+        }
+
+        void take(InplaceFunction &other) noexcept {
+            if (!other.invoke_)
+                return;
+            if (other.manage_)
+                other.manage_(storage_, other.storage_);
+            else
+                std::memcpy(storage_, other.storage_, Capacity);
+            invoke_ = std::exchange(other.invoke_, nullptr);
+            manage_ = std::exchange(other.manage_, nullptr);
+        }
+
+        void destroy() noexcept {
+            if (manage_)
+                manage_(nullptr, storage_);
+            invoke_ = nullptr;
+            manage_ = nullptr;
+        }
+
+        alignas(std::max_align_t) unsigned char storage_[Capacity];
+        R (*invoke_)(void *, Args &&...) = nullptr;
+        void (*manage_)(void *, void *) noexcept = nullptr; // null for trivially copyable targets
+    };
+
+} // namespace stateup::core
@@ -0,0 +1,132 @@
+#pragma once
+#include "stateup/core/random.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace stateup::core {
+
+    // Maps a fixed set of integer keys to small indices with no heap access on lookup. Keys within a short range
+    // go into a dense table indexed by key - min. Sparse keys get a two-level perfect hash (FKS): a first hash
+    // spreads them over n buckets, and a bucket of b keys owns b^2 slots under its own seed so none of them
+    // collide, at most 4n slots in all. A lookup is then two hashes and one key compare. build() is O(n) expected
+    // and reuses its storage.
+    class IntDispatch {
+      public:
+        static constexpr std::uint32_t kNone = UINT32_MAX;
+
+        // Keys must be distinct; values are what find() returns for them
+        void build(const std::vector<std::pair<std::int64_t, std::uint32_t>> &entries) {
+            dense_.clear();
+            buckets_.clear();
+            slotKeys_.clear();
+            slotValues_.clear();
+            count_ = entries.size();
+            if (entries.empty())
+                return;
+
+            auto [low, high] = std::minmax_element(entries.begin(), entries.end(),
+                                                   [](const auto &a, const auto &b) { return a.first < b.first; });
+            min_ = low->first;
+            const std::uint64_t span = static_cast<std::uint64_t>(high->first) - static_cast<std::uint64_t>(min_);
+            if (span < std::max<std::uint64_t>(kDenseMinimum, 4 * entries.size())) {
+                dense_.assign(span + 1, kNone);
+                for (const auto &[key, value] : entries)
+                    dense_[static_cast<std::uint64_t>(key) - static_cast<std::uint64_t>(min_)] = value;
+                return;
+            }
+            buildHash(entries);
+        }
+
+        std::uint32_t find(std::int64_t key) const {
+            if (!dense_.empty()) {
+                const std::uint64_t offset = static_cast<std::uint64_t>(key) - static_cast<std::uint64_t>(min_);
+                return offset < dense_.size() ? dense_[offset] : kNone;
+            }
+            if (buckets_.empty())
+                return kNone;
+            const Bucket &bucket = buckets_[reduce(hash(key, seed_), buckets_.size())];
+            if (bucket.size == 0)
+                return kNone;
+            const std::size_t slot = bucket.offset + reduce(hash(key, bucket.seed), bucket.size);
+            return slotKeys_[slot] == key ? slotValues_[slot] : kNone;
+        }
+
+        std::size_t size() const { return count_; }
+        // True when lookups index a table by key instead of hashing
+        bool dense() const { return !dense_.empty(); }
+
+      private:
+        struct Bucket {
+            std::uint32_t offset = 0;
+            std::uint32_t size = 0;
+            std::uint64_t seed = 0;
+        };
+
+        static constexpr std::uint64_t kDenseMinimum = 64;
+
+        static std::uint64_t hash(std::int64_t key, std::uint64_t seed) {
+            return splitmix64(static_cast<std::uint64_t>(key) ^ seed);
+        }
+
+        // Maps a hash onto [0, range) with a multiply and shift instead of a division
+        static std::size_t reduce(std::uint64_t hash, std::size_t range) {
+            return static_cast<std::size_t>(((hash >> 32) * static_cast<std::uint64_t>(range)) >> 32);
+        }
+
+        void buildHash(const std::vector<std::pair<std::int64_t, std::uint32_t>> &entries) {
+            const std::size_t n = entries.size();
+            buckets_.resize(n);
+            members_.resize(n);
+            // Retry the first level until the squared bucket sizes stay within 4n (expected after two tries)
+            for (seed_ = 1;; ++seed_) {
+                for (auto &members : members_)
+                    members.clear();
+                for (std::size_t i = 0; i < n; ++i)
+                    members_[reduce(hash(entries[i].first, seed_), n)].push_back(static_cast<std::uint32_t>(i));
+                std::size_t slots = 0;
+                for (const auto &members : members_)
+                    slots += members.size() * members.size();
+                if (slots <= 4 * n)
+                    break;
+            }
+
+            std::uint32_t offset = 0;
+            for (std::size_t b = 0; b < n; ++b) {
+                const auto &members = members_[b];
+                Bucket &bucket = buckets_[b];
+                bucket = Bucket{offset, static_cast<std::uint32_t>(members.size() * members.size()), 0};
+                slotKeys_.resize(offset + bucket.size);
+                slotValues_.resize(offset + bucket.size, kNone);
+                // A bucket of b keys in b^2 slots is collision-free for at least half of all seeds
+                for (bool placed = members.empty(); !placed;) {
+                    ++bucket.seed;
+                    std::fill(slotValues_.begin() + offset, slotValues_.end(), kNone);
+                    placed = true;
+                    for (std::uint32_t i : members) {
+                        const std::size_t slot = offset + reduce(hash(entries[i].first, bucket.seed), bucket.size);
+                        if (slotValues_[slot] != kNone) {
+                            placed = false;
+                            break;
+                        }
+                        slotKeys_[slot] = entries[i].first;
+                        slotValues_[slot] = entries[i].second;
+                    }
+                }
+                offset += bucket.size;
+            }
+        }
+
+        std::size_t count_ = 0;
+        std::int64_t min_ = 0;
+        std::vector<std::uint32_t> dense_;
+        std::uint64_t seed_ = 0;
+        std::vector<Bucket> buckets_;
+        std::vector<std::int64_t> slotKeys_;
+        std::vector<std::uint32_t> slotValues_;
+        std::vector<std::vector<std::uint32_t>> members_; // build scratch
+    };
+
+} // namespace stateup::core
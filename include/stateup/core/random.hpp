@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+
+namespace stateup::core {
+
+    // SplitMix64 finalizer: a bijective mix of all 64 bits, used to derive keys and to turn counters into draws
+    constexpr std::uint64_t splitmix64(std::uint64_t x) {
+        x += 0x9e3779b97f4a7c15ull;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    // ============================================================================
+    // RandomStream - counter-based random numbers
+    //
+    // Draw n of a stream is a hash of (seed, stream, n), so a stream is 32 bytes instead of mt19937's 5 KB, a draw
+    // is a handful of multiplies, and what a stream yields depends only on its own draws: streams that run on
+    // different threads, in whatever order, come out the same for the same seed. Different stream numbers under
+    // one seed are independent sequences. Satisfies UniformRandomBitGenerator, so it works with the <random>
+    // distributions.
+    // ============================================================================
+    class RandomStream {
+      public:
+        using result_type = std::uint64_t;
+
+        explicit RandomStream(std::uint64_t stream = 0, std::uint64_t seed = 0) : stream_(stream), seed_(seed) {
+            rekey();
+        }
+
+        // Changing the seed or stream keeps the position, so a stream reseeded by its owner carries on from there
+        void seed(std::uint64_t seed) {
+            if (seed != seed_) {
+                seed_ = seed;
+                rekey();
+            }
+        }
+        void setStream(std::uint64_t stream) {
+            stream_ = stream;
+            rekey();
+        }
+        std::uint64_t seed() const { return seed_; }
+        std::uint64_t stream() const { return stream_; }
+
+        // Draws taken so far; seek() replays or skips ahead in O(1)
+        std::uint64_t position() const { return counter_; }
+        void seek(std::uint64_t position) { counter_ = position; }
+
+        result_type operator()() { return splitmix64(key_ + counter_++ * 0x9e3779b97f4a7c15ull); }
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+      private:
+        void rekey() { key_ = splitmix64(seed_ ^ splitmix64(stream_)); }
+
+        std::uint64_t stream_;
+        std::uint64_t seed_;
+        std::uint64_t key_ = 0;
+        std::uint64_t counter_ = 0;
+    };
+
+} // namespace stateup::core
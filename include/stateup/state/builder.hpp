@@ -3,6 +3,7 @@
 #include "structure/composite_state.hpp"
 #include "structure/state.hpp"
 #include "structure/transition.hpp"
+#include "typed_machine.hpp"
 #include <functional>
 #include <memory>
 #include <stdexcept>
@@ -206,34 +207,57 @@ namespace stateup::state {
             return *this;
         }
 
+        // Optional: set the locking strategy of the machine's blackboard
+        Builder &lockPolicy(tree::LockPolicy policy) {
+            lockPolicy_ = policy;
+            return *this;
+        }
+
         // Build the state machine
         std::unique_ptr<StateMachine> build() {
+            auto machine = std::make_unique<StateMachine>();
+            populate(*machine);
+            return machine;
+        }
+
+        // Build a machine owning a typed context; write callbacks with tree::contextual<Context>(...)
+        template <typename Context> std::unique_ptr<TypedStateMachine<Context>> buildTyped(Context context = {}) {
+            auto machine = std::make_unique<TypedStateMachine<Context>>(std::move(context));
+            populate(*machine);
+            return machine;
+        }
+
+      private:
+        void populate(StateMachine &machine) {
             if (initialStateName_.empty()) {
                 throw std::runtime_error("No initial state set. Use initial() to set the starting state.");
             }
-
-            auto machine = std::make_unique<StateMachine>();
+            // Transition callbacks are move-only and end up in the machine
+            if (built_) {
+                throw std::runtime_error("A state machine Builder can only build once.");
+            }
+            built_ = true;
 
             // Add all states
             for (const auto &[name, state] : states_) {
-                machine->addState(state);
+                machine.addState(state);
             }
 
             // Set initial state
-            machine->setInitialState(states_[initialStateName_]);
+            machine.setInitialState(states_[initialStateName_]);
 
             // Add all transitions
-            for (const auto &trans : pendingTransitions_) {
+            for (auto &trans : pendingTransitions_) {
                 if (trans.result == TransitionResult::VALID) {
                     auto transition = std::make_shared<Transition>(states_[trans.from], states_[trans.to],
-                                                                   trans.condition, trans.priority);
+                                                                   std::move(trans.condition), trans.priority);
 
                     // Apply optional features
                     if (trans.duration.has_value()) {
                         transition->setDuration(trans.duration.value());
                     }
                     if (trans.action.has_value()) {
-                        transition->setAction(trans.action.value());
+                        transition->setAction(std::move(*trans.action));
                     }
                     if (trans.probability.has_value()) {
                         transition->setProbability(trans.probability.value());
@@ -242,23 +266,21 @@ namespace stateup::state {
                         transition->setWeight(trans.weight.value());
                     }
 
-                    machine->addTransition(transition);
+                    machine.addTransition(transition);
                 } else {
                     // EVENT_IGNORED or CANNOT_HAPPEN
                     auto transition = std::make_shared<Transition>(states_[trans.from], trans.result);
-                    machine->addTransition(transition);
+                    machine.addTransition(transition);
                 }
             }
 
             // Propagate executor if provided
             if (executor_) {
-                machine->setExecutor(executor_);
+                machine.setExecutor(executor_);
             }
-
-            return machine;
+            machine.setLockPolicy(lockPolicy_);
         }
 
-      private:
         void ensureCurrentState(const char *context) const {
             if (currentStateName_.empty()) {
                 throw std::runtime_error(std::string("No current state set. Call state() before ") + context);
@@ -288,6 +310,8 @@ namespace stateup::state {
         std::unordered_map<std::string, StatePtr> states_;
         std::vector<PendingTransition> pendingTransitions_;
         stateup::core::ThreadPool *executor_ = nullptr;
+        tree::LockPolicy lockPolicy_ = tree::LockPolicy::Mutex;
+        bool built_ = false;
     };
 
 } // namespace stateup::state
@@ -1,5 +1,8 @@
 #pragma once
 #include "../tree/structure/blackboard.hpp"
+#include "../tree/structure/tick_clock.hpp"
+#include "../tree/structure/tick_random.hpp"
+#include "stateup/core/alias_table.hpp"
 #include "structure/state.hpp"
 #include "structure/transition.hpp"
 #include <chrono>
@@ -67,15 +70,33 @@ namespace stateup::state {
         tree::Blackboard &blackboard() { return blackboard_; }
         const tree::Blackboard &blackboard() const { return blackboard_; }
 
-        // FIX: Add state history
-        const std::vector<std::string> &getStateHistory() const { return stateHistory_; }
-        void clearHistory() { stateHistory_.clear(); }
+        // Blackboard locking strategy; LockPolicy::None evaluates transition conditions inline
+        void setLockPolicy(tree::LockPolicy policy) { blackboard_.setLockPolicy(policy); }
+        tree::LockPolicy lockPolicy() const { return blackboard_.lockPolicy(); }
+
+        // Names of the last MAX_HISTORY states entered, oldest first
+        std::vector<std::string> getStateHistory() const;
+        void clearHistory() { historySize_ = 0; }
         StatePtr getPreviousState() const { return previousState_; }
         void transitionToPrevious();
 
+        // Clock that timed transitions and history timestamps read, sampled once per tick (see tree::TickTime);
+        // null for the steady clock
+        void setClock(std::shared_ptr<tree::TickClock> clock) { clock_ = std::move(clock); }
+        const std::shared_ptr<tree::TickClock> &clock() const { return clock_; }
+
+        // Seed that weighted and probabilistic transitions draw under (see tree::TickRandom); fresh for every
+        // machine unless set
+        void setSeed(std::uint64_t seed) { seed_ = seed; }
+        std::uint64_t seed() const { return seed_; }
+
         // Optional: pluggable executor
         void setExecutor(stateup::core::ThreadPool *pool) { executor_ = pool; }
 
+        // Conditions estimated to evaluate faster than this run inline instead of on the executor
+        void setPoolThreshold(std::chrono::nanoseconds threshold) { poolThreshold_ = threshold; }
+        std::chrono::nanoseconds poolThreshold() const { return poolThreshold_; }
+
         // Debugging support
         using DebugCallback = std::function<void(const DebugInfo &)>;
         void setDebugCallback(DebugCallback callback) { debugCallback_ = std::move(callback); }
@@ -96,8 +117,7 @@ namespace stateup::state {
 
       private:
         void transitionTo(const StatePtr &newState);
-        void transitionTo(const StatePtr &newState, const std::string &reason);
-        std::vector<TransitionPtr> getTransitionsFrom(const StatePtr &state) const;
+        void transitionTo(const StatePtr &newState, const char *reason);
         void startTimersForState(const StatePtr &state);
         void resetTimersForState(const StatePtr &state);
         void notifyDebug(const DebugInfo &info);
@@ -108,9 +128,25 @@ namespace stateup::state {
         std::unordered_map<std::string, StatePtr> states_;
         std::vector<TransitionPtr> transitions_;
         tree::Blackboard blackboard_;
-        std::vector<std::string> stateHistory_;    // FIX: Track state history
-        static constexpr size_t MAX_HISTORY = 100; // Limit history size
+        std::shared_ptr<tree::TickClock> clock_;
+        std::uint64_t seed_ = tree::TickRandom::freshSeed();
+        stateup::core::RandomStream rng_; // the machine's own stream; its seed tells machines apart
+        // Ring of the states entered, allocated up front so that recording a transition does not allocate
+        static constexpr size_t MAX_HISTORY = 100;
+        std::vector<StatePtr> stateHistory_ = std::vector<StatePtr>(MAX_HISTORY);
+        size_t historyStart_ = 0; // oldest entry
+        size_t historySize_ = 0;
         stateup::core::ThreadPool *executor_ = nullptr;
+        std::chrono::nanoseconds poolThreshold_ = stateup::core::kDefaultPoolThreshold;
+        // Per-tick scratch, kept to avoid allocating on every tick
+        std::vector<const Transition *> candidates_; // transitions out of the current state
+        std::vector<char> results_;                  // condition result per candidate
+        std::vector<size_t> pooled_;                 // candidates sent to the executor
+        std::vector<size_t> weighted_;               // valid weighted candidates
+        // Alias table over the weighted transitions it was built from; rebuilt only when the set or a weight changes
+        std::vector<const Transition *> sampledTransitions_;
+        std::vector<float> sampledWeights_;
+        stateup::core::AliasTable weightedSampler_;
 
         // Debugging support
         DebugCallback debugCallback_;
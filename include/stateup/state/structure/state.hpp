@@ -1,6 +1,6 @@
 #pragma once
 #include "../../tree/structure/blackboard.hpp"
-#include <functional>
+#include "stateup/core/inplace_function.hpp"
 #include <memory>
 #include <string>
 
@@ -8,8 +8,8 @@ namespace stateup::state {
 
     class State {
       public:
-        using Func = std::function<void(tree::Blackboard &)>;
-        using GuardFunc = std::function<bool(tree::Blackboard &)>;
+        using Func = core::InplaceFunction<void(tree::Blackboard &)>;
+        using GuardFunc = core::InplaceFunction<bool(tree::Blackboard &)>;
 
         explicit State(std::string name) : name_(std::move(name)) {}
         virtual ~State() = default;
@@ -1,8 +1,10 @@
 #pragma once
 #include "../../tree/structure/blackboard.hpp"
+#include "../../tree/structure/tick_clock.hpp"
+#include "stateup/core/cost_estimate.hpp"
+#include "stateup/core/inplace_function.hpp"
 #include "state.hpp"
 #include <chrono>
-#include <functional>
 #include <memory>
 #include <optional>
 #include <stdexcept>
@@ -19,8 +21,8 @@ namespace stateup::state {
 
     class Transition {
       public:
-        using Condition = std::function<bool(tree::Blackboard &)>;
-        using Action = std::function<void(tree::Blackboard &)>;
+        using Condition = core::InplaceFunction<bool(tree::Blackboard &)>;
+        using Action = core::InplaceFunction<void(tree::Blackboard &)>;
         using Duration = std::chrono::milliseconds;
         using TimePoint = std::chrono::steady_clock::time_point;
 
@@ -44,7 +46,7 @@ namespace stateup::state {
 
             // Check timed transition
             if (isTimedTransition() && hasTimerStarted()) {
-                auto elapsed = std::chrono::steady_clock::now() - timerStartTime_.value();
+                auto elapsed = tree::TickTime::now() - timerStartTime_.value();
                 if (elapsed >= duration_.value()) {
                     // Timer expired - check condition if present, otherwise allow transition
                     return !condition_ || condition_(blackboard);
@@ -79,10 +81,10 @@ namespace stateup::state {
         }
         int getPriority() const { return priority_; }
 
-        // Timed transition support
+        // Timed transition support; timers run on the state machine's clock (see StateMachine::setClock)
         void setDuration(Duration duration) { duration_ = duration; }
         bool isTimedTransition() const { return duration_.has_value(); }
-        void startTimer() { timerStartTime_ = std::chrono::steady_clock::now(); }
+        void startTimer() { timerStartTime_ = tree::TickTime::now(); }
         void resetTimer() { timerStartTime_.reset(); }
         bool hasTimerStarted() const { return timerStartTime_.has_value(); }
         std::optional<Duration> getDuration() const { return duration_; }
@@ -104,6 +106,9 @@ namespace stateup::state {
         std::optional<float> getProbability() const { return probability_; }
         std::optional<float> getWeight() const { return weight_; }
 
+        // Measured cost of shouldTransition(); the state machine evaluates cheap conditions inline
+        core::CostEstimate &conditionCost() const { return conditionCost_; }
+
       private:
         StatePtr from_;
         StatePtr to_;
@@ -119,6 +124,8 @@ namespace stateup::state {
         // Probabilistic transitions
         std::optional<float> probability_;
         std::optional<float> weight_;
+
+        mutable core::CostEstimate conditionCost_;
     };
 
     using TransitionPtr = std::shared_ptr<Transition>;
@@ -0,0 +1,27 @@
+#pragma once
+#include "../tree/typed_tree.hpp"
+#include "machine.hpp"
+#include <utility>
+
+namespace stateup::state {
+
+    // StateMachine owning a typed context bound to its blackboard (see tree::TypedTree). Callbacks written with
+    // tree::contextual<Context>(...) reach the struct members directly. Nested machines of composite states
+    // keep their own blackboards, as with the untyped machine.
+    template <typename Context> class TypedStateMachine : public StateMachine {
+      public:
+        explicit TypedStateMachine(Context context = {}) : context_(std::move(context)) {
+            blackboard().bindContext(&context_);
+        }
+
+        TypedStateMachine(const TypedStateMachine &) = delete;
+        TypedStateMachine &operator=(const TypedStateMachine &) = delete;
+
+        Context &context() { return context_; }
+        const Context &context() const { return context_; }
+
+      private:
+        Context context_;
+    };
+
+} // namespace stateup::state
@@ -4,6 +4,9 @@
 #include "tree/structure/blackboard.hpp"
 #include "tree/structure/node.hpp"
 #include "tree/structure/status.hpp"
+#include "tree/structure/tick_clock.hpp"
+#include "tree/structure/tick_random.hpp"
+#include "tree/structure/wakeup.hpp"
 
 // Node types
 #include "tree/nodes/action.hpp"
@@ -16,7 +19,13 @@
 
 // Tree and builder
 #include "tree/builder.hpp"
+#include "tree/compiled_tree.hpp"
+#include "tree/forest.hpp"
+#include "tree/memoize.hpp"
+#include "tree/static_tree.hpp"
 #include "tree/tree.hpp"
+#include "tree/typed_tree.hpp"
+#include "tree/utility_curves.hpp"
 
 // State machine
 #include "state/state.hpp"
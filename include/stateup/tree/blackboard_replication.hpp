@@ -0,0 +1,135 @@
+#pragma once
+#include "blackboard_serializer.hpp"
+#include "structure/blackboard.hpp"
+#include "type_registry.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace stateup::tree {
+
+    // ============================================================================
+    // Blackboard replication - delta-encoded frames for followers and logs
+    //
+    // Frame layout (native byte order):
+    //   header: "SUBD" magic (4) | uint32 version | uint64 sequence | uint32 flags | uint32 record count
+    //   record: same as BlackboardSerializer snapshot records
+    //
+    // A keyframe carries every visible entry and replaces the follower's contents; a delta carries only the
+    // entries written since the previous frame. Removals, clear() and scope pops cannot be expressed as
+    // writes, so the frame after one of them is always a keyframe.
+    // ============================================================================
+
+    class DeltaEncoder {
+      public:
+        static constexpr std::uint32_t kFrameVersion = 1;
+        static constexpr std::uint32_t kKeyframe = 1u << 0;
+        static constexpr size_t kFrameHeaderSize = 24;
+
+        // keyframeInterval: emit a keyframe at least every N frames (0 = only when required)
+        explicit DeltaEncoder(const TypeRegistry &registry = TypeRegistry::defaults(), size_t keyframeInterval = 1000)
+            : registry_(&registry), keyframeInterval_(keyframeInterval) {}
+
+        // Encode the next frame into out (cleared first; its capacity is reused). Returns true for a keyframe.
+        bool encode(const Blackboard &blackboard, std::vector<std::uint8_t> &out);
+
+        // Force the next frame to be a keyframe (e.g. when a new follower attaches)
+        void requestKeyframe() { forceKeyframe_ = true; }
+
+        std::uint64_t sequence() const { return sequence_; }
+
+      private:
+        const TypeRegistry *registry_;
+        size_t keyframeInterval_;
+        std::uint64_t sequence_ = 0;
+        std::uint64_t revision_ = 0;
+        std::uint64_t structureRevision_ = 0;
+        size_t sinceKeyframe_ = 0;
+        bool forceKeyframe_ = true;
+    };
+
+    // Applies frames produced by a DeltaEncoder to a follower blackboard
+    class BlackboardFollower {
+      public:
+        explicit BlackboardFollower(Blackboard &blackboard, const TypeRegistry &registry = TypeRegistry::defaults())
+            : blackboard_(blackboard), registry_(&registry) {}
+
+        // Returns false if the frame was ignored because a delta arrived without its predecessor; the follower
+        // then waits for the next keyframe. Throws std::runtime_error on malformed frames.
+        bool apply(const std::uint8_t *data, size_t size);
+        bool apply(const std::vector<std::uint8_t> &frame) { return apply(frame.data(), frame.size()); }
+
+        // Apply every frame of a stream written by BlackboardReplicator::fileSink. Returns frames applied.
+        size_t replay(const std::string &filename);
+
+        bool synchronized() const { return synchronized_; }
+        std::uint64_t lastSequence() const { return lastSequence_; }
+
+      private:
+        Blackboard &blackboard_;
+        const TypeRegistry *registry_;
+        std::uint64_t lastSequence_ = 0;
+        bool synchronized_ = false;
+    };
+
+    // Producer side: encodes frames on the ticking thread into a bounded single-producer/single-consumer ring
+    // and hands them to a sink on a dedicated writer thread, so capture() never waits for I/O.
+    // When the ring is full capture() encodes nothing; its changes roll into the next frame that fits.
+    class BlackboardReplicator {
+      public:
+        using Sink = std::function<void(const std::uint8_t *data, size_t size)>;
+
+        struct Options {
+            size_t ringCapacity = 64;
+            size_t keyframeInterval = 1000;
+            const TypeRegistry *registry = &TypeRegistry::defaults();
+        };
+
+        struct Stats {
+            std::uint64_t frames = 0;    // frames enqueued
+            std::uint64_t keyframes = 0; // of which keyframes
+            std::uint64_t dropped = 0;   // captures skipped because the ring was full
+            std::uint64_t bytes = 0;     // bytes handed to the sink
+        };
+
+        BlackboardReplicator(const Blackboard &blackboard, Sink sink)
+            : BlackboardReplicator(blackboard, std::move(sink), {}) {}
+        BlackboardReplicator(const Blackboard &blackboard, Sink sink, Options options);
+        BlackboardReplicator(const BlackboardReplicator &) = delete;
+        BlackboardReplicator &operator=(const BlackboardReplicator &) = delete;
+        ~BlackboardReplicator(); // drains the ring, then joins the writer thread
+
+        // Capture one frame (call once per tick). Returns false if the ring was full.
+        bool capture();
+        void requestKeyframe() { encoder_.requestKeyframe(); }
+
+        // Block until every captured frame has reached the sink
+        void flush();
+
+        Stats stats() const;
+
+        // Sink appending length-prefixed (uint32) frames to a file, readable by BlackboardFollower::replay
+        static Sink fileSink(const std::string &filename);
+
+      private:
+        void writerLoop();
+
+        const Blackboard &blackboard_;
+        Sink sink_;
+        DeltaEncoder encoder_;
+        std::vector<std::vector<std::uint8_t>> ring_;
+        std::atomic<std::uint64_t> head_{0}; // next frame for the writer
+        std::atomic<std::uint64_t> tail_{0}; // next free slot for capture()
+        std::atomic<std::uint32_t> wake_{0}; // bumped on every capture and on shutdown
+        std::atomic<bool> stop_{false};
+        std::atomic<std::uint64_t> keyframes_{0};
+        std::atomic<std::uint64_t> dropped_{0};
+        std::atomic<std::uint64_t> bytes_{0};
+        std::thread writer_;
+    };
+
+} // namespace stateup::tree
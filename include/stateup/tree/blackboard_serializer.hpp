@@ -1,8 +1,11 @@
 #pragma once
 #include "structure/blackboard.hpp"
+#include "type_registry.hpp"
+#include <cstdint>
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace stateup::tree {
 
@@ -13,34 +16,34 @@ namespace stateup::tree {
             std::stringstream ss;
             ss << "{\n";
 
-            auto keys = blackboard.getAllKeys();
-            for (size_t i = 0; i < keys.size(); ++i) {
-                const auto &key = keys[i];
-                auto typeInfo = blackboard.getType(key);
+            // Single pass under one lock; values are read in place without get<T>() probing
+            bool first = true;
+            blackboard.forEachEntry([&](const std::string &key, const std::any &value, std::type_index type) {
+                if (!first)
+                    ss << ",\n";
+                first = false;
 
                 ss << "  \"" << key << "\": {";
-                ss << "\"type\": \"" << (typeInfo ? typeInfo->name() : "unknown") << "\"";
+                ss << "\"type\": \"" << type.name() << "\"";
 
-                // Try to get common types
-                if (auto val = blackboard.get<int>(key)) {
+                if (auto val = std::any_cast<int>(&value)) {
                     ss << ", \"value\": " << *val;
-                } else if (auto val = blackboard.get<float>(key)) {
+                } else if (auto val = std::any_cast<float>(&value)) {
                     ss << ", \"value\": " << *val;
-                } else if (auto val = blackboard.get<double>(key)) {
+                } else if (auto val = std::any_cast<double>(&value)) {
                     ss << ", \"value\": " << *val;
-                } else if (auto val = blackboard.get<bool>(key)) {
+                } else if (auto val = std::any_cast<bool>(&value)) {
                     ss << ", \"value\": " << (*val ? "true" : "false");
-                } else if (auto val = blackboard.get<std::string>(key)) {
+                } else if (auto val = std::any_cast<std::string>(&value)) {
                     ss << ", \"value\": \"" << *val << "\"";
                 } else {
                     ss << ", \"value\": \"<complex_type>\"";
                 }
 
                 ss << "}";
-                if (i < keys.size() - 1)
-                    ss << ",";
+            });
+            if (!first)
                 ss << "\n";
-            }
 
             ss << "}\n";
             return ss.str();
@@ -80,6 +83,52 @@ namespace stateup::tree {
             deserialize(blackboard, buffer.str());
             return true;
         }
+
+        // ------------------------------------------------------------------------
+        // Binary snapshots
+        //
+        // Layout (native byte order):
+        //   header: "SUBB" magic (4) | uint32 version | uint64 record count
+        //   record: uint32 record size (bytes after this field) | uint32 type id | uint32 key size | key | payload
+        //
+        // Type ids come from the TypeRegistry (hash of the registered type name), so snapshots are portable
+        // between processes that register the same names. Entries whose type is not registered are skipped.
+        // ------------------------------------------------------------------------
+        static constexpr std::uint32_t kSnapshotVersion = 1;
+
+        struct SnapshotStats {
+            size_t records = 0; // entries written / restored
+            size_t skipped = 0; // entries with no registered codec
+        };
+
+        // Encode the visible entries into a binary snapshot
+        static std::vector<std::uint8_t> snapshot(const Blackboard &blackboard,
+                                                  const TypeRegistry &registry = TypeRegistry::defaults(),
+                                                  SnapshotStats *stats = nullptr);
+
+        // Replace the blackboard contents with a snapshot. Throws std::runtime_error on malformed data.
+        static SnapshotStats restore(Blackboard &blackboard, const std::uint8_t *data, size_t size,
+                                     const TypeRegistry &registry = TypeRegistry::defaults());
+        static SnapshotStats restore(Blackboard &blackboard, const std::vector<std::uint8_t> &data,
+                                     const TypeRegistry &registry = TypeRegistry::defaults()) {
+            return restore(blackboard, data.data(), data.size(), registry);
+        }
+
+        // Record-level helpers shared with the replication stream (see blackboard_replication.hpp).
+        // appendRecord returns false (writing nothing) when the type has no registered codec.
+        static bool appendRecord(std::vector<std::uint8_t> &out, const std::string &key, const std::any &value,
+                                 std::type_index type, const TypeRegistry &registry);
+        // Decodes `count` records from data; unregistered types are counted in skipped.
+        // Returns the number of bytes consumed. Throws std::runtime_error on malformed data.
+        static size_t readRecords(const std::uint8_t *data, size_t size, std::uint64_t count,
+                                  const TypeRegistry &registry, std::vector<Blackboard::RawEntry> &entries,
+                                  size_t &skipped);
+
+        // Write / read a snapshot through a memory-mapped file
+        static bool saveSnapshot(const Blackboard &blackboard, const std::string &filename,
+                                 const TypeRegistry &registry = TypeRegistry::defaults());
+        static bool loadSnapshot(Blackboard &blackboard, const std::string &filename,
+                                 const TypeRegistry &registry = TypeRegistry::defaults());
     };
 
 } // namespace stateup::tree
\ No newline at end of file
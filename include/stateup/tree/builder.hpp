@@ -1,4 +1,5 @@
 #pragma once
+#include "compiled_tree.hpp"
 #include "nodes/action.hpp"
 #include "nodes/advanced.hpp"
 #include "nodes/control_flow.hpp"
@@ -11,6 +12,7 @@
 #include <memory>
 #include <optional>
 #include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -27,14 +29,27 @@ namespace stateup::tree {
       public:
         Builder &sequence();
         Builder &selector();
+        // Selector that ticks runs of pure() children concurrently on the executor; see Selector
+        Builder &speculativeSelector();
         Builder &parallel(Parallel::Policy successPolicy, Parallel::Policy failurePolicy);
         Builder &parallel(size_t successThreshold, std::optional<size_t> failureThreshold = std::nullopt);
-        Builder &decorator(Decorator::Func func);
+        // Parallel in Mode::Concurrent: children tick as background jobs and never stall the tree tick
+        Builder &concurrentParallel(Parallel::Policy successPolicy, Parallel::Policy failurePolicy);
+        Builder &concurrentParallel(size_t successThreshold, std::optional<size_t> failureThreshold = std::nullopt);
+        // Pass stateless = true if func keeps nothing between calls; see Decorator
+        Builder &decorator(Decorator::Func func, bool stateless = false);
         Builder &action(Action::Func func);
         Builder &actionTask(Action::TaskFunc func);
+        // Add any leaf node; pending repeat()/retry() and decorators wrap it like an action
+        Builder &leaf(NodePtr node);
         Builder &executor(stateup::core::ThreadPool *pool);
+        Builder &lockPolicy(LockPolicy policy);
         Builder &end();
         Tree build();
+        // Validate and return the root node without wrapping it in a Tree
+        NodePtr buildRoot();
+        // Build and flatten into a CompiledTree (see compiled_tree.hpp)
+        CompiledTree buildCompiled();
 
         // Convenience methods for common decorators
         Builder &inverter();
@@ -45,16 +60,29 @@ namespace stateup::tree {
         Builder &retry(int maxTimes = -1);
 
         // Control flow nodes
-        Builder &condition(std::function<bool(Blackboard &)> cond, std::function<void(Builder &)> thenBranch,
+        Builder &condition(ConditionalNode::ConditionFunc cond, std::function<void(Builder &)> thenBranch,
                            std::function<void(Builder &)> elseBranch = nullptr);
-        Builder &whileLoop(std::function<bool(Blackboard &)> condition, std::function<void(Builder &)> body,
+        Builder &whileLoop(WhileNode::ConditionFunc condition, std::function<void(Builder &)> body,
                            int maxIterations = -1);
         Builder &forLoop(int count, std::function<void(Builder &)> body);
-        Builder &forLoop(std::function<int(Blackboard &)> countFunc, std::function<void(Builder &)> body);
-        Builder &switchNode(std::function<std::string(Blackboard &)> selector);
+        Builder &forLoop(ForNode::CountFunc countFunc, std::function<void(Builder &)> body);
+        Builder &switchNode(SwitchNode::SelectorFunc selector);
+        // Switch on an integer or enum key with heap-free case selection (see IntSwitchNode); cases are added with
+        // addCase() and the switch is placed by defaultCase(), as for switchNode()
+        Builder &intSwitch(IntSwitchNode::SelectorFunc selector);
+        template <typename Enum> Builder &enumSwitch(typename EnumSwitchNode<Enum>::SelectorFunc selector) {
+            return openIntSwitch(std::make_shared<EnumSwitchNode<Enum>>(std::move(selector)));
+        }
         Builder &addCase(const std::string &caseValue, std::function<void(Builder &)> body);
+        Builder &addCase(std::int64_t caseValue, std::function<void(Builder &)> body);
+        template <typename Enum, std::enable_if_t<std::is_enum_v<Enum>, int> = 0>
+        Builder &addCase(Enum caseValue, std::function<void(Builder &)> body) {
+            return addCase(static_cast<std::int64_t>(caseValue), std::move(body));
+        }
         Builder &defaultCase(std::function<void(Builder &)> body);
         Builder &memory(MemoryNode::MemoryPolicy policy = MemoryNode::MemoryPolicy::REMEMBER_FINISHED);
+        // Wrap the next node in a CachedNode: skip it while the blackboard keys it read are unchanged
+        Builder &cached();
         Builder &conditionalSequence();
 
         // New reactive and dynamic nodes
@@ -67,31 +95,62 @@ namespace stateup::tree {
         Builder &probabilitySelector();
         Builder &oneShotSequence();
         Builder &debounce(std::chrono::milliseconds debounceTime);
+        // Tick the next node (a subtree, composite or leaf) at most once per period; see ThrottleNode
+        Builder &throttle(ThrottleNode::Duration period);
+
+        // Declare the blackboard keys the next node reads and writes. build() ticks runs of consecutive Sequence
+        // children with declared, disjoint keys concurrently on the executor (see SequenceGroup); the node must
+        // touch nothing else.
+        Builder &access(std::vector<std::string> reads, std::vector<std::string> writes);
+        // Mark the next node as free of side effects, so a speculativeSelector() may tick it ahead of its turn
+        // and throw the result away
+        Builder &pure();
 
       private:
+        Builder &openParallel(std::shared_ptr<Parallel> node);
+        Builder &openIntSwitch(std::shared_ptr<IntSwitchNode> node);
         void add(const NodePtr &node);
         NodePtr applyPendingDecorators(NodePtr node);
         void ensureNoPendingDecorators(const char *context) const;
         void ensureNoPendingLeafModifiers(const char *context) const;
         void validateTree(const NodePtr &node) const;
+        void groupIndependentChildren();
 
         static constexpr int kNoPendingModifier = -2;
 
         NodePtr root_;
         std::vector<NodePtr> stack_;
-        std::vector<Decorator::Func> decorators_;
+        struct PendingDecorator {
+            Decorator::Func func;
+            bool stateless;
+        };
+        std::vector<PendingDecorator> decorators_;
         int pendingRepeat_ = kNoPendingModifier; // -2 means no repeat pending, -1 means infinite repeat
         int pendingRetry_ = kNoPendingModifier;  // -2 means no retry pending, -1 means infinite retry
 
         // Pending structural decorator nodes
         std::optional<MemoryNode::MemoryPolicy> pendingMemoryPolicy_ = std::nullopt;
         std::optional<std::chrono::milliseconds> pendingDebounceTime_ = std::nullopt;
+        bool pendingCached_ = false;
+        std::optional<ThrottleNode::Duration> pendingThrottlePeriod_ = std::nullopt;
+
+        // Declared keys per node, and the sequences whose children build() may group
+        std::optional<KeyAccess> pendingAccess_ = std::nullopt;
+        std::unordered_map<const Node *, KeyAccess> access_;
+        std::vector<std::shared_ptr<Sequence>> sequences_;
+        bool pendingPure_ = false;
+        // Stream numbers of the random selectors built so far (see TickRandom)
+        std::uint64_t nextStream_ = 0;
 
         // For switch node building
         std::shared_ptr<SwitchNode> currentSwitch_ = nullptr;
+        std::shared_ptr<IntSwitchNode> currentIntSwitch_ = nullptr;
 
         // Optional executor applied to parallel nodes
         stateup::core::ThreadPool *executor_ = nullptr;
+
+        // Locking strategy of the built tree's blackboard
+        LockPolicy lockPolicy_ = LockPolicy::Mutex;
     };
 
 } // namespace stateup::tree
@@ -0,0 +1,144 @@
+#pragma once
+#include "nodes/action.hpp"
+#include "nodes/decorator.hpp"
+#include "structure/blackboard.hpp"
+#include "structure/node.hpp"
+#include "structure/tick_random.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+namespace stateup::tree {
+
+    class Builder;
+
+    // ============================================================================
+    // TreeDefinition - a behavior tree flattened into an immutable pre-order program
+    //
+    // Sequence, Selector, stateless Decorator, RepeatDecorator, RetryDecorator, SubtreeNode and synchronous Action
+    // nodes are lowered into contiguous records: a node's children follow it directly, and each record stores the
+    // index one past its subtree, so siblings are reached by a jump instead of a pointer. Callbacks stay in the
+    // lowered nodes, which the definition keeps alive, and are shared by every instance, so per-agent data belongs
+    // on the instance's blackboard. Run state (statuses, cursors, repeat/retry counters) lives in the instance.
+    //
+    // Any other node (Parallel, speculative selectors, control flow, async or coroutine actions, and decorators
+    // whose function may keep state, such as decorators::Repeat, Timeout or Cooldown) is embedded as-is and ticked
+    // through its virtual interface, so a compiled tree returns exactly what the pointer tree would.
+    // ============================================================================
+    class TreeDefinition {
+      public:
+        using Ptr = std::shared_ptr<const TreeDefinition>;
+
+        // Compile the tree `describe` builds, for many instances. A subtree used in several places gets its own
+        // run state at each use. If the program embeds nodes, every instance calls `describe` again to own fresh
+        // copies of them; fully lowered trees never call it after compilation.
+        static Ptr define(std::function<void(Builder &)> describe);
+
+        size_t size() const { return program_.size(); }
+        size_t embeddedCount() const { return prototypes_.size(); }
+
+      private:
+        friend class TreeInstance;
+        friend class CompiledTree;
+
+        // Compile an existing tree for a single instance (CompiledTree). Embedded nodes, and nodes reachable from
+        // more than one parent, stay the source tree's objects, so a second TreeInstance of a definition that embeds
+        // any is rejected. A concurrent Parallel joins its jobs when destroyed, so the instance must hold the last
+        // reference to its definition and source nodes, as a Tree holds the last reference to its root.
+        static Ptr compile(const NodePtr &root);
+
+        enum class Op : std::uint8_t { Sequence, Selector, Decorator, Repeat, Retry, Subtree, Action, Embedded };
+
+        struct Record {
+            Op op;
+            std::uint32_t end;  // one past the last record of this subtree
+            std::uint32_t slot; // actions_/decorators_ entry, instance cursor, or instance embedded node
+            std::int32_t limit; // repeat/retry maxTimes
+        };
+
+        TreeDefinition() = default;
+        void emit(const NodePtr &node, const std::unordered_set<const Node *> &shared);
+
+        std::vector<Record> program_;
+        std::vector<const Action::Func *> actions_;
+        std::vector<const Decorator::Func *> decorators_; // stateless only: shared by every instance
+        std::vector<NodePtr> lowered_;                    // owners of actions_ and decorators_
+        std::vector<NodePtr> prototypes_;
+        std::uint32_t cursorCount_ = 0; // composites, repeat and retry keep a cursor/counter per instance
+        std::function<void(Builder &)> describe_;
+        mutable std::atomic<bool> instantiated_{false}; // a compile()d definition with embedded nodes is in use
+    };
+
+    // ============================================================================
+    // TreeInstance - per-agent run state for a shared TreeDefinition
+    //
+    // Holds one byte of Idle/Running/Halted per record, a 4-byte running child or counter per composite and
+    // repeat/retry record, the instance's embedded nodes if the program has any, and a blackboard.
+    //
+    //   auto patrol = TreeDefinition::define([](Builder &b) { b.sequence() /* ... */ .end(); });
+    //   std::vector<std::unique_ptr<TreeInstance>> agents;
+    //   for (int i = 0; i < 10'000; ++i)
+    //       agents.push_back(std::make_unique<TreeInstance>(patrol, LockPolicy::None));
+    // ============================================================================
+    class TreeInstance {
+      public:
+        explicit TreeInstance(TreeDefinition::Ptr definition, LockPolicy lockPolicy = LockPolicy::Mutex);
+        TreeInstance(const TreeInstance &) = delete;
+        TreeInstance &operator=(const TreeInstance &) = delete;
+
+        Status tick();
+        // Tick with a TickBudget, like Tree::tick(deadline)
+        Status tick(std::chrono::steady_clock::time_point deadline);
+        void reset();
+        void halt();
+
+        Blackboard &blackboard() { return blackboard_; }
+        const Blackboard &blackboard() const { return blackboard_; }
+
+        void setLockPolicy(LockPolicy policy) { blackboard_.setLockPolicy(policy); }
+        LockPolicy lockPolicy() const { return blackboard_.lockPolicy(); }
+
+        const TreeDefinition::Ptr &definition() const { return definition_; }
+
+        // Seed that random selectors draw under (see TickRandom); fresh for every instance unless set
+        void setSeed(std::uint64_t seed) { seed_ = seed; }
+        std::uint64_t seed() const { return seed_; }
+
+        // Number of records in the program and how many of them fall back to an embedded node
+        size_t size() const { return definition_->size(); }
+        size_t embeddedCount() const { return definition_->embeddedCount(); }
+
+      private:
+        using Op = TreeDefinition::Op;
+        using Record = TreeDefinition::Record;
+
+        Status run(std::uint32_t index);
+        void resetAt(std::uint32_t index);
+        void haltAt(std::uint32_t index);
+
+        // Destroyed last: concurrent Parallel nodes, owned by owned_ or the definition, wait for their jobs on it
+        Blackboard blackboard_;
+        TreeDefinition::Ptr definition_;
+        const TreeDefinition *def_ = nullptr;
+        std::uint64_t seed_ = TickRandom::freshSeed();
+        std::vector<Node::State> states_;    // one per record
+        std::vector<std::uint32_t> cursors_; // running child record (composites) or counter (repeat/retry)
+        std::vector<NodePtr> owned_;         // this instance's copies of the embedded nodes (define())
+        std::vector<Node *> embedded_;       // owned_, or the definition's own nodes (compile())
+    };
+
+    // A single tree ticked through the flat program; Builder::buildCompiled() returns one
+    //
+    //   auto tree = Builder().sequence() /* ... */ .end().buildCompiled();
+    //   tree.tick();
+    class CompiledTree : public TreeInstance {
+      public:
+        explicit CompiledTree(const NodePtr &root, LockPolicy lockPolicy = LockPolicy::Mutex)
+            : TreeInstance(TreeDefinition::compile(root), lockPolicy) {}
+    };
+
+} // namespace stateup::tree
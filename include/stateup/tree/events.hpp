@@ -25,18 +25,22 @@ namespace stateup::tree {
         // Subscribe to an event
         SubscriptionId subscribe(const std::string &eventName, EventCallback callback) {
             SubscriptionId id = nextSubscriptionId_++;
-            subscriptions_[eventName].push_back({id, std::move(callback)});
+            auto &list = subscriptions_[eventName];
+            auto updated = list ? std::make_shared<SubscriptionList>(*list) : std::make_shared<SubscriptionList>();
+            updated->push_back({id, std::move(callback)});
+            list = std::move(updated);
             return id;
         }
 
         // Unsubscribe from an event
         void unsubscribe(const std::string &eventName, SubscriptionId id) {
             auto it = subscriptions_.find(eventName);
-            if (it != subscriptions_.end()) {
-                auto &callbacks = it->second;
-                callbacks.erase(std::remove_if(callbacks.begin(), callbacks.end(),
-                                               [id](const Subscription &sub) { return sub.id == id; }),
-                                callbacks.end());
+            if (it != subscriptions_.end() && it->second) {
+                auto updated = std::make_shared<SubscriptionList>(*it->second);
+                updated->erase(std::remove_if(updated->begin(), updated->end(),
+                                              [id](const Subscription &sub) { return sub.id == id; }),
+                               updated->end());
+                it->second = std::move(updated);
             }
         }
 
@@ -44,9 +48,10 @@ namespace stateup::tree {
         void publish(const std::string &eventName, const EventDataPtr &data = nullptr) {
             auto it = subscriptions_.find(eventName);
             if (it != subscriptions_.end()) {
-                // Copy the callback list to avoid issues if callbacks modify subscriptions
-                auto callbacks = it->second;
-                for (const auto &sub : callbacks) {
+                // Subscription lists are copy-on-write: holding a reference to the current one keeps it intact if
+                // callbacks modify subscriptions, without copying the callbacks on every publish
+                std::shared_ptr<const SubscriptionList> callbacks = it->second;
+                for (const auto &sub : *callbacks) {
                     sub.callback(data);
                 }
             }
@@ -64,7 +69,9 @@ namespace stateup::tree {
             EventCallback callback;
         };
 
-        std::unordered_map<std::string, std::vector<Subscription>> subscriptions_;
+        using SubscriptionList = std::vector<Subscription>;
+
+        std::unordered_map<std::string, std::shared_ptr<const SubscriptionList>> subscriptions_;
         SubscriptionId nextSubscriptionId_ = 0;
     };
 
@@ -0,0 +1,163 @@
+#pragma once
+#include "stateup/core/executor.hpp"
+#include "structure/status.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace stateup::tree {
+
+    // ============================================================================
+    // Forest - ticks many independent trees per frame
+    //
+    // Owns N trees (Tree, TreeInstance, CompiledTree, TypedTree...; anything with tick() and reset()) and ticks
+    // them in contiguous batches, one batch per thread pool task, so each worker walks a run of neighbouring trees
+    // and their status slots. Without a pool every batch runs on the calling thread.
+    //
+    // Each tree is ticked by one thread at a time and frames are separated by the pool's completion barrier, so
+    // trees whose blackboards use LockPolicy::None are safe as long as they share no state with each other. Do not
+    // give the forest's pool to Parallel nodes inside its trees: a worker would wait on tasks queued behind it.
+    //
+    //   Forest<TreeInstance> agents(&pool);
+    //   for (int i = 0; i < 10'000; ++i)
+    //       agents.emplace(definition, LockPolicy::None);
+    //   auto counts = agents.tickUnfinished();
+    // ============================================================================
+    template <typename TreeT> class Forest {
+      public:
+        static constexpr size_t kDefaultBatchSize = 256;
+
+        // Aggregate of the last status of every tree; `ticked` counts the trees ticked by this call
+        struct Counts {
+            size_t success = 0;
+            size_t failure = 0;
+            size_t running = 0;
+            size_t idle = 0; // never ticked, or reset since
+            size_t ticked = 0;
+
+            size_t finished() const { return success + failure; }
+        };
+
+        explicit Forest(stateup::core::ThreadPool *pool = nullptr, size_t batchSize = kDefaultBatchSize)
+            : pool_(pool), batchSize_(batchSize ? batchSize : 1) {}
+
+        Forest(const Forest &) = delete;
+        Forest &operator=(const Forest &) = delete;
+
+        TreeT &add(std::unique_ptr<TreeT> tree) {
+            if (!tree)
+                throw std::invalid_argument("Forest: cannot add a null tree");
+            trees_.push_back(std::move(tree));
+            statuses_.push_back(Status::Idle);
+            return *trees_.back();
+        }
+
+        template <typename... Args> TreeT &emplace(Args &&...args) {
+            return add(std::make_unique<TreeT>(std::forward<Args>(args)...));
+        }
+
+        void reserve(size_t count) {
+            trees_.reserve(count);
+            statuses_.reserve(count);
+        }
+
+        size_t size() const { return trees_.size(); }
+        bool empty() const { return trees_.empty(); }
+        TreeT &operator[](size_t index) { return *trees_[index]; }
+        const TreeT &operator[](size_t index) const { return *trees_[index]; }
+
+        // Status returned by the tree's last tick (Status::Idle before its first one)
+        Status status(size_t index) const { return statuses_[index]; }
+
+        void setExecutor(stateup::core::ThreadPool *pool) { pool_ = pool; }
+        void setBatchSize(size_t batchSize) { batchSize_ = batchSize ? batchSize : 1; }
+        size_t batchSize() const { return batchSize_; }
+
+        // Tick every tree once
+        Counts tick() { return tickWhere(false); }
+
+        // Tick only trees whose last status was Running or Idle; finished trees keep their result
+        Counts tickUnfinished() { return tickWhere(true); }
+
+        // Reset every tree and forget the last statuses
+        void reset() {
+            for (auto &tree : trees_) {
+                tree->reset();
+            }
+            std::fill(statuses_.begin(), statuses_.end(), Status::Idle);
+        }
+
+        Counts counts() const {
+            Counts total;
+            for (Status status : statuses_) {
+                tally(total, status);
+            }
+            return total;
+        }
+
+      private:
+        static void tally(Counts &counts, Status status) {
+            switch (status) {
+            case Status::Success:
+                ++counts.success;
+                break;
+            case Status::Failure:
+                ++counts.failure;
+                break;
+            case Status::Running:
+                ++counts.running;
+                break;
+            case Status::Idle:
+                ++counts.idle;
+                break;
+            }
+        }
+
+        Counts tickWhere(bool unfinishedOnly) {
+            const size_t batches = (trees_.size() + batchSize_ - 1) / batchSize_;
+            batchCounts_.assign(batches, Counts{});
+
+            // Counted on the stack and stored once: neighbouring batches' counts share cache lines
+            auto tickBatch = [&](size_t batch) {
+                Counts local;
+                const size_t end = std::min(trees_.size(), (batch + 1) * batchSize_);
+                for (size_t i = batch * batchSize_; i < end; ++i) {
+                    if (!unfinishedOnly || statuses_[i] == Status::Running || statuses_[i] == Status::Idle) {
+                        statuses_[i] = trees_[i]->tick();
+                        ++local.ticked;
+                    }
+                    tally(local, statuses_[i]);
+                }
+                batchCounts_[batch] = local;
+            };
+
+            if (pool_ && batches > 1) {
+                pool_->bulk(tickBatch, batches);
+            } else {
+                for (size_t batch = 0; batch < batches; ++batch) {
+                    tickBatch(batch);
+                }
+            }
+
+            Counts total;
+            for (const Counts &local : batchCounts_) {
+                total.success += local.success;
+                total.failure += local.failure;
+                total.running += local.running;
+                total.idle += local.idle;
+                total.ticked += local.ticked;
+            }
+            return total;
+        }
+
+        std::vector<std::unique_ptr<TreeT>> trees_;
+        std::vector<Status> statuses_;
+        std::vector<Counts> batchCounts_;
+        stateup::core::ThreadPool *pool_ = nullptr;
+        size_t batchSize_ = kDefaultBatchSize;
+    };
+
+} // namespace stateup::tree
@@ -0,0 +1,95 @@
+#pragma once
+#include "structure/blackboard.hpp"
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace stateup::tree {
+
+    // ============================================================================
+    // Memoized - a blackboard callback that re-runs only when its inputs change
+    //
+    // Wraps a condition, priority or utility function (anything called as f(Blackboard&)) and returns its previous
+    // result while every blackboard key it read still has the same revision. Keys are recorded from the get()/has()
+    // calls of the last evaluation, or fixed up front with the declared-keys overload. The callback must depend on
+    // nothing but those keys: no clocks, randomness or typed context.
+    //
+    //   reactive->addChild(patrol, memoize([](Blackboard &bb) { return bb.get<int>("threat").value_or(0) == 0; }));
+    //   utility->addChild(attack, memoize({"enemy.distance", "ammo"}, scoreAttack));
+    //
+    // Each copy keeps one cache and expects the tree that owns it to be ticked by one thread at a time; it
+    // re-evaluates whenever it is called with a different blackboard than last time.
+    // ============================================================================
+    template <typename F> class Memoized {
+      public:
+        using Result = std::invoke_result_t<F &, Blackboard &>;
+        static_assert(!std::is_void_v<Result>, "memoize() needs a callback that returns a value");
+
+        explicit Memoized(F func) : func_(std::move(func)), state_(std::make_unique<State>()) {}
+        Memoized(std::vector<std::string> keys, F func) : func_(std::move(func)), state_(std::make_unique<State>()) {
+            state_->declared = std::move(keys);
+            state_->useDeclared = true;
+        }
+        Memoized(const Memoized &other) : func_(other.func_), state_(std::make_unique<State>(*other.state_)) {}
+        Memoized(Memoized &&) noexcept = default;
+        Memoized &operator=(const Memoized &other) {
+            if (this != &other) {
+                func_ = other.func_;
+                state_ = std::make_unique<State>(*other.state_);
+            }
+            return *this;
+        }
+        Memoized &operator=(Memoized &&) noexcept = default;
+
+        Result operator()(Blackboard &blackboard) const {
+            State &s = *state_;
+            if (s.cached && blackboard.unchanged(s.reads)) {
+                blackboard.reportReads(s.reads);
+                return *s.cached;
+            }
+            s.cached.reset();
+            if (s.useDeclared) {
+                // Revisions are taken before the call so a callback that writes its own inputs re-runs next time
+                s.reads.clear();
+                s.reads.source = &blackboard;
+                s.reads.structureRevision = blackboard.structureRevision();
+                s.reads.checkedRevision = blackboard.revision();
+                for (const auto &key : s.declared) {
+                    s.reads.keys.emplace_back(key, blackboard.keyRevision(key));
+                }
+                s.cached = func_(blackboard);
+            } else {
+                auto recording = blackboard.recordReads(s.reads);
+                s.cached = func_(blackboard);
+            }
+            return *s.cached;
+        }
+
+        // Forget the cached result; the next call evaluates the callback
+        void invalidate() const { state_->cached.reset(); }
+
+      private:
+        // Kept out of line so a Memoized fits in the inplace storage of node callbacks
+        struct State {
+            std::vector<std::string> declared;
+            bool useDeclared = false;
+            std::optional<Result> cached;
+            Blackboard::ReadSet reads;
+        };
+
+        F func_;
+        std::unique_ptr<State> state_;
+    };
+
+    template <typename F> Memoized<std::decay_t<F>> memoize(F &&func) {
+        return Memoized<std::decay_t<F>>(std::forward<F>(func));
+    }
+
+    template <typename F> Memoized<std::decay_t<F>> memoize(std::vector<std::string> keys, F &&func) {
+        return Memoized<std::decay_t<F>>(std::move(keys), std::forward<F>(func));
+    }
+
+} // namespace stateup::tree
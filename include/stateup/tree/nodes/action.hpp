@@ -1,17 +1,21 @@
 #pragma once
 #include "../structure/node.hpp"
+#include "../structure/wakeup.hpp"
+#include "stateup/core/inplace_function.hpp"
 #include "stateup/core/task.hpp"
-#include <functional>
 #include <future>
 #include <optional>
 
 namespace stateup::tree {
 
+    // Running actions tell the tree's Wakeup when they can progress: coroutines parked on sleepFor()/sleepUntil()
+    // or a Signal are not resumed until it is due, futures are polled at the wakeup's interval, and plain
+    // functions that return Running ask to be polled again.
     class Action : public Node {
       public:
-        using Func = std::function<Status(Blackboard &)>;
-        using AsyncFunc = std::function<std::future<Status>(Blackboard &)>;
-        using TaskFunc = std::function<stateup::core::task<Status>(Blackboard &)>;
+        using Func = core::InplaceFunction<Status(Blackboard &)>;
+        using AsyncFunc = core::InplaceFunction<std::future<Status>(Blackboard &)>;
+        using TaskFunc = core::InplaceFunction<core::task<Status>(Blackboard &)>;
 
         explicit Action(Func func);
         explicit Action(AsyncFunc asyncFunc);
@@ -21,12 +25,19 @@ namespace stateup::tree {
         void reset() override;
         void halt() override;
 
+        // Plain Func actions (no future or coroutine) can be lowered by CompiledTree
+        bool isSynchronous() const { return !taskFunc_ && !async_; }
+        const Func &getFunc() const { return func_; }
+
       private:
+        void scheduleWakeup(const std::shared_ptr<Wakeup> &wakeup) const;
+
         Func func_;
         AsyncFunc async_;
         TaskFunc taskFunc_;
         std::future<Status> pending_;
         std::optional<stateup::core::task<Status>> task_;
+        Park park_;
     };
 
 } // namespace stateup::tree
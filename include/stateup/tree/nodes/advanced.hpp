@@ -1,6 +1,11 @@
 #pragma once
+#include "../structure/active_children.hpp"
 #include "../structure/node.hpp"
+#include "../structure/tick_clock.hpp"
+#include "../structure/tick_random.hpp"
+#include "stateup/core/alias_table.hpp"
 #include <chrono>
+#include <optional>
 #include <random>
 #include <unordered_set>
 #include <vector>
@@ -17,14 +22,23 @@ namespace stateup::tree {
         void reset() override;
         void halt() override;
 
+        // Stream this node draws from under its tree's seed (see TickRandom)
+        void setRandomStream(std::uint64_t stream) { rng_.setStream(stream); }
+        std::uint64_t randomStream() const { return rng_.stream(); }
+
       private:
         std::vector<NodePtr> children_;
+        ActiveChildren active_;
         size_t currentIndex_ = SIZE_MAX;
-        static thread_local std::mt19937 rng_;
+        core::RandomStream rng_{TickRandom::nextStream()};
     };
 
     // ============================================================================
     // ProbabilitySelector - Each child has fixed probability of being selected
+    //
+    // A roll in [0, 1] picks the first child whose probability is at least the roll, and the last child when
+    // none is. The chances that follow from that are put into an alias table when children change, so a pick
+    // costs the same for two children as for hundreds.
     // ============================================================================
     class ProbabilitySelector : public Node {
       public:
@@ -38,10 +52,19 @@ namespace stateup::tree {
         void reset() override;
         void halt() override;
 
+        // Stream this node draws from under its tree's seed (see TickRandom)
+        void setRandomStream(std::uint64_t stream) { rng_.setStream(stream); }
+        std::uint64_t randomStream() const { return rng_.stream(); }
+
       private:
+        void buildSampler();
+
         std::vector<ProbabilityChild> children_;
+        ActiveChildren active_;
         size_t currentIndex_ = SIZE_MAX;
-        static thread_local std::mt19937 rng_;
+        core::AliasTable sampler_;
+        bool samplerStale_ = true;
+        core::RandomStream rng_{TickRandom::nextStream()};
     };
 
     // ============================================================================
@@ -59,6 +82,7 @@ namespace stateup::tree {
 
       private:
         std::vector<NodePtr> children_;
+        ActiveChildren active_;
         std::unordered_set<size_t> executedChildren_; // Track which children have run
         size_t currentIndex_ = 0;
     };
@@ -88,4 +112,41 @@ namespace stateup::tree {
         bool isStable_ = false;
     };
 
+    // ============================================================================
+    // ThrottleNode - Ticks its child at most once per period (a rate group)
+    //
+    // In between, it returns the child's last status without ticking it, so a 10 Hz planning branch under a
+    // 1 kHz tree costs one comparison on the other 99 ticks. Due times advance by whole periods from the first
+    // tick, so a host ticking on schedule keeps the branch phase-locked; a host that falls behind skips the missed
+    // periods instead of catching up in a burst. Each tick hands the tree's Wakeup the next due time, and time
+    // comes from TickTime, so the branch follows the tree's clock.
+    // ============================================================================
+    class ThrottleNode : public Node {
+      public:
+        using Clock = TickTime::Clock;
+        using Duration = std::chrono::nanoseconds;
+
+        ThrottleNode(NodePtr child, Duration period);
+
+        Status tick(Blackboard &blackboard) override;
+        void reset() override;
+        void halt() override;
+
+        // Force the next tick to run the child and start a new period grid
+        void invalidate() {
+            cached_.reset();
+            nextDue_.reset();
+        }
+        Duration getPeriod() const { return period_; }
+        NodePtr getChild() const { return child_; }
+        // When the child is next ticked; nullopt before the first tick
+        std::optional<Clock::time_point> nextDue() const { return nextDue_; }
+
+      private:
+        NodePtr child_;
+        Duration period_;
+        std::optional<Clock::time_point> nextDue_;
+        std::optional<Status> cached_;
+    };
+
 } // namespace stateup::tree
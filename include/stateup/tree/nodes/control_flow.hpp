@@ -1,8 +1,14 @@
 #pragma once
+#include "../structure/active_children.hpp"
 #include "../structure/node.hpp"
-#include <functional>
+#include "stateup/core/inplace_function.hpp"
+#include "stateup/core/int_dispatch.hpp"
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace stateup::tree {
@@ -10,7 +16,7 @@ namespace stateup::tree {
     // Conditional/If node - executes different branches based on condition
     class ConditionalNode : public Node {
       public:
-        using ConditionFunc = std::function<bool(Blackboard &)>;
+        using ConditionFunc = core::InplaceFunction<bool(Blackboard &)>;
 
         ConditionalNode(ConditionFunc condition, NodePtr thenNode, NodePtr elseNode = nullptr);
 
@@ -28,7 +34,7 @@ namespace stateup::tree {
     // While/Loop node - repeats child while condition is true
     class WhileNode : public Node {
       public:
-        using ConditionFunc = std::function<bool(Blackboard &)>;
+        using ConditionFunc = core::InplaceFunction<bool(Blackboard &)>;
 
         // maxIterations: -1 for infinite, > 0 for limited iterations per tick
         WhileNode(ConditionFunc condition, NodePtr child, int maxIterations = -1);
@@ -48,7 +54,7 @@ namespace stateup::tree {
     // Switch/Case node - selects child based on key value
     class SwitchNode : public Node {
       public:
-        using SelectorFunc = std::function<std::string(Blackboard &)>;
+        using SelectorFunc = core::InplaceFunction<std::string(Blackboard &)>;
 
         SwitchNode(SelectorFunc selector);
 
@@ -70,6 +76,63 @@ namespace stateup::tree {
         std::string lastCase_;
     };
 
+    // Switch on an integer key. Cases are compiled into a core::IntDispatch on the first tick after they change:
+    // a table indexed by key for a short range of keys, a perfect hash for sparse ones. Selecting a case never
+    // touches the heap, so it suits mode switches ticked at high rates. Children are held in addCase() order.
+    class IntSwitchNode : public Node {
+      public:
+        using SelectorFunc = core::InplaceFunction<std::int64_t(Blackboard &)>;
+
+        explicit IntSwitchNode(SelectorFunc selector);
+
+        // Add a case branch; adding a key again replaces its branch, halting it first if it is running
+        void addCase(std::int64_t caseValue, NodePtr node);
+
+        // Set default case (when no case matches)
+        void setDefault(NodePtr node);
+
+        Status tick(Blackboard &blackboard) override;
+        void reset() override;
+        void halt() override;
+
+        const core::IntDispatch &dispatch() const { return dispatch_; }
+
+      protected:
+        IntSwitchNode() = default;
+        virtual std::int64_t select(Blackboard &blackboard) { return selector_(blackboard); }
+
+      private:
+        void dropIfActive(const NodePtr &replaced);
+
+        SelectorFunc selector_;
+        std::vector<std::pair<std::int64_t, std::uint32_t>> keys_;
+        std::vector<NodePtr> cases_;
+        core::IntDispatch dispatch_;
+        bool dispatchStale_ = true;
+        NodePtr defaultNode_;
+        Node *activeChild_ = nullptr;
+    };
+
+    // IntSwitchNode keyed by an enum, e.g. a mode: `EnumSwitchNode<Mode>([](Blackboard &bb) { ... })`
+    template <typename Enum> class EnumSwitchNode : public IntSwitchNode {
+        static_assert(std::is_enum_v<Enum>, "EnumSwitchNode needs an enum type");
+
+      public:
+        using SelectorFunc = core::InplaceFunction<Enum(Blackboard &)>;
+
+        explicit EnumSwitchNode(SelectorFunc selector) : selector_(std::move(selector)) {}
+
+        void addCase(Enum caseValue, NodePtr node) { IntSwitchNode::addCase(toKey(caseValue), std::move(node)); }
+
+        static std::int64_t toKey(Enum value) { return static_cast<std::int64_t>(value); }
+
+      protected:
+        std::int64_t select(Blackboard &blackboard) override { return toKey(selector_(blackboard)); }
+
+      private:
+        SelectorFunc selector_;
+    };
+
     // Memory node - remembers and returns the last status of its child
     class MemoryNode : public Node {
       public:
@@ -96,10 +159,34 @@ namespace stateup::tree {
         bool shouldRemember(Status status) const;
     };
 
+    // Cached node - reuses the child's last finished status while the blackboard keys it read are unchanged.
+    // Reads are recorded on the ticking thread, so the child must decide its result from get()/has() alone (no
+    // clocks, randomness, typed context or pooled Parallel nodes; a SequenceGroup or speculative Selector hands
+    // over what its pooled children read). A Running child is ticked every time; halt() drops the cached status.
+    class CachedNode : public Node {
+      public:
+        explicit CachedNode(NodePtr child);
+
+        Status tick(Blackboard &blackboard) override;
+        void reset() override;
+        void halt() override;
+
+        // Force the next tick to run the child; reset() keeps the cached status
+        void invalidate() { cachedStatus_.reset(); }
+        bool hasCachedStatus() const { return cachedStatus_.has_value(); }
+        const Blackboard::ReadSet &reads() const { return reads_; }
+        NodePtr getChild() const { return child_; }
+
+      private:
+        NodePtr child_;
+        std::optional<Status> cachedStatus_;
+        Blackboard::ReadSet reads_;
+    };
+
     // For loop node - executes child a fixed number of times
     class ForNode : public Node {
       public:
-        using CountFunc = std::function<int(Blackboard &)>;
+        using CountFunc = core::InplaceFunction<int(Blackboard &)>;
 
         // Can use static count or dynamic count from blackboard
         ForNode(NodePtr child, int count);
@@ -120,7 +207,7 @@ namespace stateup::tree {
     // Conditional Sequence - short-circuits on first false condition
     class ConditionalSequence : public Node {
       public:
-        using ConditionFunc = std::function<bool(Blackboard &)>;
+        using ConditionFunc = core::InplaceFunction<bool(Blackboard &)>;
 
         void addChild(NodePtr child, ConditionFunc precondition = nullptr);
         Status tick(Blackboard &blackboard) override;
@@ -133,13 +220,14 @@ namespace stateup::tree {
             ConditionFunc precondition;
         };
         std::vector<ConditionalChild> children_;
+        ActiveChildren active_;
         size_t currentIndex_ = 0;
     };
 
     // Reactive Sequence - re-checks earlier conditions during execution
     class ReactiveSequence : public Node {
       public:
-        using ConditionFunc = std::function<bool(Blackboard &)>;
+        using ConditionFunc = core::InplaceFunction<bool(Blackboard &)>;
 
         void addChild(NodePtr child, ConditionFunc condition = nullptr);
         Status tick(Blackboard &blackboard) override;
@@ -152,13 +240,14 @@ namespace stateup::tree {
             ConditionFunc condition;
         };
         std::vector<ReactiveChild> children_;
+        ActiveChildren active_;
         size_t currentIndex_ = 0;
     };
 
     // Dynamic Selector - re-evaluates priorities during execution
     class DynamicSelector : public Node {
       public:
-        using PriorityFunc = std::function<float(Blackboard &)>;
+        using PriorityFunc = core::InplaceFunction<float(Blackboard &)>;
 
         void addChild(NodePtr child, PriorityFunc priorityFunc);
         Status tick(Blackboard &blackboard) override;
@@ -171,6 +260,7 @@ namespace stateup::tree {
             PriorityFunc priorityFunc;
         };
         std::vector<PriorityChild> children_;
+        ActiveChildren active_;
         size_t currentIndex_ = SIZE_MAX;
     };
 
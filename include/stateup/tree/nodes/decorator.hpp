@@ -1,16 +1,20 @@
 #pragma once
 #include "../structure/node.hpp"
+#include "../structure/tick_clock.hpp"
+#include "stateup/core/inplace_function.hpp"
 #include <chrono>
-#include <functional>
 #include <memory>
+#include <optional>
 
 namespace stateup::tree {
 
     class Decorator : public Node {
       public:
-        using Func = std::function<Status(Status)>;
+        using Func = core::InplaceFunction<Status(Status)>;
 
-        Decorator(Func func, NodePtr child);
+        // `stateless`: func keeps nothing between calls (Inverter, Succeeder, Failer), so a TreeDefinition may lower
+        // it and share it between instances; others are embedded per instance
+        Decorator(Func func, NodePtr child, bool stateless = false);
         virtual ~Decorator() = default;
 
         Status tick(Blackboard &blackboard) override;
@@ -20,15 +24,20 @@ namespace stateup::tree {
         // FIX: Add child introspection
         NodePtr getChild() const { return child_; }
         void setChild(NodePtr newChild) { child_ = std::move(newChild); }
+        const Func &getFunc() const { return func_; }
+        bool isStateless() const { return stateless_; }
 
       protected: // Changed from private to allow derived class access
         Func func_;
         NodePtr child_;
+        bool stateless_ = false;
     };
 
-    // Common decorator factories - kept inline because they create lambdas with captured state
+    // Common decorator factories - kept inline because they create lambdas with captured state. Decorator::Func is
+    // move-only, so each Decorator node owns its own counters and timers. Only Inverter, Succeeder and Failer are
+    // stateless; a TreeDefinition embeds the others per instance instead of sharing one node between instances.
     namespace decorators {
-        inline std::function<Status(Status)> Inverter() {
+        inline Decorator::Func Inverter() {
             return [](Status status) {
                 if (status == Status::Success)
                     return Status::Failure;
@@ -38,23 +47,23 @@ namespace stateup::tree {
             };
         }
 
-        inline std::function<Status(Status)> Succeeder() {
+        inline Decorator::Func Succeeder() {
             return [](Status status) { return (status != Status::Running) ? Status::Success : Status::Running; };
         }
 
-        inline std::function<Status(Status)> Failer() {
+        inline Decorator::Func Failer() {
             return [](Status status) { return (status != Status::Running) ? Status::Failure : Status::Running; };
         }
 
-        inline std::function<Status(Status)> Repeat(int maxTimes = -1) {
+        inline Decorator::Func Repeat(int maxTimes = -1) {
             // FIX: Use class to avoid shared_ptr memory leak
             class RepeatState {
-                mutable int attempts_ = 0;
+                int attempts_ = 0;
                 int maxTimes_;
 
               public:
                 explicit RepeatState(int max) : maxTimes_(max) {}
-                Status operator()(Status status) const {
+                Status operator()(Status status) {
                     if (status == Status::Running) {
                         return Status::Running;
                     }
@@ -80,15 +89,15 @@ namespace stateup::tree {
             return RepeatState(maxTimes);
         }
 
-        inline std::function<Status(Status)> Retry(int maxTimes = -1) {
+        inline Decorator::Func Retry(int maxTimes = -1) {
             // FIX: Use class to avoid shared_ptr memory leak
             class RetryState {
-                mutable int attempts_ = 0;
+                int attempts_ = 0;
                 int maxTimes_;
 
               public:
                 explicit RetryState(int max) : maxTimes_(max) {}
-                Status operator()(Status status) const {
+                Status operator()(Status status) {
                     if (status == Status::Running) {
                         return Status::Running;
                     }
@@ -114,31 +123,31 @@ namespace stateup::tree {
             return RetryState(maxTimes);
         }
 
-        inline std::function<Status(Status)> Timeout(float seconds) {
+        inline Decorator::Func Timeout(float seconds) {
             // FIX: Use class to avoid shared_ptr memory leak
             class TimeoutState {
-                mutable std::chrono::steady_clock::time_point startTime_;
+                std::optional<TickTime::Clock::time_point> startTime_;
                 float seconds_;
 
               public:
                 explicit TimeoutState(float secs) : seconds_(secs) {}
-                Status operator()(Status status) const {
-                    auto now = std::chrono::steady_clock::now();
+                Status operator()(Status status) {
+                    auto now = TickTime::now();
 
-                    if (startTime_ == std::chrono::steady_clock::time_point{}) {
+                    if (!startTime_) {
                         startTime_ = now; // Initialize start time
                     }
 
                     auto elapsed =
-                        std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime_).count() / 1000.0f;
+                        std::chrono::duration_cast<std::chrono::milliseconds>(now - *startTime_).count() / 1000.0f;
 
                     if (elapsed >= seconds_) {
-                        startTime_ = {};        // Reset for next use
+                        startTime_.reset();     // Reset for next use
                         return Status::Failure; // Timeout reached
                     }
 
                     if (status != Status::Running) {
-                        startTime_ = {}; // Reset on completion
+                        startTime_.reset(); // Reset on completion
                     }
 
                     return status;
@@ -147,25 +156,25 @@ namespace stateup::tree {
             return TimeoutState(seconds);
         }
 
-        inline std::function<Status(Status)> Cooldown(float seconds) {
+        inline Decorator::Func Cooldown(float seconds) {
             // FIX: Use class to avoid shared_ptr memory leak
             class CooldownState {
-                mutable std::chrono::steady_clock::time_point lastSuccess_;
+                std::optional<TickTime::Clock::time_point> lastSuccess_;
                 float seconds_;
 
               public:
                 explicit CooldownState(float secs) : seconds_(secs) {}
-                Status operator()(Status status) const {
-                    auto now = std::chrono::steady_clock::now();
+                Status operator()(Status status) {
+                    auto now = TickTime::now();
 
                     if (status == Status::Success) {
                         lastSuccess_ = now;
                         return Status::Success;
                     }
 
-                    if (lastSuccess_ != std::chrono::steady_clock::time_point{}) {
-                        auto elapsed =
-                            std::chrono::duration_cast<std::chrono::milliseconds>(now - lastSuccess_).count() / 1000.0f;
+                    if (lastSuccess_) {
+                        const auto since = now - *lastSuccess_;
+                        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(since).count() / 1000.0f;
                         if (elapsed < seconds_) {
                             return Status::Failure; // Still in cooldown
                         }
@@ -187,6 +196,9 @@ namespace stateup::tree {
         void reset() override;
         void halt() override;
 
+        int getMaxTimes() const { return maxTimes_; }
+        NodePtr getChild() const { return child_; }
+
       private:
         int maxTimes_;
         NodePtr child_;
@@ -202,6 +214,9 @@ namespace stateup::tree {
         void reset() override;
         void halt() override;
 
+        int getMaxTimes() const { return maxTimes_; }
+        NodePtr getChild() const { return child_; }
+
       private:
         int maxTimes_;
         NodePtr child_;
@@ -1,5 +1,11 @@
 #pragma once
 #include "../structure/node.hpp"
+#include "stateup/core/cost_estimate.hpp"
+#include <chrono>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <vector>
 
@@ -11,12 +17,25 @@ namespace stateup {
 
 namespace stateup::tree {
 
+    // True while a child of a concurrent Parallel is being ticked after its run was decided (policy satisfied,
+    // halt() or reset()); long-running actions can poll it and return early
+    bool cancellationRequested();
+
     class Parallel : public Node {
       public:
         enum class Policy { RequireAll, RequireOne };
 
+        // Blocking:   each tick runs every unresolved child once and waits for all of them (default)
+        // Concurrent: each child tick is a background job on the executor; the tree tick only harvests finished
+        //             jobs, relaunches children that returned Running, and returns Running without waiting.
+        //             Children still in flight when the policy is decided are asked to stop (see
+        //             cancellationRequested()) and halted once they return. Needs a locked blackboard; with
+        //             LockPolicy::None it ticks like Blocking.
+        enum class Mode { Blocking, Concurrent };
+
         Parallel(Policy successPolicy, Policy failurePolicy);
         Parallel(size_t successThreshold, std::optional<size_t> failureThreshold = std::nullopt);
+        ~Parallel() override; // waits for in-flight concurrent jobs
 
         void addChild(const NodePtr &child);
         Status tick(Blackboard &blackboard) override;
@@ -26,14 +45,46 @@ namespace stateup::tree {
         // Optional: pluggable executor
         void setExecutor(stateup::core::ThreadPool *pool) { executor_ = pool; }
 
+        void setMode(Mode mode) { mode_ = mode; }
+        Mode mode() const { return mode_; }
+
+        // Blocking mode: children estimated to tick faster than this run inline instead of on the executor
+        void setPoolThreshold(std::chrono::nanoseconds threshold) { poolThreshold_ = threshold; }
+        std::chrono::nanoseconds poolThreshold() const { return poolThreshold_; }
+        const stateup::core::CostEstimate &childCost(size_t index) const { return costs_[index]; }
+
+        // Number of concurrent child jobs still running, including cancelled ones
+        size_t jobsInFlight() const;
+
       private:
+        // Background state of one child in Concurrent mode
+        struct Job {
+            std::atomic<bool> busy{false};
+            std::atomic<bool> cancel{false};
+            Status result = Status::Idle; // published by busy.store(false)
+            bool unharvested = false;     // launched and not yet collected by tick()
+            bool stale = false;           // belongs to a decided run; halt the child instead of using the result
+        };
+
         std::vector<NodePtr> children_;
         std::vector<Status> childStates_;
         Policy successPolicy_, failurePolicy_;
         std::optional<size_t> successThreshold_;
         std::optional<size_t> failureThreshold_;
         stateup::core::ThreadPool *executor_ = nullptr;
+        Mode mode_ = Mode::Blocking;
+        std::chrono::nanoseconds poolThreshold_ = stateup::core::kDefaultPoolThreshold;
+        std::vector<stateup::core::CostEstimate> costs_; // per child tick time
+        std::vector<size_t> pooled_;                     // children sent to the executor this tick
+
+        std::vector<std::unique_ptr<Job>> jobs_;
+        mutable std::mutex jobsMutex_;
+        std::condition_variable jobsIdle_;
+        size_t jobsInFlight_ = 0;
 
+        Status tickConcurrent(Blackboard &blackboard);
+        void launch(size_t index, Blackboard &blackboard);
+        void cancelJobs();
         void haltRunningChildren();
         bool successSatisfied(size_t successCount) const;
         bool failureSatisfied(size_t failureCount) const;
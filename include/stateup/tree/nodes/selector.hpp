@@ -1,19 +1,64 @@
 #pragma once
 #include "../structure/node.hpp"
+#include "stateup/core/cost_estimate.hpp"
+#include <chrono>
 #include <vector>
 
+namespace stateup {
+    namespace core {
+        class ThreadPool;
+    }
+} // namespace stateup
+
 namespace stateup::tree {
 
+    // ============================================================================
+    // Selector - ticks children in order until one succeeds or keeps running
+    //
+    // In speculative mode (Builder::speculativeSelector()) a run of consecutive children marked pure (see
+    // Builder::pure()) ticks concurrently on the executor once at least two of them are expensive, so a deep
+    // fallback chain costs its slowest child instead of the sum of all of them. The first child in order that
+    // does not fail still decides: the ones after it are halted and reset, their results thrown away. Pure
+    // children must not write anything, to the blackboard or elsewhere. A child that was already running when the
+    // tick started, and every child on a LockPolicy::None blackboard, ticks alone as in the plain mode. Reads made
+    // on the executor are handed to an enclosing CachedNode's recording, as in SequenceGroup.
+    // ============================================================================
     class Selector : public Node {
       public:
-        void addChild(const NodePtr &child);
+        void addChild(const NodePtr &child, bool pure = false);
         Status tick(Blackboard &blackboard) override;
         void reset() override;
         void halt() override;
 
+        const std::vector<NodePtr> &getChildren() const { return children_; }
+        bool isPure(size_t index) const { return pure_[index]; }
+
+        void setSpeculative(bool speculative) { speculative_ = speculative; }
+        bool speculative() const { return speculative_; }
+        void setExecutor(stateup::core::ThreadPool *pool) { executor_ = pool; }
+        // Children estimated to tick faster than this do not count towards speculating
+        void setPoolThreshold(std::chrono::nanoseconds threshold) { poolThreshold_ = threshold; }
+        std::chrono::nanoseconds poolThreshold() const { return poolThreshold_; }
+        // Ticks that evaluated fallbacks speculatively
+        size_t speculativeTicks() const { return speculativeTicks_; }
+
       private:
+        Status tickChild(size_t index, Blackboard &blackboard);
+        // Ticks the pure run [currentIndex_, end); false when every child in it failed
+        bool tickSpeculatively(Blackboard &blackboard, size_t end, Status &result);
+
         std::vector<NodePtr> children_;
+        std::vector<bool> pure_;
         size_t currentIndex_ = 0;
+
+        bool speculative_ = false;
+        std::vector<stateup::core::CostEstimate> costs_;
+        std::vector<Status> statuses_;           // per child, this tick
+        std::vector<size_t> pooled_;             // children sent to the executor this tick
+        std::vector<Blackboard::ReadSet> reads_; // per child, what it read on a worker while reads were recorded
+        size_t speculativeTicks_ = 0;
+        stateup::core::ThreadPool *executor_ = nullptr;
+        std::chrono::nanoseconds poolThreshold_ = stateup::core::kDefaultPoolThreshold;
     };
 
 } // namespace stateup::tree
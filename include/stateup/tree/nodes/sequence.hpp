@@ -1,7 +1,17 @@
 #pragma once
+#include "../structure/active_children.hpp"
 #include "../structure/node.hpp"
+#include "stateup/core/cost_estimate.hpp"
+#include <chrono>
+#include <string>
 #include <vector>
 
+namespace stateup {
+    namespace core {
+        class ThreadPool;
+    }
+} // namespace stateup
+
 namespace stateup::tree {
 
     class Sequence : public Node {
@@ -11,9 +21,73 @@ namespace stateup::tree {
         void reset() override;
         void halt() override;
 
+        const std::vector<NodePtr> &getChildren() const { return children_; }
+        // Replace all children, e.g. after grouping them (see SequenceGroup); only before the first tick
+        void setChildren(std::vector<NodePtr> children) { children_ = std::move(children); }
+
       private:
         std::vector<NodePtr> children_;
         size_t currentIndex_ = 0;
     };
 
+    // Blackboard keys a node declares it reads and writes; attached with Builder::access()
+    struct KeyAccess {
+        std::vector<std::string> reads;
+        std::vector<std::string> writes;
+
+        // Neither side writes a key the other reads or writes, so the two can run in either order or at once
+        bool independentOf(const KeyAccess &other) const;
+    };
+
+    // ============================================================================
+    // SequenceGroup - consecutive Sequence children with disjoint declared keys, ticked at once
+    //
+    // Builder::build() puts each run of independent siblings (see Builder::access()) into one of these. It
+    // behaves like a Sequence over the same children: the first child that fails or keeps running decides the
+    // result, and the children after it leave no trace. When at least two of the remaining children are
+    // expensive (measured as in Parallel), all of them tick concurrently on the executor; afterwards the declared
+    // keys of children past the deciding one are restored from a checkpoint and those children are reset.
+    // Otherwise, and on a LockPolicy::None blackboard, the children tick in order on the calling thread, as does a
+    // child resumed while running. Reads made on the executor are recorded there and reported to an enclosing
+    // CachedNode's recording, so caching a group sees every key its children read.
+    // Children must touch nothing but their declared keys: effects outside the blackboard are not rolled back.
+    // ============================================================================
+    class SequenceGroup : public Node {
+      public:
+        SequenceGroup(std::vector<NodePtr> children, std::vector<KeyAccess> access);
+
+        Status tick(Blackboard &blackboard) override;
+        void reset() override;
+        void halt() override;
+
+        void setExecutor(stateup::core::ThreadPool *pool) { executor_ = pool; }
+        // Children estimated to tick faster than this do not count towards going concurrent
+        void setPoolThreshold(std::chrono::nanoseconds threshold) { poolThreshold_ = threshold; }
+        std::chrono::nanoseconds poolThreshold() const { return poolThreshold_; }
+
+        const std::vector<NodePtr> &getChildren() const { return children_; }
+        const std::vector<KeyAccess> &getAccess() const { return access_; }
+        // Ticks that ran the children concurrently
+        size_t concurrentTicks() const { return concurrentTicks_; }
+
+      private:
+        Status tickInOrder(Blackboard &blackboard);
+        Status tickConcurrently(Blackboard &blackboard);
+        Status finish(Status status);
+
+        std::vector<NodePtr> children_;
+        std::vector<KeyAccess> access_;
+        std::vector<stateup::core::CostEstimate> costs_;
+        std::vector<Status> statuses_;              // per child, this tick
+        std::vector<size_t> pooled_;                // children sent to the executor this tick
+        std::vector<Blackboard::SavedEntry> saved_; // checkpoint of the speculative children's writes
+        std::vector<size_t> savedOwner_;            // child whose declared write each saved entry is
+        std::vector<Blackboard::ReadSet> reads_;    // per child, what it read on a worker while reads were recorded
+        ActiveChildren active_;
+        size_t currentIndex_ = 0;
+        size_t concurrentTicks_ = 0;
+        stateup::core::ThreadPool *executor_ = nullptr;
+        std::chrono::nanoseconds poolThreshold_ = stateup::core::kDefaultPoolThreshold;
+    };
+
 } // namespace stateup::tree
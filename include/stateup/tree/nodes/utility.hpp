@@ -1,53 +1,102 @@
 #pragma once
+#include "../structure/active_children.hpp"
 #include "../structure/node.hpp"
+#include "../structure/tick_random.hpp"
+#include "../utility_curves.hpp"
+#include "stateup/core/alias_table.hpp"
+#include "stateup/core/inplace_function.hpp"
 #include <algorithm>
-#include <functional>
 #include <vector>
 
 namespace stateup::tree {
 
-    // Utility node that selects child based on utility scores
-    class UtilitySelector : public Node {
+    // Scores of a utility node's children. A child is scored by a callback, called every tick, or by
+    // considerations, which all go into one UtilityModel: they are scored together and only re-scored once one
+    // of their blackboard inputs changed.
+    class UtilityScores {
       public:
-        using UtilityFunc = std::function<float(Blackboard &)>;
+        using UtilityFunc = core::InplaceFunction<float(Blackboard &)>;
+
+        void add(UtilityFunc func);
+        void add(const std::vector<Consideration> &considerations);
+
+        // One score per child, in the order they were added; valid until the next call
+        const std::vector<float> &evaluate(Blackboard &blackboard);
 
-        struct UtilityChild {
-            NodePtr node;
-            UtilityFunc utilityFunc;
+        const UtilityModel &model() const { return model_; }
+        // Times the considerations were scored, as opposed to reused
+        size_t modelEvaluations() const { return modelEvaluations_; }
 
-            UtilityChild(NodePtr n, UtilityFunc f);
-        };
+      private:
+        std::vector<UtilityFunc> funcs_; // empty for children scored by the model
+        std::vector<size_t> option_;     // model option per child
+        UtilityModel model_;
+        std::vector<float> inputs_;
+        std::vector<float> modelScores_;
+        std::vector<float> scores_;
+        Blackboard::ReadSet reads_;
+        bool modelCached_ = false;
+        size_t modelEvaluations_ = 0;
+    };
+
+    // Utility node that selects child based on utility scores
+    class UtilitySelector : public Node {
+      public:
+        using UtilityFunc = UtilityScores::UtilityFunc;
 
         void addChild(NodePtr child, UtilityFunc utilityFunc);
+        // Score the child as the product of its considerations (see UtilityModel)
+        void addChild(NodePtr child, const std::vector<Consideration> &considerations);
         Status tick(Blackboard &blackboard) override;
         void reset() override;
         void halt() override;
 
+        // Keep the last chosen child until another one scores more than `margin` above it. The last choice
+        // survives reset(), so a selector that finishes and starts over does not flip between close scores.
+        void setHysteresis(float margin) { hysteresis_ = margin; }
+        float hysteresis() const { return hysteresis_; }
+
+        const std::vector<NodePtr> &getChildren() const { return children_; }
+        const UtilityScores &scores() const { return scores_; }
+
       private:
-        std::vector<UtilityChild> children_;
+        std::vector<NodePtr> children_;
+        UtilityScores scores_;
+        ActiveChildren active_;
         size_t currentIndex_ = SIZE_MAX;
+        size_t lastChoice_ = SIZE_MAX;
+        float hysteresis_ = 0.0f;
     };
 
-    // Weighted random selector based on utility scores
+    // Weighted random selector based on utility scores; picks in O(1) from an alias table
     class WeightedRandomSelector : public Node {
       public:
-        using UtilityFunc = std::function<float(Blackboard &)>;
-
-        struct WeightedChild {
-            NodePtr node;
-            UtilityFunc weightFunc;
-
-            WeightedChild(NodePtr n, UtilityFunc f);
-        };
+        using UtilityFunc = UtilityScores::UtilityFunc;
 
         void addChild(NodePtr child, UtilityFunc weightFunc);
+        // Weigh the child by the product of its considerations (see UtilityModel)
+        void addChild(NodePtr child, const std::vector<Consideration> &considerations);
         Status tick(Blackboard &blackboard) override;
         void reset() override;
         void halt() override;
 
+        const std::vector<NodePtr> &getChildren() const { return children_; }
+        const UtilityScores &weights() const { return weights_; }
+
+        // Stream this node draws from under its tree's seed (see TickRandom)
+        void setRandomStream(std::uint64_t stream) { rng_.setStream(stream); }
+        std::uint64_t randomStream() const { return rng_.stream(); }
+
       private:
-        std::vector<WeightedChild> children_;
+        std::vector<NodePtr> children_;
+        UtilityScores weights_;
+        ActiveChildren active_;
         size_t currentIndex_ = SIZE_MAX;
+        // Alias table over the weights it was built from; rebuilt only when they change
+        core::AliasTable sampler_;
+        std::vector<float> sampledWeights_;
+        bool samplerStale_ = true;
+        core::RandomStream rng_{TickRandom::nextStream()};
     };
 
 } // namespace stateup::tree
@@ -0,0 +1,162 @@
+#pragma once
+#include "type_registry.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+namespace stateup::tree {
+
+    // ============================================================================
+    // SharedBlackboard - blackboard backend over a POSIX shared-memory segment
+    //
+    // Processes on the same host map one segment and read/write the same keys directly: no serialization,
+    // no syscalls after attach. Only trivially copyable values are supported.
+    //
+    // Segment layout:
+    //   Header | Slot[capacity]
+    //   Slot   = SlotHeader (state, key hash, seqlock sequence, type id, size, key) | value bytes
+    //
+    // Keys are interned into an open-addressing directory (linear probing over the slots); a key keeps its
+    // slot for the lifetime of the segment. Values are guarded by a per-slot seqlock: writers make the
+    // sequence odd while copying, readers retry until they observe the same even sequence before and after.
+    // A process that dies mid-write leaves its slot locked, so segments should be recreated after a crash.
+    // ============================================================================
+    class SharedBlackboard {
+      public:
+        static constexpr size_t kMaxKeyLength = 63;
+        static constexpr size_t kDefaultCapacity = 1024;
+        static constexpr size_t kDefaultValueSize = 64;
+
+        struct SlotHeader {
+            enum : std::uint32_t { Empty = 0, Claimed = 1, Ready = 2 };
+
+            std::atomic<std::uint32_t> state;
+            std::uint32_t keyHash;
+            std::atomic<std::uint64_t> sequence;
+            std::uint32_t typeId; // protected by sequence
+            std::uint32_t size;   // protected by sequence
+            char key[kMaxKeyLength + 1];
+        };
+
+        static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "shared slots need address-free atomics");
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared slots need address-free atomics");
+
+        // Typed handle to one interned key; load/store skip the directory lookup entirely
+        template <typename T> class Slot {
+          public:
+            Slot() = default;
+
+            void store(const T &value) {
+                if (header_)
+                    SharedBlackboard::write(header_, data_, typeId<T>(), &value, sizeof(T));
+            }
+
+            std::optional<T> load() const {
+                T value;
+                if (!header_ || !SharedBlackboard::read(header_, data_, typeId<T>(), &value, sizeof(T)))
+                    return std::nullopt;
+                return value;
+            }
+
+            // Number of completed writes to this key
+            std::uint64_t version() const {
+                return header_ ? header_->sequence.load(std::memory_order_acquire) / 2 : 0;
+            }
+
+            explicit operator bool() const { return header_ != nullptr; }
+
+          private:
+            friend class SharedBlackboard;
+            Slot(SlotHeader *header, unsigned char *data) : header_(header), data_(data) {}
+
+            SlotHeader *header_ = nullptr;
+            unsigned char *data_ = nullptr;
+        };
+
+        // Create a new segment (fails if one with this name exists). capacity is rounded up to a power of two.
+        static std::shared_ptr<SharedBlackboard> create(const std::string &name, size_t capacity = kDefaultCapacity,
+                                                        size_t valueSize = kDefaultValueSize);
+        // Attach to an existing segment created by another process
+        static std::shared_ptr<SharedBlackboard> open(const std::string &name);
+        // Remove the segment name; existing mappings stay valid until detached
+        static bool unlink(const std::string &name);
+
+        SharedBlackboard(const SharedBlackboard &) = delete;
+        SharedBlackboard &operator=(const SharedBlackboard &) = delete;
+        ~SharedBlackboard();
+
+        template <typename T> void set(const std::string &key, const T &value) { slot<T>(key).store(value); }
+
+        template <typename T> std::optional<T> get(const std::string &key) const {
+            SlotHeader *header = find(key);
+            T value;
+            if (!header || !read(header, valueOf(header), typeId<T>(), &value, sizeof(T)))
+                return std::nullopt;
+            return value;
+        }
+
+        // Intern key (creating it if needed) and return a typed handle to its slot
+        template <typename T> Slot<T> slot(const std::string &key) {
+            static_assert(std::is_trivially_copyable_v<T>, "SharedBlackboard only stores trivially copyable types");
+            if (sizeof(T) > valueSize_)
+                throw std::invalid_argument("SharedBlackboard: value of " + std::to_string(sizeof(T)) +
+                                            " bytes exceeds slot size for key '" + key + "'");
+            SlotHeader *header = intern(key);
+            return Slot<T>(header, valueOf(header));
+        }
+
+        bool has(const std::string &key) const { return find(key) != nullptr; }
+        std::uint64_t version(const std::string &key) const;
+        std::vector<std::string> getAllKeys() const;
+
+        const std::string &name() const { return name_; }
+        size_t capacity() const { return capacity_; }
+        size_t valueSize() const { return valueSize_; }
+        size_t size() const;
+
+        // Stable id used to type-check slots across processes: the TypeRegistry name when registered,
+        // otherwise the compiler's type name (processes must then be built with the same toolchain)
+        template <typename T> static std::uint32_t typeId() {
+            static const std::uint32_t id = [] {
+                if (const TypeCodec *codec = TypeRegistry::defaults().find(std::type_index(typeid(T))))
+                    return codec->id;
+                return TypeRegistry::hashName(typeid(T).name()) ^ static_cast<std::uint32_t>(sizeof(T));
+            }();
+            return id;
+        }
+
+      private:
+        struct Header;
+
+        SharedBlackboard(std::string name, void *base, size_t mappedSize);
+
+        SlotHeader *slotAt(size_t index) const;
+        unsigned char *valueOf(SlotHeader *header) const {
+            return reinterpret_cast<unsigned char *>(header) + sizeof(SlotHeader);
+        }
+        SlotHeader *find(const std::string &key) const;
+        SlotHeader *intern(const std::string &key);
+
+        static void write(SlotHeader *header, unsigned char *data, std::uint32_t typeId, const void *value,
+                          size_t size);
+        static bool read(const SlotHeader *header, const unsigned char *data, std::uint32_t typeId, void *value,
+                         size_t size);
+
+        std::string name_;
+        void *base_ = nullptr;
+        size_t mappedSize_ = 0;
+        size_t capacity_ = 0;
+        size_t valueSize_ = 0;
+        size_t slotStride_ = 0;
+    };
+
+    using SharedBlackboardPtr = std::shared_ptr<SharedBlackboard>;
+
+} // namespace stateup::tree
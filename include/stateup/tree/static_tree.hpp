@@ -0,0 +1,270 @@
+#pragma once
+#include "structure/blackboard.hpp"
+#include "structure/node.hpp"
+#include "structure/status.hpp"
+#include "structure/tick_budget.hpp"
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+namespace stateup::tree::static_tree {
+
+    // ============================================================================
+    // Static trees - behavior trees whose shape is a type
+    //
+    // The tree is spelled as nested templates and callbacks are template arguments, so a tick is ordinary inlined
+    // code: no virtual calls, no std::function, no shared_ptr, no heap. Each node type is stateless; what it
+    // remembers between ticks (cursor, attempt count, halted flag) lives in its nested `state`, and a composite's
+    // state holds its children's in a std::tuple. seq, sel, inv and retry follow Sequence, Selector, Inverter and
+    // RetryDecorator tick for tick, including halting, resuming and the tick budget.
+    //
+    //   namespace st = stateup::tree::static_tree;
+    //   using Patrol = st::seq<st::cond<[](Blackboard &bb) { return bb.has("route"); }>,
+    //                          st::retry<3, st::act<&moveToWaypoint>>>;
+    //   st::StaticTree<Patrol> patrol;
+    //   patrol.tick(blackboard);
+    //
+    //   builder.leaf(st::makeNode<Patrol>()); // embed in a runtime tree
+    // ============================================================================
+
+    // What every static node provides: default-constructible state and static tick/reset/halt on it
+    template <typename T>
+    concept StaticNodeType = std::default_initializable<typename T::state> &&
+                             requires(typename T::state &s, Blackboard &blackboard) {
+                                 { T::tick(s, blackboard) } -> std::same_as<Status>;
+                                 T::reset(s);
+                                 T::halt(s);
+                             };
+
+    // Leaf running F(blackboard) -> Status. F is a captureless lambda or a function pointer.
+    template <auto F>
+        requires std::is_invocable_r_v<Status, decltype(F), Blackboard &>
+    struct act {
+        struct state {
+            Node::State status = Node::State::Idle;
+        };
+
+        static Status tick(state &s, Blackboard &blackboard) {
+            if (s.status == Node::State::Halted)
+                return Status::Failure;
+            const Status result = std::invoke(F, blackboard);
+            s.status = result == Status::Running ? Node::State::Running : Node::State::Idle;
+            return result;
+        }
+        static void reset(state &s) { s.status = Node::State::Idle; }
+        static void halt(state &s) { s.status = Node::State::Halted; }
+    };
+
+    // Leaf succeeding when F(blackboard) is true and failing otherwise
+    template <auto F>
+        requires std::is_invocable_r_v<bool, decltype(F), Blackboard &>
+    struct cond {
+        struct state {
+            Node::State status = Node::State::Idle;
+        };
+
+        static Status tick(state &s, Blackboard &blackboard) {
+            if (s.status == Node::State::Halted)
+                return Status::Failure;
+            return std::invoke(F, blackboard) ? Status::Success : Status::Failure;
+        }
+        static void reset(state &s) { s.status = Node::State::Idle; }
+        static void halt(state &s) { s.status = Node::State::Halted; }
+    };
+
+    namespace detail {
+        // Sequence and Selector differ only in which child status ends them early
+        template <Status Stop, StaticNodeType... Children> struct composite {
+            static_assert(sizeof...(Children) > 0, "a static composite needs at least one child");
+            static constexpr size_t count = sizeof...(Children);
+            static constexpr Status Done = Stop == Status::Failure ? Status::Success : Status::Failure;
+            template <size_t I> using child = std::tuple_element_t<I, std::tuple<Children...>>;
+
+            struct state {
+                std::tuple<typename Children::state...> children;
+                size_t index = 0; // the child to tick next
+                Node::State status = Node::State::Idle;
+            };
+
+            static Status tick(state &s, Blackboard &blackboard) {
+                if (s.status == Node::State::Halted)
+                    return Status::Failure;
+                s.status = Node::State::Running;
+                return run<0>(s, blackboard);
+            }
+
+            static void reset(state &s) {
+                // An idle composite reset its children when it finished and has not ticked any since
+                if (s.status != Node::State::Idle)
+                    resetTicked(s, std::index_sequence_for<Children...>{});
+                s.status = Node::State::Idle;
+                s.index = 0;
+            }
+
+            // Only the current child can be running
+            static void halt(state &s) {
+                const bool running = s.status == Node::State::Running;
+                s.status = Node::State::Halted;
+                if (running)
+                    haltCurrent(s, std::index_sequence_for<Children...>{});
+            }
+
+          private:
+            // Unrolled over the children; the ones before the resume point are skipped by a compare each
+            template <size_t I> static Status run(state &s, Blackboard &blackboard) {
+                if constexpr (I == count) {
+                    reset(s);
+                    return Done;
+                } else {
+                    if (s.index > I)
+                        return run<I + 1>(s, blackboard);
+                    const Status status = child<I>::tick(std::get<I>(s.children), blackboard);
+                    if (status == Status::Running)
+                        return Status::Running;
+                    if (status == Stop) {
+                        reset(s);
+                        return Stop;
+                    }
+                    s.index = I + 1;
+                    if constexpr (I + 1 < count) {
+                        if (TickBudget::exhausted())
+                            return Status::Running;
+                    }
+                    return run<I + 1>(s, blackboard);
+                }
+            }
+
+            template <size_t... I> static void resetTicked(state &s, std::index_sequence<I...>) {
+                ((I <= s.index ? child<I>::reset(std::get<I>(s.children)) : void()), ...);
+            }
+
+            template <size_t... I> static void haltCurrent(state &s, std::index_sequence<I...>) {
+                ((I == s.index ? child<I>::halt(std::get<I>(s.children)) : void()), ...);
+            }
+        };
+    } // namespace detail
+
+    // Ticks children in order until one fails; resumes at a running child
+    template <StaticNodeType... Children> struct seq : detail::composite<Status::Failure, Children...> {};
+
+    // Ticks children in order until one succeeds; resumes at a running child
+    template <StaticNodeType... Children> struct sel : detail::composite<Status::Success, Children...> {};
+
+    // Swaps Success and Failure of its child
+    template <StaticNodeType Child> struct inv {
+        struct state {
+            typename Child::state child;
+            Node::State status = Node::State::Idle;
+        };
+
+        static Status tick(state &s, Blackboard &blackboard) {
+            if (s.status == Node::State::Halted)
+                return Status::Failure;
+            s.status = Node::State::Running;
+            Status result = Child::tick(s.child, blackboard);
+            if (result == Status::Success)
+                result = Status::Failure;
+            else if (result == Status::Failure)
+                result = Status::Success;
+            if (result != Status::Running)
+                s.status = Node::State::Idle;
+            return result;
+        }
+        static void reset(state &s) {
+            s.status = Node::State::Idle;
+            Child::reset(s.child);
+        }
+        static void halt(state &s) {
+            s.status = Node::State::Halted;
+            Child::halt(s.child);
+        }
+    };
+
+    // Runs its child up to MaxAttempts times (forever if MaxAttempts <= 0), one attempt per tick, until it succeeds
+    template <int MaxAttempts, StaticNodeType Child> struct retry {
+        struct state {
+            typename Child::state child;
+            int attempts = 0;
+            Node::State status = Node::State::Idle;
+        };
+
+        static Status tick(state &s, Blackboard &blackboard) {
+            if (s.status == Node::State::Halted)
+                return Status::Failure;
+            s.status = Node::State::Running;
+
+            const Status result = Child::tick(s.child, blackboard);
+            if (result == Status::Running)
+                return Status::Running;
+            if (result == Status::Success) {
+                reset(s);
+                return Status::Success;
+            }
+
+            ++s.attempts;
+            Child::reset(s.child);
+            if (MaxAttempts > 0 && s.attempts >= MaxAttempts) {
+                reset(s);
+                return Status::Failure;
+            }
+            return Status::Running;
+        }
+        static void reset(state &s) {
+            s.status = Node::State::Idle;
+            s.attempts = 0;
+            Child::reset(s.child);
+        }
+        static void halt(state &s) {
+            s.status = Node::State::Halted;
+            s.attempts = 0;
+            Child::halt(s.child);
+        }
+    };
+
+    // Owns the state of a static tree
+    template <StaticNodeType Root> class StaticTree {
+      public:
+        Status tick(Blackboard &blackboard) { return Root::tick(state_, blackboard); }
+        void reset() { Root::reset(state_); }
+        void halt() { Root::halt(state_); }
+
+        typename Root::state &state() { return state_; }
+        const typename Root::state &state() const { return state_; }
+
+      private:
+        typename Root::state state_;
+    };
+
+    // Runtime node wrapping a static tree, so it can sit anywhere a NodePtr can
+    template <StaticNodeType Root> class StaticNode : public Node {
+      public:
+        Status tick(Blackboard &blackboard) override {
+            if (state_ == State::Halted)
+                return Status::Failure;
+            state_ = State::Running;
+            const Status result = tree_.tick(blackboard);
+            if (result != Status::Running)
+                state_ = State::Idle;
+            return result;
+        }
+        void reset() override {
+            Node::reset();
+            tree_.reset();
+        }
+        void halt() override {
+            Node::halt();
+            tree_.halt();
+        }
+
+        StaticTree<Root> &tree() { return tree_; }
+
+      private:
+        StaticTree<Root> tree_;
+    };
+
+    template <StaticNodeType Root> NodePtr makeNode() { return std::make_shared<StaticNode<Root>>(); }
+
+} // namespace stateup::tree::static_tree
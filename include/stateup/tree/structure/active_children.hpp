@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace stateup::tree {
+
+    // ============================================================================
+    // ActiveChildren - the children a composite has ticked since its last reset
+    //
+    // Only these can hold running work or leftover state, so reset() walks this list instead of every child and
+    // costs O(children that ran) rather than O(subtree). mark() is O(1) and does not allocate once the composite
+    // has been sized with grow().
+    // ============================================================================
+    class ActiveChildren {
+      public:
+        // One call per child added to the composite
+        void grow() {
+            flags_.push_back(0);
+            order_.reserve(flags_.size());
+        }
+
+        void mark(size_t index) {
+            if (!flags_[index]) {
+                flags_[index] = 1;
+                order_.push_back(index);
+            }
+        }
+
+        bool contains(size_t index) const { return index < flags_.size() && flags_[index]; }
+        bool empty() const { return order_.empty(); }
+        size_t size() const { return order_.size(); }
+
+        // Calls f(index) for every marked child, in the order they were first ticked, then forgets them
+        template <typename F> void drain(F &&f) {
+            for (size_t index : order_) {
+                flags_[index] = 0;
+                f(index);
+            }
+            order_.clear();
+        }
+
+      private:
+        std::vector<std::uint8_t> flags_;
+        std::vector<size_t> order_;
+    };
+
+} // namespace stateup::tree
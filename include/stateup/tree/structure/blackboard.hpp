@@ -1,10 +1,18 @@
 #pragma once
+#include <algorithm>
 #include <any>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <shared_mutex>
+#include <stdexcept>
 #include <string>
 #include <typeindex>
+#include <typeinfo>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -12,6 +20,15 @@
 
 namespace stateup::tree {
 
+    class Wakeup;
+
+    // Locking strategy used by a Blackboard.
+    //   None        - no synchronization; for trees ticked from a single thread (plain map access)
+    //   Mutex       - one std::mutex around every access (default, previous behavior)
+    //   SharedMutex - readers (get/has) share the lock, writers are exclusive
+    //   Sharded     - keys are hashed onto independent shards, each with its own mutex
+    enum class LockPolicy { None, Mutex, SharedMutex, Sharded };
+
     class Blackboard {
       public:
         struct Event {
@@ -43,74 +60,103 @@ namespace stateup::tree {
             bool active_ = false;
         };
 
+        static constexpr size_t kShardCount = 16;
+
+        explicit Blackboard(LockPolicy policy = LockPolicy::Mutex) { configure(policy); }
+        Blackboard(const Blackboard &) = delete;
+        Blackboard &operator=(const Blackboard &) = delete;
+
+        // Switch the locking strategy, keeping all entries and scopes.
+        // Must not be called while other threads access the blackboard.
+        void setLockPolicy(LockPolicy policy);
+        LockPolicy lockPolicy() const { return policy_; }
+
         template <typename T> inline void set(const std::string &key, T value) {
+            size_t depth = 0;
+            const Observer *observer = nullptr;
             Observer observerCopy;
-            Event event{Event::Type::Set, key, std::type_index(typeid(T)), true, 0};
             {
-                std::lock_guard<std::mutex> lock(mutex_);
-                Entry entry{std::make_any<T>(std::move(value)), std::type_index(typeid(T))};
-                scopes_.back()[key] = std::move(entry);
-                observerCopy = observer_;
-                event.scopeDepth = scopes_.size() - 1;
+                const size_t index = shardIndex(key);
+                KeyGuard guard(*this, index, true);
+                auto &scopes = shards_[index].scopes;
+                Entry &entry = scopes.back()[key];
+                entry.value = std::make_any<T>(std::move(value));
+                entry.type = std::type_index(typeid(T));
+                entry.version = nextRevision();
+                depth = scopes.size() - 1;
+                observer = observerFor(observerCopy);
             }
-            notify(observerCopy, event);
+            if (observer && *observer)
+                notify(*observer, Event{Event::Type::Set, key, std::type_index(typeid(T)), true, depth});
         }
 
         template <typename T> inline std::optional<T> get(const std::string &key) const {
-            Observer observerCopy;
-            Event event{Event::Type::Get, key, std::type_index(typeid(T)), false, 0};
             std::optional<T> result;
+            std::type_index valueType(typeid(T));
+            size_t depth = 0;
+            const Observer *observer = nullptr;
+            Observer observerCopy;
             {
-                std::lock_guard<std::mutex> lock(mutex_);
-                observerCopy = observer_;
-                auto [entry, depth] = findEntry(key);
-                event.scopeDepth = depth;
-                if (!entry) {
-                    // Keep failure event with requested type
-                } else if (entry->type != std::type_index(typeid(T))) {
-                    event.valueType = std::type_index(typeid(T));
-                } else {
-                    try {
-                        result = std::any_cast<T>(entry->value);
-                        event.valueType = entry->type;
-                        event.success = true;
-                    } catch (const std::bad_any_cast &) {
-                        event.valueType = entry->type;
-                        event.success = false;
+                const size_t index = shardIndex(key);
+                KeyGuard guard(*this, index, false);
+                auto [entry, entryDepth] = findEntry(index, key);
+                depth = entryDepth;
+                // Type mismatches and missing keys keep the failure event with the requested type
+                if (entry && entry->type == valueType) {
+                    if (const T *value = std::any_cast<T>(&entry->value)) {
+                        result = *value;
                     }
                 }
+                if (recording_ && recording_->source == this)
+                    recording_->keys.emplace_back(key, entry ? entry->version : 0);
+                observer = observerFor(observerCopy);
             }
-            notify(observerCopy, event);
+            if (observer && *observer)
+                notify(*observer, Event{Event::Type::Get, key, valueType, result.has_value(), depth});
             return result;
         }
 
         inline bool has(const std::string &key) const {
-            std::lock_guard<std::mutex> lock(mutex_);
-            return findEntry(key).first != nullptr;
+            const size_t index = shardIndex(key);
+            KeyGuard guard(*this, index, false);
+            const Entry *entry = findEntry(index, key).first;
+            if (recording_ && recording_->source == this)
+                recording_->keys.emplace_back(key, entry ? entry->version : 0);
+            return entry != nullptr;
         }
 
         inline void remove(const std::string &key) {
-            Observer observerCopy;
             Event event{Event::Type::Remove, key, std::type_index(typeid(void)), false, 0};
+            const Observer *observer = nullptr;
+            Observer observerCopy;
             {
-                std::lock_guard<std::mutex> lock(mutex_);
-                auto &current = scopes_.back();
-                event.success = current.erase(key) > 0;
-                event.scopeDepth = scopes_.size() - 1;
-                observerCopy = observer_;
+                const size_t index = shardIndex(key);
+                KeyGuard guard(*this, index, true);
+                auto &scopes = shards_[index].scopes;
+                event.success = scopes.back().erase(key) > 0;
+                event.scopeDepth = scopes.size() - 1;
+                if (event.success)
+                    structureRevision_.fetch_add(1, std::memory_order_relaxed);
+                observer = observerFor(observerCopy);
             }
-            notify(observerCopy, event);
+            if (observer)
+                notify(*observer, event);
         }
 
         inline void clear() {
-            Observer observerCopy;
             Event event{Event::Type::Clear, "", std::type_index(typeid(void)), true, 0};
+            const Observer *observer = nullptr;
+            Observer observerCopy;
             {
-                std::lock_guard<std::mutex> lock(mutex_);
-                scopes_.assign(1, {});
-                observerCopy = observer_;
+                AllGuard guard(*this, true);
+                for (size_t i = 0; i < shardCount_; ++i) {
+                    shards_[i].scopes.assign(1, {});
+                }
+                structureRevision_.fetch_add(1, std::memory_order_relaxed);
+                observer = observerFor(observerCopy);
             }
-            notify(observerCopy, event);
+            if (observer)
+                notify(*observer, event);
         }
 
         ScopeToken pushScope();
@@ -120,11 +166,13 @@ namespace stateup::tree {
 
         // FIX: Add key enumeration
         inline std::vector<std::string> getAllKeys() const {
-            std::lock_guard<std::mutex> lock(mutex_);
+            AllGuard guard(*this, false);
             std::unordered_set<std::string> allKeys;
-            for (const auto &scope : scopes_) {
-                for (const auto &[key, entry] : scope) {
-                    allKeys.insert(key);
+            for (size_t i = 0; i < shardCount_; ++i) {
+                for (const auto &scope : shards_[i].scopes) {
+                    for (const auto &[key, entry] : scope) {
+                        allKeys.insert(key);
+                    }
                 }
             }
             return std::vector<std::string>(allKeys.begin(), allKeys.end());
@@ -132,31 +180,401 @@ namespace stateup::tree {
 
         // FIX: Add type info for a key
         inline std::optional<std::type_index> getType(const std::string &key) const {
-            std::lock_guard<std::mutex> lock(mutex_);
-            auto [entry, depth] = findEntry(key);
+            const size_t index = shardIndex(key);
+            KeyGuard guard(*this, index, false);
+            auto [entry, depth] = findEntry(index, key);
             if (entry) {
                 return entry->type;
             }
             return std::nullopt;
         }
 
+        // Visits every visible entry once (innermost scope wins) under a single lock, without observer events.
+        // visitor(const std::string &key, const std::any &value, std::type_index type)
+        template <typename F> void forEachEntry(F &&visitor) const {
+            AllGuard guard(*this, false);
+            for (size_t i = 0; i < shardCount_; ++i) {
+                const auto &scopes = shards_[i].scopes;
+                if (scopes.size() == 1) {
+                    for (const auto &[key, entry] : scopes.front()) {
+                        visitor(key, entry.value, entry.type);
+                    }
+                    continue;
+                }
+                std::unordered_set<std::string> seen;
+                for (size_t depth = scopes.size(); depth > 0; --depth) {
+                    for (const auto &[key, entry] : scopes[depth - 1]) {
+                        if (seen.insert(key).second) {
+                            visitor(key, entry.value, entry.type);
+                        }
+                    }
+                }
+            }
+        }
+
+        // Change tracking: every write stamps its entry with a new, increasing revision.
+        // Removals, clear() and popScope() bump the structure revision instead, since they can change
+        // visible values without any entry being written.
+        std::uint64_t revision() const { return revision_.load(std::memory_order_acquire); }
+        std::uint64_t structureRevision() const { return structureRevision_.load(std::memory_order_acquire); }
+
+        // Like forEachEntry, but only visits visible entries written after `since`. Returns the revision the
+        // pass is consistent with; pass it back as `since` next time to get the following changes.
+        template <typename F> std::uint64_t forEachChangedSince(std::uint64_t since, F &&visitor) const {
+            AllGuard guard(*this, false);
+            for (size_t i = 0; i < shardCount_; ++i) {
+                const auto &scopes = shards_[i].scopes;
+                if (scopes.size() == 1) {
+                    for (const auto &[key, entry] : scopes.front()) {
+                        if (entry.version > since)
+                            visitor(key, entry.value, entry.type);
+                    }
+                    continue;
+                }
+                std::unordered_set<std::string> seen;
+                for (size_t depth = scopes.size(); depth > 0; --depth) {
+                    for (const auto &[key, entry] : scopes[depth - 1]) {
+                        if (seen.insert(key).second && entry.version > since) {
+                            visitor(key, entry.value, entry.type);
+                        }
+                    }
+                }
+            }
+            return revision_.load(std::memory_order_relaxed);
+        }
+
+        // Revision of the entry `key` currently resolves to, or 0 if it is not set
+        inline std::uint64_t keyRevision(const std::string &key) const {
+            const size_t index = shardIndex(key);
+            KeyGuard guard(*this, index, false);
+            const Entry *entry = findEntry(index, key).first;
+            return entry ? entry->version : 0;
+        }
+
+        // Dependency tracking: the keys some code read through get()/has(), each with the revision it saw.
+        // A ReadSet is filled by a ReadRecording and later checked with unchanged(); see CachedNode and memoize().
+        struct ReadSet {
+            std::vector<std::pair<std::string, std::uint64_t>> keys;
+            std::uint64_t structureRevision = 0;
+            mutable std::uint64_t checkedRevision = 0; // blackboard revision the keys were last known valid at
+            const Blackboard *source = nullptr;
+
+            void clear() {
+                keys.clear();
+                source = nullptr;
+            }
+        };
+
+        // Records get()/has() calls made on this blackboard by the current thread while alive. Reads made on
+        // other threads are not seen unless handed over with reportReads(), as SequenceGroup and speculative
+        // Selectors do (pooled Parallel children are not), nor are typed-context accesses. Recordings nest: an
+        // inner one also reports its keys to the enclosing one.
+        class ReadRecording {
+          public:
+            ReadRecording(const Blackboard &owner, ReadSet &reads) : reads_(reads), outer_(recording_) {
+                reads_.clear();
+                reads_.source = &owner;
+                reads_.structureRevision = owner.structureRevision();
+                reads_.checkedRevision = owner.revision();
+                recording_ = &reads_;
+            }
+            ~ReadRecording() {
+                recording_ = outer_;
+                auto &keys = reads_.keys;
+                // Keep the earliest revision seen per key so a subtree that rewrites its own inputs re-runs
+                std::sort(keys.begin(), keys.end());
+                keys.erase(std::unique(keys.begin(), keys.end(),
+                                       [](const auto &a, const auto &b) { return a.first == b.first; }),
+                           keys.end());
+                if (outer_ && outer_->source == reads_.source)
+                    outer_->keys.insert(outer_->keys.end(), keys.begin(), keys.end());
+            }
+            ReadRecording(const ReadRecording &) = delete;
+            ReadRecording &operator=(const ReadRecording &) = delete;
+
+          private:
+            ReadSet &reads_;
+            ReadSet *outer_;
+        };
+
+        ReadRecording recordReads(ReadSet &reads) const { return ReadRecording(*this, reads); }
+        // True while a recording on this blackboard is active on the current thread
+        bool recordingReads() const { return recording_ && recording_->source == this; }
+
+        // Adds previously recorded reads to the active recording, for callers that reuse a result instead of
+        // reading the keys again
+        inline void reportReads(const ReadSet &reads) const {
+            if (recording_ && recording_->source == this && reads.source == this)
+                recording_->keys.insert(recording_->keys.end(), reads.keys.begin(), reads.keys.end());
+        }
+
+        // True if every key in `reads` still resolves to the revision it had and nothing was removed since.
+        // Free while nothing at all was written; otherwise one lookup per key.
+        inline bool unchanged(const ReadSet &reads) const {
+            if (reads.source != this || reads.structureRevision != structureRevision())
+                return false;
+            const std::uint64_t current = revision();
+            if (current == reads.checkedRevision)
+                return true;
+            for (const auto &[key, version] : reads.keys) {
+                if (keyRevision(key) != version)
+                    return false;
+            }
+            reads.checkedRevision = current;
+            return true;
+        }
+
+        // Typed context: a user struct bound by pointer (see TypedTree) and reached without key lookup or
+        // std::any. The blackboard does not own it; the binder must keep it alive.
+        template <typename C> void bindContext(C *context) {
+            context_ = context;
+            contextType_ = context ? &typeid(C) : nullptr;
+        }
+
+        template <typename C> C *contextPtr() const {
+            if (contextType_ && *contextType_ == typeid(C))
+                return static_cast<C *>(context_);
+            return nullptr;
+        }
+
+        template <typename C> C &context() const {
+            if (C *bound = contextPtr<C>())
+                return *bound;
+            throw std::runtime_error(std::string("Blackboard: no context of type ") + typeid(C).name() + " bound");
+        }
+
+        // Wakeup of the tree ticking this blackboard (see Tree::tickWhenReady); null for standalone blackboards
+        void setWakeup(std::shared_ptr<Wakeup> wakeup) { wakeup_ = std::move(wakeup); }
+        const std::shared_ptr<Wakeup> &wakeup() const { return wakeup_; }
+
+        // Type-erased entry used for bulk loading (e.g. snapshot restore)
+        struct RawEntry {
+            std::string key;
+            std::any value;
+            std::type_index type;
+        };
+
+        // Writes all entries into the current scope under a single lock; one Set event per entry
+        inline void setEntries(std::vector<RawEntry> entries) {
+            const Observer *observer = nullptr;
+            Observer observerCopy;
+            std::vector<Event> events;
+            {
+                AllGuard guard(*this, true);
+                observer = observerFor(observerCopy);
+                const size_t depth = shards_[0].scopes.size() - 1;
+                if (shardCount_ == 1) {
+                    auto &scope = shards_[0].scopes.back();
+                    scope.reserve(scope.size() + entries.size());
+                }
+                if (*observer) {
+                    events.reserve(entries.size());
+                }
+                for (auto &raw : entries) {
+                    if (*observer) {
+                        events.push_back(Event{Event::Type::Set, raw.key, raw.type, true, depth});
+                    }
+                    auto &scope = shards_[shardIndex(raw.key)].scopes.back();
+                    scope.insert_or_assign(std::move(raw.key), Entry{std::move(raw.value), raw.type, nextRevision()});
+                }
+            }
+            for (const auto &event : events) {
+                notify(*observer, event);
+            }
+        }
+
+        // What a key held in the current scope, saved so that later writes to it can be undone (see SequenceGroup,
+        // which runs siblings speculatively and rolls back the ones a sequence would not have reached)
+        struct SavedEntry {
+            std::string key;
+            std::any value;
+            std::type_index type = std::type_index(typeid(void));
+            std::uint64_t version = 0; // 0: not set in the current scope
+        };
+
+        inline void save(const std::string &key, SavedEntry &saved) const {
+            const size_t index = shardIndex(key);
+            KeyGuard guard(*this, index, false);
+            const Scope &scope = shards_[index].scopes.back();
+            saved.key = key;
+            auto it = scope.find(key);
+            if (it == scope.end()) {
+                saved.value.reset();
+                saved.type = std::type_index(typeid(void));
+                saved.version = 0;
+            } else {
+                saved.value = it->second.value;
+                saved.type = it->second.type;
+                saved.version = it->second.version;
+            }
+        }
+
+        // Puts a saved entry back, as a new write (or a removal if it was unset). A key nobody wrote since save()
+        // is left alone, so its revision does not change.
+        inline void restore(const SavedEntry &saved) {
+            Event event{Event::Type::Set, saved.key, saved.type, true, 0};
+            const Observer *observer = nullptr;
+            Observer observerCopy;
+            {
+                const size_t index = shardIndex(saved.key);
+                KeyGuard guard(*this, index, true);
+                auto &scopes = shards_[index].scopes;
+                auto &scope = scopes.back();
+                auto it = scope.find(saved.key);
+                if ((it == scope.end() ? 0 : it->second.version) == saved.version)
+                    return;
+                event.scopeDepth = scopes.size() - 1;
+                if (saved.version == 0) {
+                    scope.erase(it);
+                    structureRevision_.fetch_add(1, std::memory_order_relaxed);
+                    event.type = Event::Type::Remove;
+                    event.valueType = std::type_index(typeid(void));
+                } else {
+                    scope.insert_or_assign(saved.key, Entry{saved.value, saved.type, nextRevision()});
+                }
+                observer = observerFor(observerCopy);
+            }
+            if (observer && *observer)
+                notify(*observer, event);
+        }
+
       private:
         struct Entry {
             Entry() : value(), type(typeid(void)) {}
-            Entry(std::any v, std::type_index t) : value(std::move(v)), type(t) {}
+            Entry(std::any v, std::type_index t, std::uint64_t ver) : value(std::move(v)), type(t), version(ver) {}
             std::any value;
             std::type_index type;
+            std::uint64_t version = 0;
+        };
+
+        using Scope = std::unordered_map<std::string, Entry>;
+
+        // Each shard owns its own scope stack; all shards always have the same scope depth.
+        // Only the Sharded policy uses more than one shard.
+        struct alignas(64) Shard {
+            mutable std::mutex mutex;
+            std::vector<Scope> scopes{1};
+        };
+
+        // Locks whatever protects the shard holding a single key
+        class KeyGuard {
+          public:
+            KeyGuard(const Blackboard &owner, size_t index, bool exclusive)
+                : owner_(owner), index_(index), exclusive_(exclusive) {
+                switch (owner_.policy_) {
+                case LockPolicy::None:
+                    break;
+                case LockPolicy::Mutex:
+                case LockPolicy::Sharded:
+                    owner_.shards_[index_].mutex.lock();
+                    break;
+                case LockPolicy::SharedMutex:
+                    if (exclusive_)
+                        owner_.sharedMutex_.lock();
+                    else
+                        owner_.sharedMutex_.lock_shared();
+                    break;
+                }
+            }
+            ~KeyGuard() {
+                switch (owner_.policy_) {
+                case LockPolicy::None:
+                    break;
+                case LockPolicy::Mutex:
+                case LockPolicy::Sharded:
+                    owner_.shards_[index_].mutex.unlock();
+                    break;
+                case LockPolicy::SharedMutex:
+                    if (exclusive_)
+                        owner_.sharedMutex_.unlock();
+                    else
+                        owner_.sharedMutex_.unlock_shared();
+                    break;
+                }
+            }
+            KeyGuard(const KeyGuard &) = delete;
+            KeyGuard &operator=(const KeyGuard &) = delete;
+
+          private:
+            const Blackboard &owner_;
+            size_t index_;
+            bool exclusive_;
+        };
+
+        // Locks every shard (in index order) for structural operations: scopes, clear, enumeration, observer
+        class AllGuard {
+          public:
+            AllGuard(const Blackboard &owner, bool exclusive) : owner_(owner), exclusive_(exclusive) {
+                if (owner_.policy_ == LockPolicy::SharedMutex) {
+                    if (exclusive_)
+                        owner_.sharedMutex_.lock();
+                    else
+                        owner_.sharedMutex_.lock_shared();
+                } else if (owner_.policy_ != LockPolicy::None) {
+                    for (size_t i = 0; i < owner_.shardCount_; ++i)
+                        owner_.shards_[i].mutex.lock();
+                }
+            }
+            ~AllGuard() {
+                if (owner_.policy_ == LockPolicy::SharedMutex) {
+                    if (exclusive_)
+                        owner_.sharedMutex_.unlock();
+                    else
+                        owner_.sharedMutex_.unlock_shared();
+                } else if (owner_.policy_ != LockPolicy::None) {
+                    for (size_t i = owner_.shardCount_; i > 0; --i)
+                        owner_.shards_[i - 1].mutex.unlock();
+                }
+            }
+            AllGuard(const AllGuard &) = delete;
+            AllGuard &operator=(const AllGuard &) = delete;
+
+          private:
+            const Blackboard &owner_;
+            bool exclusive_;
         };
 
-        inline std::pair<Entry *, size_t> findEntry(const std::string &key) const {
-            for (size_t depth = scopes_.size(); depth > 0; --depth) {
-                auto &scope = scopes_[depth - 1];
+        void configure(LockPolicy policy) {
+            policy_ = policy;
+            shardCount_ = policy == LockPolicy::Sharded ? kShardCount : 1;
+            shards_ = std::make_unique<Shard[]>(shardCount_);
+        }
+
+        // Only one thread writes a LockPolicy::None blackboard, so there a plain load and store do without the
+        // locked read-modify-write
+        inline std::uint64_t nextRevision() {
+            if (policy_ == LockPolicy::None) {
+                const std::uint64_t next = revision_.load(std::memory_order_relaxed) + 1;
+                revision_.store(next, std::memory_order_relaxed);
+                return next;
+            }
+            return revision_.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        inline size_t shardIndex(const std::string &key) const {
+            if (shardCount_ == 1)
+                return 0;
+            return std::hash<std::string>{}(key) & (kShardCount - 1);
+        }
+
+        inline std::pair<Entry *, size_t> findEntry(size_t index, const std::string &key) const {
+            auto &scopes = shards_[index].scopes;
+            for (size_t depth = scopes.size(); depth > 0; --depth) {
+                auto &scope = scopes[depth - 1];
                 auto it = scope.find(key);
                 if (it != scope.end()) {
                     return {const_cast<Entry *>(&it->second), depth - 1};
                 }
             }
-            return {nullptr, scopes_.size()};
+            return {nullptr, scopes.size()};
+        }
+
+        // Single-threaded blackboards call the observer in place; locked ones snapshot it under the lock
+        inline const Observer *observerFor(Observer &copy) const {
+            if (policy_ == LockPolicy::None)
+                return &observer_;
+            copy = observer_;
+            return &copy;
         }
 
         inline void notify(const Observer &observer, const Event &event) const {
@@ -169,11 +587,41 @@ namespace stateup::tree {
             }
         }
 
-        mutable std::mutex mutex_;
-        std::vector<std::unordered_map<std::string, Entry>> scopes_{{}};
+        LockPolicy policy_ = LockPolicy::Mutex;
+        size_t shardCount_ = 1;
+        std::unique_ptr<Shard[]> shards_;
+        mutable std::shared_mutex sharedMutex_;
         Observer observer_;
+        std::atomic<std::uint64_t> revision_{0};
+        std::atomic<std::uint64_t> structureRevision_{0};
+        void *context_ = nullptr;
+        const std::type_info *contextType_ = nullptr;
+        std::shared_ptr<Wakeup> wakeup_;
+
+        inline static thread_local ReadSet *recording_ = nullptr;
     };
 
+    inline void Blackboard::setLockPolicy(LockPolicy policy) {
+        if (policy == policy_)
+            return;
+        std::vector<Scope> merged(shards_[0].scopes.size());
+        for (size_t i = 0; i < shardCount_; ++i) {
+            auto &scopes = shards_[i].scopes;
+            for (size_t depth = 0; depth < scopes.size(); ++depth) {
+                merged[depth].merge(scopes[depth]);
+            }
+        }
+        configure(policy);
+        for (size_t i = 0; i < shardCount_; ++i) {
+            shards_[i].scopes.resize(merged.size());
+        }
+        for (size_t depth = 0; depth < merged.size(); ++depth) {
+            for (auto &[key, entry] : merged[depth]) {
+                shards_[shardIndex(key)].scopes[depth].emplace(key, std::move(entry));
+            }
+        }
+    }
+
     inline Blackboard::ScopeToken::ScopeToken(Blackboard *owner, size_t depth)
         : owner_(owner), depth_(depth), active_(owner != nullptr) {}
 
@@ -201,39 +649,43 @@ namespace stateup::tree {
     }
 
     inline Blackboard::ScopeToken Blackboard::pushScope() {
+        const Observer *observer = nullptr;
         Observer observerCopy;
         size_t depth = 0;
         Event event{Event::Type::ScopePushed, "", std::type_index(typeid(void)), true, 0};
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            scopes_.emplace_back();
-            depth = scopes_.size() - 1;
+            AllGuard guard(*this, true);
+            for (size_t i = 0; i < shardCount_; ++i) {
+                shards_[i].scopes.emplace_back();
+            }
+            depth = shards_[0].scopes.size() - 1;
             event.scopeDepth = depth;
-            observerCopy = observer_;
+            observer = observerFor(observerCopy);
         }
-        notify(observerCopy, event);
+        notify(*observer, event);
         return ScopeToken(this, depth);
     }
 
     inline void Blackboard::popScope() {
+        const Observer *observer = nullptr;
         Observer observerCopy;
         Event event{Event::Type::ScopePopped, "", std::type_index(typeid(void)), true, 0};
-        bool shouldNotify = false;
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            if (scopes_.size() <= 1)
+            AllGuard guard(*this, true);
+            if (shards_[0].scopes.size() <= 1)
                 return;
-            scopes_.pop_back();
-            event.scopeDepth = scopes_.size() - 1;
-            observerCopy = observer_;
-            shouldNotify = true;
+            for (size_t i = 0; i < shardCount_; ++i) {
+                shards_[i].scopes.pop_back();
+            }
+            structureRevision_.fetch_add(1, std::memory_order_relaxed);
+            event.scopeDepth = shards_[0].scopes.size() - 1;
+            observer = observerFor(observerCopy);
         }
-        if (shouldNotify)
-            notify(observerCopy, event);
+        notify(*observer, event);
     }
 
     inline void Blackboard::setObserver(Observer observer) {
-        std::lock_guard<std::mutex> lock(mutex_);
+        AllGuard guard(*this, true);
         observer_ = std::move(observer);
     }
 
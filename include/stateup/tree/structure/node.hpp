@@ -2,13 +2,14 @@
 #include "blackboard.hpp"
 #include "status.hpp"
 #include <atomic>
+#include <cstdint>
 #include <memory>
 
 namespace stateup::tree {
 
     class Node {
       public:
-        enum class State { Idle, Running, Halted };
+        enum class State : std::uint8_t { Idle, Running, Halted };
 
         Node() = default;
         virtual ~Node() = default; // FIX: Ensure virtual destructor
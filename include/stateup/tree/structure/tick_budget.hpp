@@ -0,0 +1,45 @@
+#pragma once
+#include <chrono>
+
+namespace stateup::tree {
+
+    // ============================================================================
+    // TickBudget - the deadline of the tick in progress
+    //
+    // Tree::tick(deadline) installs one on the ticking thread for the duration of the tick. Nodes that can loop or
+    // walk many children within one tick (Sequence, Selector, WhileNode, ForNode) ask exhausted() before starting
+    // more work and return Running instead, keeping their position so the next tick resumes there. They only ask
+    // after making progress, so a tick that starts late still advances. Children ticked on an executor thread do
+    // not see the budget.
+    // ============================================================================
+    class TickBudget {
+      public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit TickBudget(Clock::time_point deadline) : deadline_(deadline), previous_(current_) { current_ = this; }
+        ~TickBudget() { current_ = previous_; }
+        TickBudget(const TickBudget &) = delete;
+        TickBudget &operator=(const TickBudget &) = delete;
+
+        // True if a deadline is set on this thread and has passed; the caller is expected to yield Running
+        static bool exhausted() {
+            TickBudget *budget = current_;
+            if (!budget || Clock::now() < budget->deadline_)
+                return false;
+            budget->yielded_ = true;
+            return true;
+        }
+
+        Clock::time_point deadline() const { return deadline_; }
+        // Some node stopped early because of this budget
+        bool yielded() const { return yielded_; }
+
+      private:
+        Clock::time_point deadline_;
+        TickBudget *previous_;
+        bool yielded_ = false;
+
+        inline static thread_local TickBudget *current_ = nullptr;
+    };
+
+} // namespace stateup::tree
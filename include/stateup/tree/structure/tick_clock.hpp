@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <optional>
+
+namespace stateup::tree {
+
+    // ============================================================================
+    // TickClock - where a tree or state machine reads the time
+    //
+    // Timed nodes and transitions (Timeout, Cooldown, DebounceDecorator, timed transitions, sleepFor() in coroutine
+    // actions) read the time of the tick in progress through TickTime, which samples the owner's clock at most
+    // once per tick. Without a clock set, that is the steady clock. A SimulatedClock only moves when told to, so a
+    // test can fast-forward hours of timeouts and cooldowns without sleeping.
+    // ============================================================================
+    class TickClock {
+      public:
+        using Clock = std::chrono::steady_clock;
+
+        virtual ~TickClock() = default;
+        virtual Clock::time_point now() const = 0;
+    };
+
+    // Manually driven clock; any thread may read or advance it
+    class SimulatedClock final : public TickClock {
+      public:
+        explicit SimulatedClock(Clock::time_point start = Clock::time_point{})
+            : now_(start.time_since_epoch().count()) {}
+
+        Clock::time_point now() const override {
+            return Clock::time_point(Clock::duration(now_.load(std::memory_order_acquire)));
+        }
+
+        void set(Clock::time_point when) { now_.store(when.time_since_epoch().count(), std::memory_order_release); }
+        void advance(Clock::duration by) { now_.fetch_add(by.count(), std::memory_order_acq_rel); }
+
+        // Moves forward to `when`; a time already passed (e.g. Tree::nextWakeup() being due now) leaves it as is
+        void advanceTo(Clock::time_point when) {
+            Clock::rep target = when.time_since_epoch().count();
+            Clock::rep current = now_.load(std::memory_order_relaxed);
+            while (current < target && !now_.compare_exchange_weak(current, target, std::memory_order_acq_rel)) {
+            }
+        }
+
+      private:
+        std::atomic<Clock::rep> now_;
+    };
+
+    // ============================================================================
+    // TickTime - the time of the tick in progress
+    //
+    // Tree::tick() and StateMachine::tick() install one on the ticking thread for the duration of the tick. The
+    // first now() samples the owner's clock and later calls in the same tick return that sample, so every timed
+    // node sees the same instant. A scope without a clock defers to the enclosing one (a tree ticked from a state's
+    // onUpdate runs on its machine's clock) or, outermost, to the steady clock. Parallel and the state machine
+    // carry the sample onto executor threads. Outside any tick, now() reads the steady clock.
+    // ============================================================================
+    class TickTime {
+      public:
+        using Clock = TickClock::Clock;
+
+        explicit TickTime(const TickClock *clock) : clock_(clock), previous_(current_) { current_ = this; }
+        // A time already sampled, e.g. by the thread that dispatched this work
+        explicit TickTime(Clock::time_point now) : now_(now), previous_(current_) { current_ = this; }
+        ~TickTime() { current_ = previous_; }
+        TickTime(const TickTime &) = delete;
+        TickTime &operator=(const TickTime &) = delete;
+
+        static Clock::time_point now() {
+            TickTime *time = current_;
+            return time ? time->sample() : Clock::now();
+        }
+
+      private:
+        Clock::time_point sample() {
+            if (!now_)
+                now_ = clock_ ? clock_->now() : previous_ ? previous_->sample() : Clock::now();
+            return *now_;
+        }
+
+        const TickClock *clock_ = nullptr;
+        std::optional<Clock::time_point> now_;
+        TickTime *previous_;
+
+        inline static thread_local TickTime *current_ = nullptr;
+    };
+
+} // namespace stateup::tree
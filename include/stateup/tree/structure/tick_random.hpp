@@ -0,0 +1,67 @@
+#pragma once
+#include "stateup/core/random.hpp"
+#include <atomic>
+#include <cstdint>
+#include <random>
+
+namespace stateup::tree {
+
+    // ============================================================================
+    // TickRandom - the random seed of the tick in progress
+    //
+    // Stochastic nodes (RandomSelector, ProbabilitySelector, WeightedRandomSelector) and the state machine's weighted
+    // and probabilistic transitions each own a core::RandomStream and draw from it under the seed of whatever is
+    // ticking them. Tree::tick(), TreeInstance::tick() and StateMachine::tick() install one of these with the
+    // owner's seed: a fresh one per owner unless set, so a thousand agents built alike still pick differently.
+    // Executor jobs carry the seed like they carry TickTime, and since every node draws from its own counter-based
+    // stream, a seeded owner makes the same picks however its children are scheduled. Outside any tick, nodes draw
+    // under a per-process seed.
+    //
+    // A node's stream number defaults to its construction order on the constructing thread; Builder numbers the
+    // stochastic nodes of each tree it builds from 0, so two trees built the same way and given the same seed pick
+    // the same way.
+    // ============================================================================
+    class TickRandom {
+      public:
+        explicit TickRandom(std::uint64_t seed) : seed_(seed), previous_(current_) { current_ = this; }
+        ~TickRandom() { current_ = previous_; }
+        TickRandom(const TickRandom &) = delete;
+        TickRandom &operator=(const TickRandom &) = delete;
+
+        static std::uint64_t seed() {
+            TickRandom *random = current_;
+            return random ? random->seed_ : processSeed();
+        }
+
+        // `stream` under the seed of the tick in progress
+        static core::RandomStream &engine(core::RandomStream &stream) {
+            stream.seed(seed());
+            return stream;
+        }
+
+        // Stream number for a stochastic node being constructed
+        static std::uint64_t nextStream() { return nextStream_++; }
+
+        // Default seed for a new tree or state machine: distinct per call, different from run to run
+        static std::uint64_t freshSeed() {
+            static std::atomic<std::uint64_t> owners{0};
+            return core::splitmix64(processSeed() + owners.fetch_add(1, std::memory_order_relaxed));
+        }
+
+      private:
+        static std::uint64_t processSeed() {
+            static const std::uint64_t seed = [] {
+                std::random_device device;
+                return (static_cast<std::uint64_t>(device()) << 32) ^ device();
+            }();
+            return seed;
+        }
+
+        std::uint64_t seed_;
+        TickRandom *previous_;
+
+        inline static thread_local TickRandom *current_ = nullptr;
+        inline static thread_local std::uint64_t nextStream_ = 0;
+    };
+
+} // namespace stateup::tree
@@ -0,0 +1,221 @@
+#pragma once
+#include "tick_clock.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace stateup::tree {
+
+    // ============================================================================
+    // Wakeup - tells a tree's host loop when the next tick can make progress
+    //
+    // Each Tree owns one and binds it to its blackboard. During a tick, nodes that are still running say why they
+    // are waiting: a time they must be ticked again (scheduleAt), "as soon as possible" (pollAgain, the default for
+    // actions that can only be polled), or a notify() that some other thread will send when work completes
+    // (expectNotify). Tree::tickWhenReady() sleeps on it until the earliest of those.
+    // ============================================================================
+    class Wakeup {
+      public:
+        using Clock = std::chrono::steady_clock;
+
+        // Any thread: the next tick should happen now
+        void notify() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                notified_ = true;
+            }
+            cv_.notify_all();
+        }
+
+        // During a tick: tick again no later than `when`
+        void scheduleAt(Clock::time_point when) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!deadline_ || when < *deadline_)
+                deadline_ = when;
+        }
+
+        // During a tick: this node cannot tell when it will progress, so tick again right away
+        void pollAgain() { pollRequested_.store(true, std::memory_order_relaxed); }
+
+        // During a tick: this node is waiting for a notify() and needs no timer
+        void expectNotify() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            waiting_ = true;
+        }
+
+        // Polling interval for actions that return std::future, which cannot notify
+        void setFuturePollInterval(Clock::duration interval) { futurePollInterval_ = interval; }
+        Clock::duration futurePollInterval() const { return futurePollInterval_; }
+
+        // Earliest time the next tick can make progress; nullopt if only a notify() can wake the tree
+        std::optional<Clock::time_point> next() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (notified_)
+                return Clock::time_point::min();
+            return deadline_;
+        }
+
+        // Blocks until notified, the scheduled time passes or `limit` passes. Returns false only on `limit`.
+        bool wait(std::optional<Clock::time_point> limit = std::nullopt) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!notified_) {
+                const auto now = Clock::now();
+                if (deadline_ && now >= *deadline_)
+                    return true;
+                if (limit && now >= *limit)
+                    return false;
+                std::optional<Clock::time_point> until = deadline_;
+                if (limit && (!until || *limit < *until))
+                    until = limit;
+                if (until)
+                    cv_.wait_until(lock, *until);
+                else
+                    cv_.wait(lock);
+            }
+            return true;
+        }
+
+        // Called by the tree around each tick: forget the previous tick's reasons, then, if the tree is still
+        // running but no node registered one, fall back to polling
+        void beginTick() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            notified_ = false;
+            waiting_ = false;
+            pollRequested_.store(false, std::memory_order_relaxed);
+            deadline_.reset();
+        }
+
+        void endTick(bool running) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running || pollRequested_.load(std::memory_order_relaxed) || (!deadline_ && !waiting_))
+                deadline_ = Clock::time_point::min();
+        }
+
+      private:
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        bool notified_ = false;
+        bool waiting_ = false;
+        std::atomic<bool> pollRequested_{false};
+        std::optional<Clock::time_point> deadline_ = Clock::time_point::min(); // a new tree is ready to tick
+        Clock::duration futurePollInterval_ = std::chrono::milliseconds(1);
+    };
+
+    // ============================================================================
+    // Signal - one-shot completion flag a coroutine action can co_await
+    //
+    // Copies share state, so hand one to a callback or worker thread and call fire() when the work is done. The
+    // awaiting action is not resumed until then, and fire() wakes the tree that is waiting on it.
+    //
+    //   .actionTask([](Blackboard &bb) -> task<Status> {
+    //       Signal arrived;
+    //       robot.moveTo(goal, [arrived]() mutable { arrived.fire(); });
+    //       co_await arrived;
+    //       co_return Status::Success;
+    //   })
+    // ============================================================================
+    class Signal {
+      public:
+        struct State {
+            std::atomic<bool> fired{false};
+            std::mutex mutex;
+            std::weak_ptr<Wakeup> waiter;
+        };
+
+        Signal() : state_(std::make_shared<State>()) {}
+
+        // Any thread
+        void fire() {
+            std::shared_ptr<Wakeup> waiter;
+            {
+                std::lock_guard<std::mutex> lock(state_->mutex);
+                state_->fired.store(true, std::memory_order_release);
+                waiter = state_->waiter.lock();
+            }
+            if (waiter)
+                waiter->notify();
+        }
+
+        bool fired() const { return state_->fired.load(std::memory_order_acquire); }
+
+        // Re-arm for another wait
+        void reset() { state_->fired.store(false, std::memory_order_release); }
+
+        // Registers the wakeup to notify on fire(); returns false if it already fired
+        bool watch(const std::shared_ptr<Wakeup> &wakeup) const {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            state_->waiter = wakeup;
+            return !state_->fired.load(std::memory_order_relaxed);
+        }
+
+        const std::shared_ptr<State> &state() const { return state_; }
+
+        struct Awaiter;
+        Awaiter operator co_await() const;
+
+      private:
+        std::shared_ptr<State> state_;
+    };
+
+    // Why a coroutine action is suspended. Action points `current` at its slot while it resumes the coroutine;
+    // the awaitables below fill it in, and Action skips resuming until the slot is due.
+    struct Park {
+        using Clock = Wakeup::Clock;
+
+        Clock::time_point until = Clock::time_point::min();
+        std::shared_ptr<Signal::State> signal;
+        const std::shared_ptr<Wakeup> *wakeup = nullptr; // of the tree being ticked, may be null
+
+        bool parked() const { return signal || until != Clock::time_point::min(); }
+        bool due(Clock::time_point now) const {
+            return signal ? signal->fired.load(std::memory_order_acquire) : now >= until;
+        }
+        void clear() {
+            until = Clock::time_point::min();
+            signal.reset();
+        }
+
+        inline static thread_local Park *current = nullptr;
+    };
+
+    struct Signal::Awaiter {
+        Signal signal;
+
+        bool await_ready() const noexcept { return signal.fired(); }
+        bool await_suspend(std::coroutine_handle<>) const {
+            Park *park = Park::current;
+            if (!park)
+                return true;
+            if (park->wakeup && *park->wakeup && !signal.watch(*park->wakeup))
+                return false; // fired in between
+            park->signal = signal.state();
+            return true;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    inline Signal::Awaiter Signal::operator co_await() const { return Awaiter{*this}; }
+
+    // co_await sleepUntil(t) / sleepFor(d) in a coroutine action: not resumed before the time, and the tree's
+    // host loop can sleep until then. Times are on the tree's clock (see TickTime).
+    struct SleepAwaiter {
+        Wakeup::Clock::time_point until;
+
+        bool await_ready() const noexcept { return TickTime::now() >= until; }
+        void await_suspend(std::coroutine_handle<>) const noexcept {
+            if (Park *park = Park::current)
+                park->until = until;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    inline SleepAwaiter sleepUntil(Wakeup::Clock::time_point until) { return SleepAwaiter{until}; }
+    inline SleepAwaiter sleepFor(Wakeup::Clock::duration duration) {
+        return SleepAwaiter{TickTime::now() + duration};
+    }
+
+} // namespace stateup::tree
@@ -0,0 +1,126 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace stateup::tree {
+
+    // ============================================================================
+    // TickMonitor - tick latency, jitter and deadline misses of a tree
+    //
+    // Keeps the durations and start-to-start periods of the last `window` ticks in fixed ring buffers, so recording
+    // does not allocate. stats() computes percentiles over that window; counts cover every recorded tick. Ticks
+    // given a deadline that finish after it are misses and are reported to the overrun callback, if any.
+    //
+    //   tree.monitor().setOverrunCallback([](const TickMonitor::Overrun &o) { log(o.late); });
+    //   while (running) { tree.tick(Clock::now() + 1ms); ... }
+    //   auto s = tree.monitor().stats();   // s.p99, s.jitter, s.misses
+    // ============================================================================
+    class TickMonitor {
+      public:
+        using Clock = std::chrono::steady_clock;
+        using Duration = std::chrono::nanoseconds;
+
+        struct Overrun {
+            std::uint64_t tick;  // index of the tick since monitoring started
+            Duration duration;   // how long the tick took
+            Duration late;       // how far past its deadline it finished
+        };
+        using OverrunCallback = std::function<void(const Overrun &)>;
+
+        struct Stats {
+            std::uint64_t ticks = 0;         // all recorded ticks
+            std::uint64_t deadlineTicks = 0; // ticks that had a deadline
+            std::uint64_t misses = 0;        // ticks that finished after their deadline
+            // Tick duration over the window
+            Duration p50{0}, p90{0}, p99{0}, max{0}, mean{0};
+            // Standard deviation of the start-to-start period over the window
+            Duration jitter{0};
+        };
+
+        explicit TickMonitor(size_t window = 1024)
+            : durations_(std::max<size_t>(window, 1)), periods_(durations_.size()) {}
+
+        void record(Clock::time_point start, Clock::time_point end,
+                    std::optional<Clock::time_point> deadline = std::nullopt) {
+            const Duration duration = std::chrono::duration_cast<Duration>(end - start);
+            durations_[ticks_ % durations_.size()] = duration;
+            if (lastStart_) {
+                periods_[periodCount_ % periods_.size()] = std::chrono::duration_cast<Duration>(start - *lastStart_);
+                ++periodCount_;
+            }
+            lastStart_ = start;
+
+            if (deadline) {
+                ++deadlineTicks_;
+                if (end > *deadline) {
+                    ++misses_;
+                    if (onOverrun_)
+                        onOverrun_(Overrun{ticks_, duration, std::chrono::duration_cast<Duration>(end - *deadline)});
+                }
+            }
+            ++ticks_;
+        }
+
+        Stats stats() const {
+            Stats s;
+            s.ticks = ticks_;
+            s.deadlineTicks = deadlineTicks_;
+            s.misses = misses_;
+
+            const size_t n = static_cast<size_t>(std::min<std::uint64_t>(ticks_, durations_.size()));
+            if (n > 0) {
+                std::vector<Duration> sorted(durations_.begin(), durations_.begin() + static_cast<std::ptrdiff_t>(n));
+                std::sort(sorted.begin(), sorted.end());
+                auto at = [&](double q) { return sorted[static_cast<size_t>(q * static_cast<double>(n - 1) + 0.5)]; };
+                s.p50 = at(0.50);
+                s.p90 = at(0.90);
+                s.p99 = at(0.99);
+                s.max = sorted.back();
+                Duration total{0};
+                for (Duration d : sorted) {
+                    total += d;
+                }
+                s.mean = total / static_cast<std::int64_t>(n);
+            }
+
+            const size_t m = static_cast<size_t>(std::min<std::uint64_t>(periodCount_, periods_.size()));
+            if (m > 1) {
+                double mean = 0.0;
+                for (size_t i = 0; i < m; ++i) {
+                    mean += static_cast<double>(periods_[i].count());
+                }
+                mean /= static_cast<double>(m);
+                double variance = 0.0;
+                for (size_t i = 0; i < m; ++i) {
+                    const double d = static_cast<double>(periods_[i].count()) - mean;
+                    variance += d * d;
+                }
+                s.jitter = Duration(static_cast<Duration::rep>(std::sqrt(variance / static_cast<double>(m))));
+            }
+            return s;
+        }
+
+        void setOverrunCallback(OverrunCallback callback) { onOverrun_ = std::move(callback); }
+
+        void clear() {
+            ticks_ = deadlineTicks_ = misses_ = periodCount_ = 0;
+            lastStart_.reset();
+        }
+
+      private:
+        std::vector<Duration> durations_;
+        std::vector<Duration> periods_;
+        std::uint64_t ticks_ = 0;
+        std::uint64_t deadlineTicks_ = 0;
+        std::uint64_t misses_ = 0;
+        std::uint64_t periodCount_ = 0;
+        std::optional<Clock::time_point> lastStart_;
+        OverrunCallback onOverrun_;
+    };
+
+} // namespace stateup::tree
@@ -1,7 +1,14 @@
 #pragma once
 #include "structure/blackboard.hpp"
 #include "structure/node.hpp"
+#include "structure/tick_budget.hpp"
+#include "structure/tick_clock.hpp"
+#include "structure/tick_random.hpp"
+#include "structure/wakeup.hpp"
+#include "tick_monitor.hpp"
+#include <chrono>
 #include <memory>
+#include <optional>
 
 // Forward declare EventBus to avoid heavy include
 namespace stateup::tree {
@@ -12,24 +19,66 @@ namespace stateup::tree {
 
     class Tree {
       public:
-        explicit Tree(NodePtr root);
+        explicit Tree(NodePtr root, LockPolicy lockPolicy = LockPolicy::Mutex);
 
         Status tick();
+        // Tick that stops starting new work once `deadline` passes: Sequence, Selector, WhileNode and ForNode return
+        // Running where they are and resume there on the next tick (see TickBudget)
+        Status tick(Wakeup::Clock::time_point deadline);
+        Status tickWithin(Wakeup::Clock::duration budget) { return tick(Wakeup::Clock::now() + budget); }
         void reset();
         void halt();
 
+        // Sleep until a running action can make progress (a Signal fired, a sleepFor()/sleepUntil() or polling
+        // deadline passed, or wake() was called), then tick. `maxWait` bounds the sleep, e.g. for Timeout
+        // decorators, which only see time pass when ticked. It sleeps in real time; with a SimulatedClock, advance
+        // the clock to nextWakeup() and tick() instead.
+        Status tickWhenReady(std::optional<Wakeup::Clock::duration> maxWait = std::nullopt);
+
+        // When the next tick can make progress: time_point::min() if already due, nullopt if only a Signal or
+        // wake() can wake the tree
+        std::optional<Wakeup::Clock::time_point> nextWakeup() const { return wakeup_->next(); }
+
+        // Make the next tickWhenReady() tick now, e.g. after writing the blackboard from outside
+        void wake() { wakeup_->notify(); }
+        const std::shared_ptr<Wakeup> &wakeup() const { return wakeup_; }
+
         Blackboard &blackboard();
         const Blackboard &blackboard() const;
         NodePtr getRoot() const;
 
+        // Blackboard locking strategy; LockPolicy::None also makes Parallel tick its children inline
+        void setLockPolicy(LockPolicy policy) { blackboard_.setLockPolicy(policy); }
+        LockPolicy lockPolicy() const { return blackboard_.lockPolicy(); }
+
         // Event bus access
         EventBus &events();
         const EventBus &events() const;
 
+        // Clock that timed nodes read, sampled once per tick (see TickTime); null for the steady clock. Tick deadlines
+        // and the monitor always use real time.
+        void setClock(std::shared_ptr<TickClock> clock) { clock_ = std::move(clock); }
+        const std::shared_ptr<TickClock> &clock() const { return clock_; }
+
+        // Seed that random selectors draw under (see TickRandom); fresh for every tree unless set
+        void setSeed(std::uint64_t seed) { seed_ = seed; }
+        std::uint64_t seed() const { return seed_; }
+
+        // Tick duration, jitter and deadline-miss statistics; created on first use, ticks are recorded from then on
+        TickMonitor &monitor();
+        bool monitoring() const { return monitor_ != nullptr; }
+
       private:
-        NodePtr root_;
+        Status tickRoot(const TickBudget *budget);
+
         Blackboard blackboard_;
         std::shared_ptr<EventBus> eventBus_;
+        std::shared_ptr<Wakeup> wakeup_;
+        std::unique_ptr<TickMonitor> monitor_;
+        std::shared_ptr<TickClock> clock_;
+        std::uint64_t seed_ = TickRandom::freshSeed();
+        // Destroyed first: concurrent Parallel nodes wait for their jobs, which tick on blackboard_
+        NodePtr root_;
     };
 
     // Alias for backward compatibility with howto.md examples
@@ -0,0 +1,149 @@
+#pragma once
+#include <any>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace stateup::tree {
+
+    // Binary codec for one blackboard value type
+    struct TypeCodec {
+        using Encode = std::function<void(const std::any &value, std::vector<std::uint8_t> &out)>;
+        using Decode = std::function<std::any(const std::uint8_t *data, size_t size)>; // empty any = malformed
+
+        std::string name;  // stable, user-facing type name (e.g. "double", "robot::Pose")
+        std::uint32_t id;  // FNV-1a hash of name, written into snapshots
+        std::type_index type;
+        Encode encode;
+        Decode decode;
+    };
+
+    // Maps std::type_index to binary codecs so blackboard values can be snapshotted and restored.
+    // Register custom types once at startup; lookups are not synchronized against registration.
+    class TypeRegistry {
+      public:
+        TypeRegistry() = default;
+
+        // Registry pre-populated with arithmetic types and std::string
+        static TypeRegistry &defaults() {
+            static TypeRegistry registry = withBuiltins();
+            return registry;
+        }
+
+        // Trivially copyable types are stored as their raw bytes (native byte order)
+        template <typename T> void registerType(std::string name) {
+            static_assert(std::is_trivially_copyable_v<T>, "registerType<T>(name) requires a trivially copyable T");
+            add(TypeCodec{
+                std::move(name), 0, std::type_index(typeid(T)),
+                [](const std::any &value, std::vector<std::uint8_t> &out) {
+                    const T &typed = *std::any_cast<T>(&value);
+                    const auto *bytes = reinterpret_cast<const std::uint8_t *>(&typed);
+                    out.insert(out.end(), bytes, bytes + sizeof(T));
+                },
+                [](const std::uint8_t *data, size_t size) -> std::any {
+                    if (size != sizeof(T))
+                        return {};
+                    T typed;
+                    std::memcpy(&typed, data, sizeof(T));
+                    return typed;
+                }});
+        }
+
+        // Custom codec for any other type
+        template <typename T>
+        void registerType(std::string name, std::function<void(const T &, std::vector<std::uint8_t> &)> encode,
+                          std::function<bool(const std::uint8_t *, size_t, T &)> decode) {
+            add(TypeCodec{std::move(name), 0, std::type_index(typeid(T)),
+                          [encode = std::move(encode)](const std::any &value, std::vector<std::uint8_t> &out) {
+                              encode(*std::any_cast<T>(&value), out);
+                          },
+                          [decode = std::move(decode)](const std::uint8_t *data, size_t size) -> std::any {
+                              T typed{};
+                              if (!decode(data, size, typed))
+                                  return {};
+                              return typed;
+                          }});
+        }
+
+        const TypeCodec *find(std::type_index type) const {
+            auto it = byType_.find(type);
+            return it == byType_.end() ? nullptr : &codecs_[it->second];
+        }
+
+        const TypeCodec *find(std::uint32_t id) const {
+            auto it = byId_.find(id);
+            return it == byId_.end() ? nullptr : &codecs_[it->second];
+        }
+
+        size_t size() const { return codecs_.size(); }
+
+        static std::uint32_t hashName(const std::string &name) {
+            std::uint32_t hash = 2166136261u;
+            for (unsigned char c : name) {
+                hash ^= c;
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+      private:
+        void add(TypeCodec codec) {
+            codec.id = hashName(codec.name);
+            auto idIt = byId_.find(codec.id);
+            if (idIt != byId_.end() && codecs_[idIt->second].type != codec.type) {
+                throw std::invalid_argument("TypeRegistry: type name '" + codec.name + "' collides with '" +
+                                            codecs_[idIt->second].name + "'");
+            }
+            auto typeIt = byType_.find(codec.type);
+            if (typeIt != byType_.end()) {
+                // Re-registering a type replaces its codec
+                byId_.erase(codecs_[typeIt->second].id);
+                byId_[codec.id] = typeIt->second;
+                codecs_[typeIt->second] = std::move(codec);
+                return;
+            }
+            byType_.emplace(codec.type, codecs_.size());
+            byId_.emplace(codec.id, codecs_.size());
+            codecs_.push_back(std::move(codec));
+        }
+
+        static TypeRegistry withBuiltins() {
+            TypeRegistry registry;
+            registry.registerType<bool>("bool");
+            registry.registerType<char>("char");
+            registry.registerType<signed char>("signed char");
+            registry.registerType<unsigned char>("unsigned char");
+            registry.registerType<short>("short");
+            registry.registerType<unsigned short>("unsigned short");
+            registry.registerType<int>("int");
+            registry.registerType<unsigned int>("unsigned int");
+            registry.registerType<long>("long");
+            registry.registerType<unsigned long>("unsigned long");
+            registry.registerType<long long>("long long");
+            registry.registerType<unsigned long long>("unsigned long long");
+            registry.registerType<float>("float");
+            registry.registerType<double>("double");
+            registry.registerType<std::string>(
+                "string",
+                [](const std::string &value, std::vector<std::uint8_t> &out) {
+                    out.insert(out.end(), value.begin(), value.end());
+                },
+                [](const std::uint8_t *data, size_t size, std::string &value) {
+                    value.assign(reinterpret_cast<const char *>(data), size);
+                    return true;
+                });
+            return registry;
+        }
+
+        std::vector<TypeCodec> codecs_;
+        std::unordered_map<std::type_index, size_t> byType_;
+        std::unordered_map<std::uint32_t, size_t> byId_;
+    };
+
+} // namespace stateup::tree
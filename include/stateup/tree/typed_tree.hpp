@@ -0,0 +1,159 @@
+#pragma once
+#include "builder.hpp"
+#include "tree.hpp"
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace stateup::tree {
+
+    // ============================================================================
+    // Typed context - compile-time keyed data for hot trees
+    //
+    // A TypedTree<Context> owns a user struct and binds it to its blackboard. Callbacks take Context& (or
+    // Context& and Blackboard& when they also need dynamic keys) and touch members directly: no string
+    // hashing, no std::any, no runtime type checks beyond one type_info compare per call.
+    //
+    //   struct Robot { double speed = 0; int waypoint = 0; };
+    //   auto tree = TypedBuilder<Robot>()
+    //                   .sequence()
+    //                       .action([](Robot &r) { r.speed = 1.0; return Status::Success; })
+    //                   .end()
+    //                   .build();
+    //   tree.tick();
+    //   tree.context().speed; // 1.0
+    // ============================================================================
+
+    // Adapt a Context callback to the Blackboard callback signature used by nodes, states and transitions.
+    // f may take (Context&) or (Context&, Blackboard&); the result type is passed through.
+    template <typename Context, typename F> auto contextual(F func) {
+        return [func = std::move(func)](Blackboard &blackboard) mutable -> decltype(auto) {
+            Context &context = blackboard.context<Context>();
+            if constexpr (std::is_invocable_v<F &, Context &, Blackboard &>)
+                return func(context, blackboard);
+            else
+                return func(context);
+        };
+    }
+
+    template <typename Context> class TypedTree : public Tree {
+      public:
+        explicit TypedTree(NodePtr root, LockPolicy lockPolicy = LockPolicy::Mutex, Context context = {})
+            : Tree(std::move(root), lockPolicy), context_(std::move(context)) {
+            blackboard().bindContext(&context_);
+        }
+
+        Context &context() { return context_; }
+        const Context &context() const { return context_; }
+
+      private:
+        Context context_;
+    };
+
+    // Builder whose callbacks receive the typed context. Mirrors the tree Builder; anything not forwarded
+    // here is reachable through builder().
+    template <typename Context> class TypedBuilder {
+      public:
+        using Branch = std::function<void(TypedBuilder &)>;
+
+        TypedBuilder() = default;
+        TypedBuilder(const TypedBuilder &) = delete;
+        TypedBuilder &operator=(const TypedBuilder &) = delete;
+
+        // Callbacks taking (Context&) or (Context&, Blackboard&); plain Blackboard callbacks pass through
+        template <typename F> TypedBuilder &action(F func) {
+            builder_->action(adapt(std::move(func)));
+            return *this;
+        }
+
+        template <typename Pred> TypedBuilder &condition(Pred pred, Branch thenBranch, Branch elseBranch = nullptr) {
+            builder_->condition(adapt(std::move(pred)), branch(std::move(thenBranch)), branch(std::move(elseBranch)));
+            return *this;
+        }
+
+        template <typename Pred> TypedBuilder &whileLoop(Pred pred, Branch body, int maxIterations = -1) {
+            builder_->whileLoop(adapt(std::move(pred)), branch(std::move(body)), maxIterations);
+            return *this;
+        }
+
+        TypedBuilder &sequence() { return forward(&Builder::sequence); }
+        TypedBuilder &selector() { return forward(&Builder::selector); }
+        TypedBuilder &reactiveSequence() { return forward(&Builder::reactiveSequence); }
+        TypedBuilder &conditionalSequence() { return forward(&Builder::conditionalSequence); }
+        TypedBuilder &dynamicSelector() { return forward(&Builder::dynamicSelector); }
+        TypedBuilder &oneShotSequence() { return forward(&Builder::oneShotSequence); }
+        TypedBuilder &inverter() { return forward(&Builder::inverter); }
+        TypedBuilder &succeeder() { return forward(&Builder::succeeder); }
+        TypedBuilder &failer() { return forward(&Builder::failer); }
+        TypedBuilder &end() { return forward(&Builder::end); }
+
+        TypedBuilder &parallel(Parallel::Policy successPolicy, Parallel::Policy failurePolicy) {
+            builder_->parallel(successPolicy, failurePolicy);
+            return *this;
+        }
+        TypedBuilder &parallel(size_t successThreshold, std::optional<size_t> failureThreshold = std::nullopt) {
+            builder_->parallel(successThreshold, failureThreshold);
+            return *this;
+        }
+        TypedBuilder &decorator(Decorator::Func func) {
+            builder_->decorator(std::move(func));
+            return *this;
+        }
+        TypedBuilder &repeat(int maxTimes = -1) {
+            builder_->repeat(maxTimes);
+            return *this;
+        }
+        TypedBuilder &retry(int maxTimes = -1) {
+            builder_->retry(maxTimes);
+            return *this;
+        }
+        TypedBuilder &subtree(NodePtr subtreeRoot) {
+            builder_->subtree(std::move(subtreeRoot));
+            return *this;
+        }
+        TypedBuilder &executor(stateup::core::ThreadPool *pool) {
+            builder_->executor(pool);
+            return *this;
+        }
+        TypedBuilder &lockPolicy(LockPolicy policy) {
+            builder_->lockPolicy(policy);
+            lockPolicy_ = policy;
+            return *this;
+        }
+
+        Builder &builder() { return *builder_; }
+
+        TypedTree<Context> build(Context context = {}) {
+            return TypedTree<Context>(builder_->buildRoot(), lockPolicy_, std::move(context));
+        }
+
+      private:
+        explicit TypedBuilder(Builder &target) : builder_(&target) {}
+
+        TypedBuilder &forward(Builder &(Builder::*method)()) {
+            (builder_->*method)();
+            return *this;
+        }
+
+        template <typename F> static auto adapt(F func) {
+            if constexpr (std::is_invocable_v<F &, Blackboard &>)
+                return func;
+            else
+                return contextual<Context>(std::move(func));
+        }
+
+        static std::function<void(Builder &)> branch(Branch body) {
+            if (!body)
+                return nullptr;
+            return [body = std::move(body)](Builder &target) {
+                TypedBuilder typed(target);
+                body(typed);
+            };
+        }
+
+        Builder own_;
+        Builder *builder_ = &own_;
+        LockPolicy lockPolicy_ = LockPolicy::Mutex;
+    };
+
+} // namespace stateup::tree
@@ -0,0 +1,108 @@
+#pragma once
+#include "structure/blackboard.hpp"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stateup::tree {
+
+    // ============================================================================
+    // ResponseCurve - maps a raw input to a utility in [0, 1]
+    //
+    // linear:    slope * x + intercept
+    // logistic:  1 / (1 + exp(-steepness * (x - midpoint)))
+    // piecewise: straight lines between (x, y) points sorted by x, flat beyond the first and last
+    // ============================================================================
+    class ResponseCurve {
+      public:
+        enum class Kind : std::uint8_t { Linear, Logistic, Piecewise };
+
+        static ResponseCurve linear(float slope = 1.0f, float intercept = 0.0f);
+        static ResponseCurve logistic(float midpoint = 0.5f, float steepness = 10.0f);
+        // Throws std::invalid_argument unless there is at least one point and x is non-decreasing
+        static ResponseCurve piecewise(std::vector<std::pair<float, float>> points);
+
+        float operator()(float x) const;
+
+        Kind kind() const { return kind_; }
+        // Slope and intercept, or midpoint and steepness
+        float a() const { return a_; }
+        float b() const { return b_; }
+        const std::vector<std::pair<float, float>> &points() const { return points_; }
+
+      private:
+        ResponseCurve(Kind kind, float a, float b) : kind_(kind), a_(a), b_(b) {}
+
+        Kind kind_;
+        float a_;
+        float b_;
+        std::vector<std::pair<float, float>> points_;
+    };
+
+    // One factor of an option's utility: a blackboard input (read as float) passed through a curve
+    struct Consideration {
+        std::string input;
+        ResponseCurve curve;
+        float fallback = 0.0f; // input used while the key is missing or not a float; the first one per key counts
+    };
+
+    // ============================================================================
+    // UtilityModel - options scored as the product of their considerations
+    //
+    // Considerations are stored as structure-of-arrays blocks, one per curve kind, and each distinct input key
+    // gets one slot. scoreBatch() scores many agents at once: every consideration is a tight loop over agents
+    // with no branch on the curve kind. Linear curves vectorize at -O3; logistic ones vectorize where the
+    // compiler has a vector exp (e.g. -ffast-math with glibc's libmvec). score() is the one-agent case.
+    //
+    //   UtilityModel model;
+    //   model.addOption({{"hunger", ResponseCurve::linear()}, {"food.distance", ResponseCurve::logistic(5, -1)}});
+    //   model.gather(bb, inputs.data());
+    //   model.score(inputs.data(), scores.data());
+    // ============================================================================
+    class UtilityModel {
+      public:
+        // Returns the option's index; an option without considerations always scores 1
+        size_t addOption(const std::vector<Consideration> &considerations);
+
+        size_t optionCount() const { return optionCount_; }
+        // Distinct input keys, in order of first use; input slot i holds inputs()[i]
+        const std::vector<std::string> &inputs() const { return inputKeys_; }
+        size_t inputCount() const { return inputKeys_.size(); }
+
+        // Reads every input from the blackboard into inputs[slot * stride]
+        void gather(const Blackboard &blackboard, float *inputs, size_t stride = 1) const;
+
+        // inputs[inputCount()] -> scores[optionCount()]
+        void score(const float *inputs, float *scores) const { scoreBatch(inputs, 1, scores); }
+        // Input-major inputs[slot * agents + agent] -> option-major scores[option * agents + agent]
+        void scoreBatch(const float *inputs, size_t agents, float *scores) const;
+
+      private:
+        size_t inputSlot(const std::string &key, float fallback);
+
+        // linear and logistic: parameters a, b per consideration
+        struct Block {
+            std::vector<std::uint32_t> input;
+            std::vector<std::uint32_t> option;
+            std::vector<float> a;
+            std::vector<float> b;
+        };
+        // piecewise: the points of consideration i are [begin[i], begin[i + 1])
+        struct PiecewiseBlock {
+            std::vector<std::uint32_t> input;
+            std::vector<std::uint32_t> option;
+            std::vector<std::uint32_t> begin{0};
+            std::vector<float> x;
+            std::vector<float> y;
+        };
+
+        Block linear_;
+        Block logistic_;
+        PiecewiseBlock piecewise_;
+        std::vector<std::string> inputKeys_;
+        std::vector<float> fallbacks_;
+        size_t optionCount_ = 0;
+    };
+
+} // namespace stateup::tree
@@ -45,6 +45,8 @@ namespace stateup::state {
     }
 
     void StateMachine::tick() {
+        tree::TickTime time(clock_.get());
+        tree::TickRandom random(seed_);
         if (!currentState_) {
             if (initialState_) {
                 transitionTo(initialState_);
@@ -62,135 +64,158 @@ namespace stateup::state {
             info.fromState = currentState_->name();
             info.toState = currentState_->name();
             info.transitionInfo = "";
-            info.timestamp = std::chrono::steady_clock::now();
+            info.timestamp = tree::TickTime::now();
             info.guardPassed = true;
             info.priority = 0;
             notifyDebug(info);
         }
 
-        // Check for transitions - evaluate conditions in parallel then pick highest priority
-        auto possibleTransitions = getTransitionsFrom(currentState_);
-        if (possibleTransitions.empty()) {
-            return;
-        }
-
-        // Pre-validate and filter ignored; keep indices for stable mapping
-        std::vector<size_t> indices;
-        indices.reserve(possibleTransitions.size());
-        for (size_t i = 0; i < possibleTransitions.size(); ++i) {
-            const auto &tr = possibleTransitions[i];
+        // Check for transitions - evaluate conditions (inline or in parallel) then pick highest priority.
+        // Candidates and results live in member scratch vectors so a steady-state tick does not allocate.
+        candidates_.clear();
+        for (const auto &tr : transitions_) {
+            if (tr->from() != currentState_)
+                continue;
             if (tr->cannotHappen()) {
                 tr->validate(); // will throw
             }
-            if (tr->isIgnored()) {
-                continue;
-            }
-            indices.push_back(i);
+            if (!tr->isIgnored())
+                candidates_.push_back(tr.get());
         }
-        if (indices.empty()) {
+        if (candidates_.empty()) {
             return;
         }
-        std::vector<char> results(possibleTransitions.size(), 0);
+        const auto &possibleTransitions = candidates_;
+        results_.assign(candidates_.size(), 0);
+        auto &results = results_;
 
         // Determine max priority to allow correct early-stop when found
         int maxPriority = std::numeric_limits<int>::min();
-        for (size_t idx : indices) {
-            maxPriority = std::max(maxPriority, possibleTransitions[idx]->getPriority());
+        for (const Transition *tr : candidates_) {
+            maxPriority = std::max(maxPriority, tr->getPriority());
         }
 
-        static stateup::core::ThreadPool defaultPool;
-        stateup::core::ThreadPool *pool = executor_ ? executor_ : &defaultPool;
         std::atomic<bool> stop{false};
-        pool->bulk_early_stop(
-            [&](size_t k) -> bool {
-                if (stop.load(std::memory_order_relaxed))
-                    return true;
-                size_t idx = indices[k];
-                bool ok = possibleTransitions[idx]->shouldTransition(blackboard_);
-                results[idx] = ok ? 1 : 0;
-                // Only do early stop for non-probabilistic/non-weighted transitions
-                if (ok && possibleTransitions[idx]->getPriority() == maxPriority &&
-                    !possibleTransitions[idx]->isProbabilistic()) {
-                    // Found the best possible transition; safe to stop further work
-                    return false; // signal stop
-                }
+        auto evaluate = [&](size_t idx) -> bool {
+            if (stop.load(std::memory_order_relaxed))
                 return true;
-            },
-            indices.size(), stop);
-
-        // Collect valid transitions
-        std::vector<size_t> validIndices;
-        for (size_t i = 0; i < possibleTransitions.size(); ++i) {
-            if (results[i]) {
-                validIndices.push_back(i);
+            const Transition *tr = possibleTransitions[idx];
+            bool ok = tr->conditionCost().run([&] { return tr->shouldTransition(blackboard_); });
+            results[idx] = ok ? 1 : 0;
+            // Only do early stop for non-probabilistic/non-weighted transitions
+            if (ok && tr->getPriority() == maxPriority && !tr->isProbabilistic()) {
+                // Found the best possible transition; safe to stop further work
+                return false; // signal stop
+            }
+            return true;
+        };
+
+        // Cheap conditions run inline; the executor only gets the expensive (or not yet measured) ones, and only
+        // when there are at least two of them. An unsynchronized blackboard keeps everything on the ticking thread.
+        pooled_.clear();
+        if (blackboard_.lockPolicy() != tree::LockPolicy::None) {
+            for (size_t idx = 0; idx < possibleTransitions.size(); ++idx) {
+                if (possibleTransitions[idx]->conditionCost().expensive(poolThreshold_))
+                    pooled_.push_back(idx);
             }
+            if (pooled_.size() < 2)
+                pooled_.clear();
         }
-
-        if (validIndices.empty()) {
-            return;
+        for (size_t idx = 0, next = 0; idx < possibleTransitions.size(); ++idx) {
+            if (next < pooled_.size() && pooled_[next] == idx) {
+                ++next;
+                continue;
+            }
+            if (!evaluate(idx)) {
+                stop.store(true, std::memory_order_relaxed);
+                break;
+            }
+        }
+        if (!pooled_.empty() && !stop.load(std::memory_order_relaxed)) {
+            stateup::core::ThreadPool *pool = executor_ ? executor_ : &stateup::core::defaultPool();
+            const auto now = tree::TickTime::now();
+            const std::uint64_t seed = tree::TickRandom::seed();
+            pool->bulk_early_stop(
+                [&](size_t k) {
+                    tree::TickTime time(now);
+                    tree::TickRandom random(seed);
+                    return evaluate(pooled_[k]);
+                },
+                pooled_.size(), stop);
         }
 
-        size_t chosen = static_cast<size_t>(-1);
-
-        // Separate probabilistic/weighted from non-probabilistic
-        std::vector<size_t> weightedIndices;
-        std::vector<size_t> probabilisticIndices;
-        std::vector<size_t> normalIndices;
-
-        for (size_t idx : validIndices) {
+        // Classify valid transitions: non-probabilistic ones take precedence over weighted, then probabilistic
+        bool anyValid = false, anyNormal = false, anyWeighted = false, anyProbabilistic = false;
+        for (size_t idx = 0; idx < possibleTransitions.size(); ++idx) {
+            if (!results[idx])
+                continue;
+            anyValid = true;
             if (possibleTransitions[idx]->getWeight().has_value()) {
-                weightedIndices.push_back(idx);
+                anyWeighted = true;
             } else if (possibleTransitions[idx]->getProbability().has_value()) {
-                probabilisticIndices.push_back(idx);
+                anyProbabilistic = true;
             } else {
-                normalIndices.push_back(idx);
+                anyNormal = true;
             }
         }
 
-        // Non-probabilistic transitions take precedence
-        if (!normalIndices.empty()) {
+        if (!anyValid) {
+            return;
+        }
+
+        size_t chosen = static_cast<size_t>(-1);
+
+        if (anyNormal) {
             // Pick highest priority among normal transitions
             int bestPriority = std::numeric_limits<int>::min();
-            for (size_t idx : normalIndices) {
-                int pr = possibleTransitions[idx]->getPriority();
+            for (size_t idx = 0; idx < possibleTransitions.size(); ++idx) {
+                const Transition *tr = possibleTransitions[idx];
+                if (!results[idx] || tr->isProbabilistic())
+                    continue;
+                int pr = tr->getPriority();
                 if (pr > bestPriority) {
                     bestPriority = pr;
                     chosen = idx;
                 }
             }
-        } else if (!weightedIndices.empty()) {
-            // Weighted random selection
-            thread_local std::mt19937 rng(std::random_device{}());
-            float totalWeight = 0.0f;
-            for (size_t idx : weightedIndices) {
-                totalWeight += possibleTransitions[idx]->getWeight().value();
+        } else if (anyWeighted) {
+            // Weighted random selection: O(1) from an alias table that only changes with the valid set or weights
+            weighted_.clear();
+            bool stale = false;
+            for (size_t idx = 0; idx < possibleTransitions.size(); ++idx) {
+                const Transition *tr = possibleTransitions[idx];
+                if (!results[idx] || !tr->getWeight().has_value())
+                    continue;
+                const size_t k = weighted_.size();
+                weighted_.push_back(idx);
+                stale = stale || k >= sampledTransitions_.size() || sampledTransitions_[k] != tr ||
+                        sampledWeights_[k] != tr->getWeight().value();
             }
-
-            if (totalWeight <= 0.0f) {
-                // All weights are zero, pick first one
-                chosen = weightedIndices[0];
-            } else {
-                std::uniform_real_distribution<float> dist(0.0f, totalWeight);
-                float random = dist(rng);
-                float cumulative = 0.0f;
-
-                for (size_t idx : weightedIndices) {
-                    cumulative += possibleTransitions[idx]->getWeight().value();
-                    if (random <= cumulative) {
-                        chosen = idx;
-                        break;
-                    }
+            if (stale || weighted_.size() != sampledTransitions_.size()) {
+                sampledTransitions_.clear();
+                sampledWeights_.clear();
+                for (size_t idx : weighted_) {
+                    sampledTransitions_.push_back(possibleTransitions[idx]);
+                    sampledWeights_.push_back(possibleTransitions[idx]->getWeight().value());
                 }
+                weightedSampler_.build(sampledWeights_);
             }
-        } else if (!probabilisticIndices.empty()) {
+
+            // All weights are zero, pick first one
+            if (weightedSampler_.empty())
+                chosen = weighted_.front();
+            else
+                chosen = weighted_[weightedSampler_.sample(tree::TickRandom::engine(rng_))];
+        } else if (anyProbabilistic) {
             // Probability-based selection - each transition tested independently in order
-            thread_local std::mt19937 rng(std::random_device{}());
             std::uniform_real_distribution<float> dist(0.0f, 1.0f);
 
-            for (size_t idx : probabilisticIndices) {
+            for (size_t idx = 0; idx < possibleTransitions.size(); ++idx) {
+                if (!results[idx])
+                    continue;
                 float prob = possibleTransitions[idx]->getProbability().value();
                 if (prob > 0.0f) {
-                    float roll = dist(rng);
+                    float roll = dist(tree::TickRandom::engine(rng_));
                     if (roll < prob) {
                         chosen = idx;
                         break;
@@ -198,23 +223,13 @@ namespace stateup::state {
                 }
             }
             // If no transition succeeded, chosen remains -1 (stay in current state)
-        } else {
-            // Pick highest priority among transitions (fallback)
-            int bestPriority = std::numeric_limits<int>::min();
-            for (size_t idx : validIndices) {
-                int pr = possibleTransitions[idx]->getPriority();
-                if (pr > bestPriority) {
-                    bestPriority = pr;
-                    chosen = idx;
-                }
-            }
         }
 
         if (chosen != static_cast<size_t>(-1)) {
-            auto &transition = possibleTransitions[chosen];
+            const Transition *transition = possibleTransitions[chosen];
 
             // Determine transition reason
-            std::string reason = "condition";
+            const char *reason = "condition";
             if (transition->isTimedTransition()) {
                 reason = "timed";
             } else if (transition->getWeight().has_value()) {
@@ -229,6 +244,8 @@ namespace stateup::state {
     }
 
     void StateMachine::reset() {
+        tree::TickTime time(clock_.get());
+        tree::TickRandom random(seed_);
         if (currentState_) {
             currentState_->onExit(blackboard_);
         }
@@ -246,7 +263,7 @@ namespace stateup::state {
 
     void StateMachine::transitionTo(const StatePtr &newState) { transitionTo(newState, "condition"); }
 
-    void StateMachine::transitionTo(const StatePtr &newState, const std::string &reason) {
+    void StateMachine::transitionTo(const StatePtr &newState, const char *reason) {
         if (!newState) {
             return;
         }
@@ -260,7 +277,7 @@ namespace stateup::state {
                 info.fromState = currentState_ ? currentState_->name() : "";
                 info.toState = newState->name();
                 info.transitionInfo = reason;
-                info.timestamp = std::chrono::steady_clock::now();
+                info.timestamp = tree::TickTime::now();
                 info.guardPassed = false;
                 info.priority = 0;
                 notifyDebug(info);
@@ -268,7 +285,9 @@ namespace stateup::state {
             return;
         }
 
-        std::string fromStateName = currentState_ ? currentState_->name() : "";
+        static const std::string noState;
+        const StatePtr fromState = currentState_;
+        const std::string &fromStateName = fromState ? fromState->name() : noState;
 
         // Exit current state
         if (currentState_) {
@@ -279,7 +298,7 @@ namespace stateup::state {
                 info.fromState = currentState_->name();
                 info.toState = newState->name();
                 info.transitionInfo = reason;
-                info.timestamp = std::chrono::steady_clock::now();
+                info.timestamp = tree::TickTime::now();
                 info.guardPassed = true;
                 info.priority = 0;
                 notifyDebug(info);
@@ -296,7 +315,7 @@ namespace stateup::state {
             TransitionRecord record;
             record.fromState = fromStateName;
             record.toState = newState->name();
-            record.timestamp = std::chrono::steady_clock::now();
+            record.timestamp = tree::TickTime::now();
             record.reason = reason;
 
             if (transitionHistory_.size() >= MAX_TRANSITION_HISTORY) {
@@ -312,7 +331,7 @@ namespace stateup::state {
             info.fromState = fromStateName;
             info.toState = newState->name();
             info.transitionInfo = reason;
-            info.timestamp = std::chrono::steady_clock::now();
+            info.timestamp = tree::TickTime::now();
             info.guardPassed = true;
             info.priority = 0;
             notifyDebug(info);
@@ -329,7 +348,7 @@ namespace stateup::state {
             info.fromState = fromStateName;
             info.toState = newState->name();
             info.transitionInfo = reason;
-            info.timestamp = std::chrono::steady_clock::now();
+            info.timestamp = tree::TickTime::now();
             info.guardPassed = true;
             info.priority = 0;
             notifyDebug(info);
@@ -338,11 +357,21 @@ namespace stateup::state {
         // Start timers for the new state
         startTimersForState(newState);
 
-        // FIX: Add to history
-        if (stateHistory_.size() >= MAX_HISTORY) {
-            stateHistory_.erase(stateHistory_.begin());
+        if (historySize_ < MAX_HISTORY) {
+            stateHistory_[(historyStart_ + historySize_++) % MAX_HISTORY] = newState;
+        } else {
+            stateHistory_[historyStart_] = newState;
+            historyStart_ = (historyStart_ + 1) % MAX_HISTORY;
+        }
+    }
+
+    std::vector<std::string> StateMachine::getStateHistory() const {
+        std::vector<std::string> names;
+        names.reserve(historySize_);
+        for (size_t i = 0; i < historySize_; ++i) {
+            names.push_back(stateHistory_[(historyStart_ + i) % MAX_HISTORY]->name());
         }
-        stateHistory_.push_back(newState->name());
+        return names;
     }
 
     void StateMachine::notifyDebug(const DebugInfo &info) {
@@ -352,18 +381,16 @@ namespace stateup::state {
     }
 
     void StateMachine::startTimersForState(const StatePtr &state) {
-        auto transitions = getTransitionsFrom(state);
-        for (auto &transition : transitions) {
-            if (transition->isTimedTransition()) {
+        for (auto &transition : transitions_) {
+            if (transition->from() == state && transition->isTimedTransition()) {
                 transition->startTimer();
             }
         }
     }
 
     void StateMachine::resetTimersForState(const StatePtr &state) {
-        auto transitions = getTransitionsFrom(state);
-        for (auto &transition : transitions) {
-            if (transition->isTimedTransition()) {
+        for (auto &transition : transitions_) {
+            if (transition->from() == state && transition->isTimedTransition()) {
                 transition->resetTimer();
             }
         }
@@ -371,18 +398,10 @@ namespace stateup::state {
 
     void StateMachine::transitionToPrevious() {
         if (previousState_) {
+            tree::TickTime time(clock_.get());
+            tree::TickRandom random(seed_);
             transitionTo(previousState_);
         }
     }
 
-    std::vector<TransitionPtr> StateMachine::getTransitionsFrom(const StatePtr &state) const {
-        std::vector<TransitionPtr> result;
-        for (const auto &transition : transitions_) {
-            if (transition->from() == state) {
-                result.push_back(transition);
-            }
-        }
-        return result;
-    }
-
 } // namespace stateup::state
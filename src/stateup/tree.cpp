@@ -3,26 +3,78 @@
 
 namespace stateup::tree {
 
-    Tree::Tree(NodePtr root) : root_(std::move(root)), eventBus_(std::make_shared<EventBus>()) {}
+    Tree::Tree(NodePtr root, LockPolicy lockPolicy)
+        : blackboard_(lockPolicy), eventBus_(std::make_shared<EventBus>()), wakeup_(std::make_shared<Wakeup>()),
+          root_(std::move(root)) {
+        blackboard_.setWakeup(wakeup_);
+    }
 
     Status Tree::tick() {
+        if (!root_)
+            return Status::Failure;
+        if (!monitor_)
+            return tickRoot(nullptr);
+
+        const auto start = TickMonitor::Clock::now();
+        Status status = tickRoot(nullptr);
+        monitor_->record(start, TickMonitor::Clock::now());
+        return status;
+    }
+
+    Status Tree::tick(Wakeup::Clock::time_point deadline) {
         if (!root_)
             return Status::Failure;
 
+        const auto start = monitor_ ? TickMonitor::Clock::now() : TickMonitor::Clock::time_point{};
+        Status status;
+        {
+            TickBudget budget(deadline);
+            status = tickRoot(&budget);
+        }
+        if (monitor_)
+            monitor_->record(start, TickMonitor::Clock::now(), deadline);
+        return status;
+    }
+
+    Status Tree::tickRoot(const TickBudget *budget) {
         if (root_->state() == Node::State::Halted)
             root_->reset();
 
-        return root_->tick(blackboard_);
+        TickTime time(clock_.get());
+        TickRandom random(seed_);
+        wakeup_->beginTick();
+        Status status = root_->tick(blackboard_);
+        // Work cut short by the deadline can continue right away
+        if (budget && budget->yielded())
+            wakeup_->pollAgain();
+        wakeup_->endTick(status == Status::Running);
+        return status;
+    }
+
+    TickMonitor &Tree::monitor() {
+        if (!monitor_)
+            monitor_ = std::make_unique<TickMonitor>();
+        return *monitor_;
+    }
+
+    Status Tree::tickWhenReady(std::optional<Wakeup::Clock::duration> maxWait) {
+        std::optional<Wakeup::Clock::time_point> limit;
+        if (maxWait)
+            limit = Wakeup::Clock::now() + *maxWait;
+        wakeup_->wait(limit);
+        return tick();
     }
 
     void Tree::reset() {
         if (root_)
             root_->reset();
+        wakeup_->notify();
     }
 
     void Tree::halt() {
         if (root_)
             root_->halt();
+        wakeup_->notify();
     }
 
     Blackboard &Tree::blackboard() { return blackboard_; }
@@ -0,0 +1,192 @@
+#include "stateup/tree/blackboard_replication.hpp"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace stateup::tree {
+
+    namespace {
+
+        constexpr char kFrameMagic[4] = {'S', 'U', 'B', 'D'};
+
+        template <typename T> void writeScalar(std::uint8_t *data, T value) { std::memcpy(data, &value, sizeof(T)); }
+
+        template <typename T> T readScalar(const std::uint8_t *data) {
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            return value;
+        }
+
+    } // namespace
+
+    // ------------------------------------------------------------------------
+    // DeltaEncoder
+    // ------------------------------------------------------------------------
+
+    bool DeltaEncoder::encode(const Blackboard &blackboard, std::vector<std::uint8_t> &out) {
+        // Read the structure revision before the pass: a removal racing with it is caught by the next frame
+        const std::uint64_t structure = blackboard.structureRevision();
+        const bool keyframe = forceKeyframe_ || structure != structureRevision_ ||
+                              (keyframeInterval_ != 0 && sinceKeyframe_ >= keyframeInterval_);
+
+        out.clear();
+        out.resize(kFrameHeaderSize);
+        std::uint32_t records = 0;
+        revision_ = blackboard.forEachChangedSince(
+            keyframe ? 0 : revision_, [&](const std::string &key, const std::any &value, std::type_index type) {
+                if (BlackboardSerializer::appendRecord(out, key, value, type, *registry_))
+                    ++records;
+            });
+
+        std::memcpy(out.data(), kFrameMagic, sizeof(kFrameMagic));
+        writeScalar<std::uint32_t>(out.data() + 4, kFrameVersion);
+        writeScalar<std::uint64_t>(out.data() + 8, ++sequence_);
+        writeScalar<std::uint32_t>(out.data() + 16, keyframe ? kKeyframe : 0u);
+        writeScalar<std::uint32_t>(out.data() + 20, records);
+
+        structureRevision_ = structure;
+        forceKeyframe_ = false;
+        sinceKeyframe_ = keyframe ? 1 : sinceKeyframe_ + 1;
+        return keyframe;
+    }
+
+    // ------------------------------------------------------------------------
+    // BlackboardFollower
+    // ------------------------------------------------------------------------
+
+    bool BlackboardFollower::apply(const std::uint8_t *data, size_t size) {
+        if (size < DeltaEncoder::kFrameHeaderSize || std::memcmp(data, kFrameMagic, sizeof(kFrameMagic)) != 0) {
+            throw std::runtime_error("Blackboard frame: missing or invalid header");
+        }
+        if (readScalar<std::uint32_t>(data + 4) != DeltaEncoder::kFrameVersion) {
+            throw std::runtime_error("Blackboard frame: unsupported version");
+        }
+        const auto sequence = readScalar<std::uint64_t>(data + 8);
+        const bool keyframe = (readScalar<std::uint32_t>(data + 16) & DeltaEncoder::kKeyframe) != 0;
+        const auto count = readScalar<std::uint32_t>(data + 20);
+
+        if (!keyframe && (!synchronized_ || sequence != lastSequence_ + 1)) {
+            // A delta is only meaningful on top of its predecessor; wait for the next keyframe
+            synchronized_ = false;
+            return false;
+        }
+
+        std::vector<Blackboard::RawEntry> entries;
+        size_t skipped = 0;
+        BlackboardSerializer::readRecords(data + DeltaEncoder::kFrameHeaderSize,
+                                          size - DeltaEncoder::kFrameHeaderSize, count, *registry_, entries, skipped);
+        if (keyframe)
+            blackboard_.clear();
+        blackboard_.setEntries(std::move(entries));
+
+        lastSequence_ = sequence;
+        synchronized_ = true;
+        return true;
+    }
+
+    size_t BlackboardFollower::replay(const std::string &filename) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open())
+            return 0;
+        const std::vector<std::uint8_t> stream((std::istreambuf_iterator<char>(file)),
+                                               std::istreambuf_iterator<char>());
+
+        size_t applied = 0;
+        size_t offset = 0;
+        while (stream.size() - offset >= sizeof(std::uint32_t)) {
+            const auto frameSize = readScalar<std::uint32_t>(stream.data() + offset);
+            offset += sizeof(std::uint32_t);
+            if (stream.size() - offset < frameSize)
+                break; // trailing frame still being written
+            if (apply(stream.data() + offset, frameSize))
+                ++applied;
+            offset += frameSize;
+        }
+        return applied;
+    }
+
+    // ------------------------------------------------------------------------
+    // BlackboardReplicator
+    // ------------------------------------------------------------------------
+
+    BlackboardReplicator::BlackboardReplicator(const Blackboard &blackboard, Sink sink, Options options)
+        : blackboard_(blackboard), sink_(std::move(sink)),
+          encoder_(options.registry ? *options.registry : TypeRegistry::defaults(), options.keyframeInterval),
+          ring_(options.ringCapacity == 0 ? 1 : options.ringCapacity) {
+        writer_ = std::thread([this] { writerLoop(); });
+    }
+
+    BlackboardReplicator::~BlackboardReplicator() {
+        stop_.store(true, std::memory_order_release);
+        wake_.fetch_add(1, std::memory_order_release);
+        wake_.notify_one();
+        if (writer_.joinable())
+            writer_.join();
+    }
+
+    bool BlackboardReplicator::capture() {
+        const std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) >= ring_.size()) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (encoder_.encode(blackboard_, ring_[tail % ring_.size()]))
+            keyframes_.fetch_add(1, std::memory_order_relaxed);
+        tail_.store(tail + 1, std::memory_order_release);
+        wake_.fetch_add(1, std::memory_order_release);
+        wake_.notify_one();
+        return true;
+    }
+
+    void BlackboardReplicator::flush() {
+        const std::uint64_t target = tail_.load(std::memory_order_acquire);
+        std::uint64_t head = head_.load(std::memory_order_acquire);
+        while (head < target) {
+            head_.wait(head, std::memory_order_acquire);
+            head = head_.load(std::memory_order_acquire);
+        }
+    }
+
+    BlackboardReplicator::Stats BlackboardReplicator::stats() const {
+        Stats stats;
+        stats.frames = tail_.load(std::memory_order_acquire);
+        stats.keyframes = keyframes_.load(std::memory_order_relaxed);
+        stats.dropped = dropped_.load(std::memory_order_relaxed);
+        stats.bytes = bytes_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void BlackboardReplicator::writerLoop() {
+        std::uint64_t head = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            const std::uint32_t wake = wake_.load(std::memory_order_acquire);
+            const std::uint64_t tail = tail_.load(std::memory_order_acquire);
+            if (head == tail) {
+                if (stop_.load(std::memory_order_acquire))
+                    return;
+                wake_.wait(wake, std::memory_order_acquire);
+                continue;
+            }
+            const auto &frame = ring_[head % ring_.size()];
+            if (sink_)
+                sink_(frame.data(), frame.size());
+            bytes_.fetch_add(frame.size(), std::memory_order_relaxed);
+            head_.store(++head, std::memory_order_release);
+            head_.notify_all();
+        }
+    }
+
+    BlackboardReplicator::Sink BlackboardReplicator::fileSink(const std::string &filename) {
+        auto file = std::make_shared<std::ofstream>(filename, std::ios::binary | std::ios::trunc);
+        if (!file->is_open())
+            throw std::runtime_error("BlackboardReplicator: cannot open '" + filename + "'");
+        return [file](const std::uint8_t *data, size_t size) {
+            const auto frameSize = static_cast<std::uint32_t>(size);
+            file->write(reinterpret_cast<const char *>(&frameSize), sizeof(frameSize));
+            file->write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size));
+            file->flush();
+        };
+    }
+
+} // namespace stateup::tree
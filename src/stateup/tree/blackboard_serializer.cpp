@@ -0,0 +1,201 @@
+#include "stateup/tree/blackboard_serializer.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace stateup::tree {
+
+    namespace {
+
+        constexpr char kSnapshotMagic[4] = {'S', 'U', 'B', 'B'};
+        constexpr size_t kHeaderSize = 16;
+        constexpr size_t kRecordHeaderSize = 12;
+
+        template <typename T> void writeScalar(std::vector<std::uint8_t> &out, T value) {
+            const auto *bytes = reinterpret_cast<const std::uint8_t *>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+
+        template <typename T> void patchScalar(std::vector<std::uint8_t> &out, size_t offset, T value) {
+            std::memcpy(out.data() + offset, &value, sizeof(T));
+        }
+
+        template <typename T> T readScalar(const std::uint8_t *data) {
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            return value;
+        }
+
+        // RAII wrapper around an mmap'ed file region
+        class MappedFile {
+          public:
+            MappedFile() = default;
+            MappedFile(const MappedFile &) = delete;
+            MappedFile &operator=(const MappedFile &) = delete;
+            ~MappedFile() {
+                if (data_ && data_ != MAP_FAILED)
+                    ::munmap(data_, size_);
+                if (fd_ >= 0)
+                    ::close(fd_);
+            }
+
+            bool openForWrite(const std::string &filename, size_t size) {
+                fd_ = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+                if (fd_ < 0 || ::ftruncate(fd_, static_cast<off_t>(size)) != 0)
+                    return false;
+                return map(size, PROT_READ | PROT_WRITE);
+            }
+
+            bool openForRead(const std::string &filename) {
+                fd_ = ::open(filename.c_str(), O_RDONLY);
+                struct stat info{};
+                if (fd_ < 0 || ::fstat(fd_, &info) != 0)
+                    return false;
+                return map(static_cast<size_t>(info.st_size), PROT_READ);
+            }
+
+            std::uint8_t *data() const { return static_cast<std::uint8_t *>(data_); }
+            size_t size() const { return size_; }
+
+          private:
+            bool map(size_t size, int protection) {
+                size_ = size;
+                if (size_ == 0)
+                    return true;
+                data_ = ::mmap(nullptr, size_, protection, MAP_SHARED, fd_, 0);
+                if (data_ == MAP_FAILED) {
+                    data_ = nullptr;
+                    return false;
+                }
+                return true;
+            }
+
+            int fd_ = -1;
+            void *data_ = nullptr;
+            size_t size_ = 0;
+        };
+
+    } // namespace
+
+    bool BlackboardSerializer::appendRecord(std::vector<std::uint8_t> &out, const std::string &key,
+                                            const std::any &value, std::type_index type,
+                                            const TypeRegistry &registry) {
+        const TypeCodec *codec = registry.find(type);
+        if (!codec)
+            return false;
+        const size_t start = out.size();
+        writeScalar<std::uint32_t>(out, 0); // record size, patched below
+        writeScalar<std::uint32_t>(out, codec->id);
+        writeScalar<std::uint32_t>(out, static_cast<std::uint32_t>(key.size()));
+        out.insert(out.end(), key.begin(), key.end());
+        codec->encode(value, out);
+        const size_t recordSize = out.size() - start - sizeof(std::uint32_t);
+        patchScalar<std::uint32_t>(out, start, static_cast<std::uint32_t>(recordSize));
+        return true;
+    }
+
+    size_t BlackboardSerializer::readRecords(const std::uint8_t *data, size_t size, std::uint64_t count,
+                                             const TypeRegistry &registry, std::vector<Blackboard::RawEntry> &entries,
+                                             size_t &skipped) {
+        entries.reserve(entries.size() +
+                        static_cast<size_t>(std::min<std::uint64_t>(count, size / kRecordHeaderSize)));
+
+        size_t offset = 0;
+        for (std::uint64_t i = 0; i < count; ++i) {
+            if (size - offset < sizeof(std::uint32_t)) {
+                throw std::runtime_error("Blackboard snapshot: truncated record");
+            }
+            const auto recordSize = readScalar<std::uint32_t>(data + offset);
+            const size_t body = offset + sizeof(std::uint32_t);
+            if (recordSize < kRecordHeaderSize - sizeof(std::uint32_t) || size - body < recordSize) {
+                throw std::runtime_error("Blackboard snapshot: truncated record");
+            }
+            const auto typeId = readScalar<std::uint32_t>(data + body);
+            const auto keySize = readScalar<std::uint32_t>(data + body + 4);
+            const size_t keyOffset = body + 8;
+            if (keySize > recordSize - 8) {
+                throw std::runtime_error("Blackboard snapshot: key exceeds record");
+            }
+            offset = body + recordSize;
+
+            const TypeCodec *codec = registry.find(typeId);
+            if (!codec) {
+                ++skipped;
+                continue;
+            }
+            const size_t payloadOffset = keyOffset + keySize;
+            std::any value = codec->decode(data + payloadOffset, offset - payloadOffset);
+            if (!value.has_value()) {
+                throw std::runtime_error("Blackboard snapshot: malformed value for type '" + codec->name + "'");
+            }
+            entries.push_back(Blackboard::RawEntry{
+                std::string(reinterpret_cast<const char *>(data + keyOffset), keySize), std::move(value), codec->type});
+        }
+        return offset;
+    }
+
+    std::vector<std::uint8_t> BlackboardSerializer::snapshot(const Blackboard &blackboard,
+                                                             const TypeRegistry &registry, SnapshotStats *stats) {
+        SnapshotStats local;
+        std::vector<std::uint8_t> out;
+        out.insert(out.end(), kSnapshotMagic, kSnapshotMagic + sizeof(kSnapshotMagic));
+        writeScalar<std::uint32_t>(out, kSnapshotVersion);
+        writeScalar<std::uint64_t>(out, 0); // patched once the record count is known
+
+        blackboard.forEachEntry([&](const std::string &key, const std::any &value, std::type_index type) {
+            if (appendRecord(out, key, value, type, registry))
+                ++local.records;
+            else
+                ++local.skipped;
+        });
+
+        patchScalar<std::uint64_t>(out, 8, local.records);
+        if (stats)
+            *stats = local;
+        return out;
+    }
+
+    BlackboardSerializer::SnapshotStats BlackboardSerializer::restore(Blackboard &blackboard, const std::uint8_t *data,
+                                                                      size_t size, const TypeRegistry &registry) {
+        if (size < kHeaderSize || std::memcmp(data, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0) {
+            throw std::runtime_error("Blackboard snapshot: missing or invalid header");
+        }
+        if (readScalar<std::uint32_t>(data + 4) != kSnapshotVersion) {
+            throw std::runtime_error("Blackboard snapshot: unsupported version");
+        }
+        const auto count = readScalar<std::uint64_t>(data + 8);
+
+        SnapshotStats stats;
+        std::vector<Blackboard::RawEntry> entries;
+        readRecords(data + kHeaderSize, size - kHeaderSize, count, registry, entries, stats.skipped);
+
+        stats.records = entries.size();
+        blackboard.clear();
+        blackboard.setEntries(std::move(entries));
+        return stats;
+    }
+
+    bool BlackboardSerializer::saveSnapshot(const Blackboard &blackboard, const std::string &filename,
+                                            const TypeRegistry &registry) {
+        auto bytes = snapshot(blackboard, registry);
+        MappedFile file;
+        if (!file.openForWrite(filename, bytes.size()))
+            return false;
+        std::memcpy(file.data(), bytes.data(), bytes.size());
+        return ::msync(file.data(), file.size(), MS_SYNC) == 0;
+    }
+
+    bool BlackboardSerializer::loadSnapshot(Blackboard &blackboard, const std::string &filename,
+                                            const TypeRegistry &registry) {
+        MappedFile file;
+        if (!file.openForRead(filename))
+            return false;
+        restore(blackboard, file.data(), file.size(), registry);
+        return true;
+    }
+
+} // namespace stateup::tree
@@ -1,6 +1,7 @@
 #include "stateup/tree/builder.hpp"
 #include "stateup/tree/nodes/advanced.hpp"
 #include "stateup/tree/nodes/control_flow.hpp"
+#include <algorithm>
 #include <string>
 
 namespace stateup::tree {
@@ -10,6 +11,7 @@ namespace stateup::tree {
         auto decorated = applyPendingDecorators(node);
         add(decorated);
         stack_.emplace_back(node);
+        sequences_.push_back(node);
         return *this;
     }
 
@@ -21,8 +23,9 @@ namespace stateup::tree {
         return *this;
     }
 
-    Builder &Builder::parallel(Parallel::Policy successPolicy, Parallel::Policy failurePolicy) {
-        auto node = std::make_shared<Parallel>(successPolicy, failurePolicy);
+    Builder &Builder::speculativeSelector() {
+        auto node = std::make_shared<Selector>();
+        node->setSpeculative(true);
         if (executor_)
             node->setExecutor(executor_);
         auto decorated = applyPendingDecorators(node);
@@ -31,8 +34,27 @@ namespace stateup::tree {
         return *this;
     }
 
+    Builder &Builder::parallel(Parallel::Policy successPolicy, Parallel::Policy failurePolicy) {
+        return openParallel(std::make_shared<Parallel>(successPolicy, failurePolicy));
+    }
+
     Builder &Builder::parallel(size_t successThreshold, std::optional<size_t> failureThreshold) {
+        return openParallel(std::make_shared<Parallel>(successThreshold, failureThreshold));
+    }
+
+    Builder &Builder::concurrentParallel(Parallel::Policy successPolicy, Parallel::Policy failurePolicy) {
+        auto node = std::make_shared<Parallel>(successPolicy, failurePolicy);
+        node->setMode(Parallel::Mode::Concurrent);
+        return openParallel(std::move(node));
+    }
+
+    Builder &Builder::concurrentParallel(size_t successThreshold, std::optional<size_t> failureThreshold) {
         auto node = std::make_shared<Parallel>(successThreshold, failureThreshold);
+        node->setMode(Parallel::Mode::Concurrent);
+        return openParallel(std::move(node));
+    }
+
+    Builder &Builder::openParallel(std::shared_ptr<Parallel> node) {
         if (executor_)
             node->setExecutor(executor_);
         auto decorated = applyPendingDecorators(node);
@@ -41,14 +63,16 @@ namespace stateup::tree {
         return *this;
     }
 
-    Builder &Builder::decorator(Decorator::Func func) {
-        decorators_.emplace_back(std::move(func));
+    Builder &Builder::decorator(Decorator::Func func, bool stateless) {
+        decorators_.push_back({std::move(func), stateless});
         return *this;
     }
 
-    Builder &Builder::action(Action::Func func) {
-        NodePtr node = std::make_shared<Action>(std::move(func));
+    Builder &Builder::action(Action::Func func) { return leaf(std::make_shared<Action>(std::move(func))); }
 
+    Builder &Builder::actionTask(Action::TaskFunc func) { return leaf(std::make_shared<Action>(std::move(func))); }
+
+    Builder &Builder::leaf(NodePtr node) {
         // Apply pending repeat decorator
         if (pendingRepeat_ != kNoPendingModifier) {
             node = std::make_shared<RepeatDecorator>(pendingRepeat_, node);
@@ -67,24 +91,13 @@ namespace stateup::tree {
         return *this;
     }
 
-    Builder &Builder::actionTask(Action::TaskFunc func) {
-        NodePtr node = std::make_shared<Action>(std::move(func));
-
-        if (pendingRepeat_ != kNoPendingModifier) {
-            node = std::make_shared<RepeatDecorator>(pendingRepeat_, node);
-            pendingRepeat_ = kNoPendingModifier;
-        }
-        if (pendingRetry_ != kNoPendingModifier) {
-            node = std::make_shared<RetryDecorator>(pendingRetry_, node);
-            pendingRetry_ = kNoPendingModifier;
-        }
-        node = applyPendingDecorators(node);
-        add(node);
+    Builder &Builder::executor(stateup::core::ThreadPool *pool) {
+        executor_ = pool;
         return *this;
     }
 
-    Builder &Builder::executor(stateup::core::ThreadPool *pool) {
-        executor_ = pool;
+    Builder &Builder::lockPolicy(LockPolicy policy) {
+        lockPolicy_ = policy;
         return *this;
     }
 
@@ -98,7 +111,11 @@ namespace stateup::tree {
         return *this;
     }
 
-    Tree Builder::build() {
+    Tree Builder::build() { return Tree(buildRoot(), lockPolicy_); }
+
+    CompiledTree Builder::buildCompiled() { return CompiledTree(buildRoot(), lockPolicy_); }
+
+    NodePtr Builder::buildRoot() {
         ensureNoPendingDecorators("build()");
         ensureNoPendingLeafModifiers("build()");
         if (!stack_.empty()) {
@@ -110,16 +127,66 @@ namespace stateup::tree {
 
         // FIX: Validate the tree structure before building
         validateTree(root_);
+        groupIndependentChildren();
 
-        return Tree(root_);
+        return root_;
+    }
+
+    // Greedily splits each sequence's children into runs where every child declared its keys and is independent
+    // of the others in the run; runs of two or more become a SequenceGroup
+    void Builder::groupIndependentChildren() {
+        if (access_.empty()) {
+            sequences_.clear();
+            return;
+        }
+        for (const auto &sequence : sequences_) {
+            const auto &children = sequence->getChildren();
+            std::vector<NodePtr> grouped;
+            std::vector<NodePtr> run;
+            std::vector<KeyAccess> runAccess;
+            bool changed = false;
+            auto flush = [&] {
+                if (run.size() >= 2) {
+                    auto group = std::make_shared<SequenceGroup>(std::move(run), std::move(runAccess));
+                    if (executor_)
+                        group->setExecutor(executor_);
+                    grouped.push_back(std::move(group));
+                    changed = true;
+                } else if (!run.empty()) {
+                    grouped.push_back(std::move(run.front()));
+                }
+                run.clear();
+                runAccess.clear();
+            };
+            for (const auto &child : children) {
+                auto it = access_.find(child.get());
+                if (it == access_.end()) {
+                    flush();
+                    grouped.push_back(child);
+                    continue;
+                }
+                const KeyAccess &keys = it->second;
+                const bool independent = std::all_of(runAccess.begin(), runAccess.end(),
+                                                     [&](const KeyAccess &other) { return keys.independentOf(other); });
+                if (!independent)
+                    flush();
+                run.push_back(child);
+                runAccess.push_back(keys);
+            }
+            flush();
+            if (changed)
+                sequence->setChildren(std::move(grouped));
+        }
+        sequences_.clear();
+        access_.clear();
     }
 
     // Convenience methods for common decorators
-    Builder &Builder::inverter() { return decorator(decorators::Inverter()); }
+    Builder &Builder::inverter() { return decorator(decorators::Inverter(), true); }
 
-    Builder &Builder::succeeder() { return decorator(decorators::Succeeder()); }
+    Builder &Builder::succeeder() { return decorator(decorators::Succeeder(), true); }
 
-    Builder &Builder::failer() { return decorator(decorators::Failer()); }
+    Builder &Builder::failer() { return decorator(decorators::Failer(), true); }
 
     Builder &Builder::repeat(int maxTimes) {
         // Store the repeat decorator to be applied to the next action
@@ -136,7 +203,7 @@ namespace stateup::tree {
     }
 
     // Control flow nodes implementation
-    Builder &Builder::condition(std::function<bool(Blackboard &)> cond, std::function<void(Builder &)> thenBranch,
+    Builder &Builder::condition(ConditionalNode::ConditionFunc cond, std::function<void(Builder &)> thenBranch,
                                 std::function<void(Builder &)> elseBranch) {
         // Build then branch
         Builder thenBuilder;
@@ -159,7 +226,7 @@ namespace stateup::tree {
         return *this;
     }
 
-    Builder &Builder::whileLoop(std::function<bool(Blackboard &)> condition, std::function<void(Builder &)> body,
+    Builder &Builder::whileLoop(WhileNode::ConditionFunc condition, std::function<void(Builder &)> body,
                                 int maxIterations) {
         // Build loop body
         Builder bodyBuilder;
@@ -188,7 +255,7 @@ namespace stateup::tree {
         return *this;
     }
 
-    Builder &Builder::forLoop(std::function<int(Blackboard &)> countFunc, std::function<void(Builder &)> body) {
+    Builder &Builder::forLoop(ForNode::CountFunc countFunc, std::function<void(Builder &)> body) {
         // Build loop body
         Builder bodyBuilder;
         if (body) {
@@ -202,11 +269,20 @@ namespace stateup::tree {
         return *this;
     }
 
-    Builder &Builder::switchNode(std::function<std::string(Blackboard &)> selector) {
+    Builder &Builder::switchNode(SwitchNode::SelectorFunc selector) {
         currentSwitch_ = std::make_shared<SwitchNode>(std::move(selector));
         return *this;
     }
 
+    Builder &Builder::intSwitch(IntSwitchNode::SelectorFunc selector) {
+        return openIntSwitch(std::make_shared<IntSwitchNode>(std::move(selector)));
+    }
+
+    Builder &Builder::openIntSwitch(std::shared_ptr<IntSwitchNode> node) {
+        currentIntSwitch_ = std::move(node);
+        return *this;
+    }
+
     Builder &Builder::addCase(const std::string &caseValue, std::function<void(Builder &)> body) {
         if (!currentSwitch_) {
             throw std::runtime_error("addCase() must be called after switchNode()");
@@ -223,9 +299,22 @@ namespace stateup::tree {
         return *this;
     }
 
+    Builder &Builder::addCase(std::int64_t caseValue, std::function<void(Builder &)> body) {
+        if (!currentIntSwitch_) {
+            throw std::runtime_error("addCase() with an integer or enum key must follow intSwitch() or enumSwitch()");
+        }
+
+        Builder caseBuilder;
+        if (body) {
+            body(caseBuilder);
+        }
+        currentIntSwitch_->addCase(caseValue, caseBuilder.root_);
+        return *this;
+    }
+
     Builder &Builder::defaultCase(std::function<void(Builder &)> body) {
-        if (!currentSwitch_) {
-            throw std::runtime_error("defaultCase() must be called after switchNode()");
+        if (!currentSwitch_ && !currentIntSwitch_) {
+            throw std::runtime_error("defaultCase() must be called after switchNode(), intSwitch() or enumSwitch()");
         }
 
         // Build default case body
@@ -235,12 +324,19 @@ namespace stateup::tree {
         }
         NodePtr defaultNode = defaultBuilder.root_;
 
-        currentSwitch_->setDefault(defaultNode);
-
         // Add the complete switch node to the tree
-        auto decorated = applyPendingDecorators(currentSwitch_);
+        NodePtr switchNode;
+        if (currentIntSwitch_) {
+            currentIntSwitch_->setDefault(defaultNode);
+            switchNode = std::move(currentIntSwitch_);
+        } else {
+            currentSwitch_->setDefault(defaultNode);
+            switchNode = std::move(currentSwitch_);
+        }
+        auto decorated = applyPendingDecorators(switchNode);
         add(decorated);
         currentSwitch_ = nullptr; // Reset for next switch
+        currentIntSwitch_ = nullptr;
         return *this;
     }
 
@@ -250,6 +346,12 @@ namespace stateup::tree {
         return *this;
     }
 
+    Builder &Builder::cached() {
+        // Queue a CachedNode to wrap the next created node
+        pendingCached_ = true;
+        return *this;
+    }
+
     Builder &Builder::conditionalSequence() {
         auto node = std::make_shared<ConditionalSequence>();
         auto decorated = applyPendingDecorators(node);
@@ -283,6 +385,7 @@ namespace stateup::tree {
 
     Builder &Builder::randomSelector() {
         auto node = std::make_shared<RandomSelector>();
+        node->setRandomStream(nextStream_++);
         auto decorated = applyPendingDecorators(node);
         add(decorated);
         stack_.emplace_back(node);
@@ -291,6 +394,7 @@ namespace stateup::tree {
 
     Builder &Builder::probabilitySelector() {
         auto node = std::make_shared<ProbabilitySelector>();
+        node->setRandomStream(nextStream_++);
         auto decorated = applyPendingDecorators(node);
         add(decorated);
         stack_.emplace_back(node);
@@ -311,11 +415,35 @@ namespace stateup::tree {
         return *this;
     }
 
+    Builder &Builder::access(std::vector<std::string> reads, std::vector<std::string> writes) {
+        // Attach the declared keys to the next created node
+        pendingAccess_ = KeyAccess{std::move(reads), std::move(writes)};
+        return *this;
+    }
+
+    Builder &Builder::pure() {
+        // Mark the next created node as pure for its selector
+        pendingPure_ = true;
+        return *this;
+    }
+
+    Builder &Builder::throttle(ThrottleNode::Duration period) {
+        // Queue a ThrottleNode to wrap the next created node
+        pendingThrottlePeriod_ = period;
+        return *this;
+    }
+
     void Builder::add(const NodePtr &node) {
         // FIX: Validate node before adding
         if (!node) {
             throw std::runtime_error("Cannot add null node to tree");
         }
+        if (pendingAccess_) {
+            access_[node.get()] = std::move(*pendingAccess_);
+            pendingAccess_.reset();
+        }
+        const bool pure = pendingPure_;
+        pendingPure_ = false;
 
         if (stack_.empty()) {
             root_ = node;
@@ -332,7 +460,7 @@ namespace stateup::tree {
                 seq->addChild(node);
                 added = true;
             } else if (auto sel = std::dynamic_pointer_cast<Selector>(parent)) {
-                sel->addChild(node);
+                sel->addChild(node, pure);
                 added = true;
             } else if (auto par = std::dynamic_pointer_cast<Parallel>(parent)) {
                 par->addChild(node);
@@ -367,7 +495,7 @@ namespace stateup::tree {
 
     NodePtr Builder::applyPendingDecorators(NodePtr node) {
         while (!decorators_.empty()) {
-            node = std::make_shared<Decorator>(decorators_.back(), node);
+            node = std::make_shared<Decorator>(std::move(decorators_.back().func), node, decorators_.back().stateless);
             decorators_.pop_back();
         }
         if (pendingMemoryPolicy_) {
@@ -378,6 +506,14 @@ namespace stateup::tree {
             node = std::make_shared<DebounceDecorator>(node, *pendingDebounceTime_);
             pendingDebounceTime_.reset();
         }
+        if (pendingCached_) {
+            node = std::make_shared<CachedNode>(node);
+            pendingCached_ = false;
+        }
+        if (pendingThrottlePeriod_) {
+            node = std::make_shared<ThrottleNode>(node, *pendingThrottlePeriod_);
+            pendingThrottlePeriod_.reset();
+        }
         return node;
     }
 
@@ -394,6 +530,22 @@ namespace stateup::tree {
             throw std::runtime_error(std::string("Cannot ") + context +
                                      ": pending debounce() must wrap a node before closing");
         }
+        if (pendingCached_) {
+            throw std::runtime_error(std::string("Cannot ") + context +
+                                     ": pending cached() must wrap a node before closing");
+        }
+        if (pendingThrottlePeriod_.has_value()) {
+            throw std::runtime_error(std::string("Cannot ") + context +
+                                     ": pending throttle() must wrap a node before closing");
+        }
+        if (pendingAccess_.has_value()) {
+            throw std::runtime_error(std::string("Cannot ") + context +
+                                     ": pending access() must be followed by a node before closing");
+        }
+        if (pendingPure_) {
+            throw std::runtime_error(std::string("Cannot ") + context +
+                                     ": pending pure() must be followed by a node before closing");
+        }
     }
 
     void Builder::ensureNoPendingLeafModifiers(const char *context) const {
@@ -0,0 +1,367 @@
+#include "stateup/tree/compiled_tree.hpp"
+#include "stateup/tree/builder.hpp"
+#include "stateup/tree/nodes/control_flow.hpp"
+#include "stateup/tree/nodes/selector.hpp"
+#include "stateup/tree/nodes/sequence.hpp"
+#include "stateup/tree/structure/tick_budget.hpp"
+#include "stateup/tree/structure/tick_clock.hpp"
+#include <stdexcept>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace stateup::tree {
+
+    namespace {
+
+        // Exact type match: subclasses may override tick() and must keep their own implementation
+        template <typename T> const T *exactly(const NodePtr &node) {
+            const Node &ref = *node;
+            return typeid(ref) == typeid(T) ? static_cast<const T *>(node.get()) : nullptr;
+        }
+
+        // Children of the node types CompiledTree lowers; other nodes are opaque
+        std::vector<NodePtr> loweredChildren(const NodePtr &node) {
+            if (auto seq = exactly<Sequence>(node))
+                return seq->getChildren();
+            // A speculative selector keeps its own tick, which evaluates pure fallbacks concurrently
+            if (auto sel = exactly<Selector>(node); sel && !sel->speculative())
+                return sel->getChildren();
+            if (auto dec = exactly<Decorator>(node); dec && dec->isStateless())
+                return {dec->getChild()};
+            if (auto rep = exactly<RepeatDecorator>(node))
+                return {rep->getChild()};
+            if (auto ret = exactly<RetryDecorator>(node))
+                return {ret->getChild()};
+            if (auto sub = exactly<SubtreeNode>(node)) {
+                if (sub->getSubtree())
+                    return {sub->getSubtree()};
+            }
+            return {};
+        }
+
+        void countReferences(const NodePtr &node, std::unordered_map<const Node *, int> &counts) {
+            if (!node || ++counts[node.get()] > 1)
+                return;
+            for (const auto &child : loweredChildren(node)) {
+                countReferences(child, counts);
+            }
+        }
+
+    } // namespace
+
+    TreeDefinition::Ptr TreeDefinition::compile(const NodePtr &root) {
+        std::shared_ptr<TreeDefinition> definition(new TreeDefinition());
+        if (!root)
+            return definition;
+
+        // A node reachable from two parents shares its run state between them; keep it as one embedded object
+        std::unordered_map<const Node *, int> counts;
+        countReferences(root, counts);
+        std::unordered_set<const Node *> shared;
+        for (const auto &[node, count] : counts) {
+            if (count > 1)
+                shared.insert(node);
+        }
+
+        definition->emit(root, shared);
+        return definition;
+    }
+
+    TreeDefinition::Ptr TreeDefinition::define(std::function<void(Builder &)> describe) {
+        if (!describe)
+            throw std::invalid_argument("TreeDefinition::define requires a describe function");
+
+        Builder builder;
+        describe(builder);
+        std::shared_ptr<TreeDefinition> definition(new TreeDefinition());
+        definition->emit(builder.buildRoot(), {});
+        if (!definition->prototypes_.empty())
+            definition->describe_ = std::move(describe);
+        return definition;
+    }
+
+    void TreeDefinition::emit(const NodePtr &node, const std::unordered_set<const Node *> &shared) {
+        const auto index = static_cast<std::uint32_t>(program_.size());
+        program_.push_back({Op::Embedded, 0, 0, 0});
+        Record record{Op::Embedded, 0, 0, 0};
+        NodePtr child;
+
+        if (shared.count(node.get())) {
+            // embedded below
+        } else if (auto seq = exactly<Sequence>(node)) {
+            record.op = Op::Sequence;
+            record.slot = cursorCount_++;
+            for (const auto &c : seq->getChildren())
+                emit(c, shared);
+        } else if (auto sel = exactly<Selector>(node); sel && !sel->speculative()) {
+            record.op = Op::Selector;
+            record.slot = cursorCount_++;
+            for (const auto &c : sel->getChildren())
+                emit(c, shared);
+        } else if (auto dec = exactly<Decorator>(node); dec && dec->getChild() && dec->isStateless()) {
+            record.op = Op::Decorator;
+            record.slot = static_cast<std::uint32_t>(decorators_.size());
+            decorators_.push_back(&dec->getFunc());
+            lowered_.push_back(node);
+            child = dec->getChild();
+        } else if (auto rep = exactly<RepeatDecorator>(node); rep && rep->getChild()) {
+            record.op = Op::Repeat;
+            record.slot = cursorCount_++;
+            record.limit = rep->getMaxTimes();
+            child = rep->getChild();
+        } else if (auto ret = exactly<RetryDecorator>(node); ret && ret->getChild()) {
+            record.op = Op::Retry;
+            record.slot = cursorCount_++;
+            record.limit = ret->getMaxTimes();
+            child = ret->getChild();
+        } else if (auto sub = exactly<SubtreeNode>(node)) {
+            record.op = Op::Subtree;
+            child = sub->getSubtree();
+        } else if (auto action = exactly<Action>(node); action && action->isSynchronous()) {
+            record.op = Op::Action;
+            record.slot = static_cast<std::uint32_t>(actions_.size());
+            actions_.push_back(&action->getFunc());
+            lowered_.push_back(node);
+        }
+
+        if (record.op == Op::Embedded) {
+            record.slot = static_cast<std::uint32_t>(prototypes_.size());
+            prototypes_.push_back(node);
+        }
+        if (child)
+            emit(child, shared);
+
+        record.end = static_cast<std::uint32_t>(program_.size());
+        program_[index] = record;
+    }
+
+    TreeInstance::TreeInstance(TreeDefinition::Ptr definition, LockPolicy lockPolicy)
+        : blackboard_(lockPolicy), definition_(std::move(definition)) {
+        if (!definition_)
+            throw std::invalid_argument("TreeInstance requires a definition");
+        def_ = definition_.get();
+
+        states_.assign(def_->program_.size(), Node::State::Idle);
+        cursors_.assign(def_->cursorCount_, 0);
+        for (std::uint32_t i = 0; i < states_.size(); ++i) {
+            if (def_->program_[i].op == Op::Sequence || def_->program_[i].op == Op::Selector)
+                cursors_[def_->program_[i].slot] = i + 1;
+        }
+
+        if (!def_->describe_) {
+            // The source tree's nodes hold run state and concurrent jobs; only one instance may tick them
+            if (!def_->prototypes_.empty() && def_->instantiated_.exchange(true))
+                throw std::invalid_argument("TreeInstance: a compiled definition with embedded nodes has one instance");
+            for (const auto &node : def_->prototypes_)
+                embedded_.push_back(node.get());
+        } else {
+            // Rebuild the tree and keep only the nodes the program embeds; emit() visits them in the same order
+            Builder builder;
+            def_->describe_(builder);
+            TreeDefinition fresh;
+            fresh.emit(builder.buildRoot(), {});
+            owned_ = std::move(fresh.prototypes_);
+            for (const auto &node : owned_)
+                embedded_.push_back(node.get());
+        }
+    }
+
+    Status TreeInstance::tick() {
+        if (states_.empty())
+            return Status::Failure;
+
+        const Node::State rootState =
+            def_->program_[0].op == Op::Embedded ? embedded_[def_->program_[0].slot]->state() : states_[0];
+        if (rootState == Node::State::Halted)
+            resetAt(0);
+
+        TickTime time(nullptr); // one clock read per tick, or the enclosing tick's time
+        TickRandom random(seed_);
+        return run(0);
+    }
+
+    Status TreeInstance::tick(std::chrono::steady_clock::time_point deadline) {
+        TickBudget budget(deadline);
+        return tick();
+    }
+
+    void TreeInstance::reset() {
+        if (!states_.empty())
+            resetAt(0);
+    }
+
+    void TreeInstance::halt() {
+        if (!states_.empty())
+            haltAt(0);
+    }
+
+    // Each case mirrors the tick() of the node it was lowered from
+    Status TreeInstance::run(std::uint32_t index) {
+        const Record &record = def_->program_[index];
+        Node::State &state = states_[index];
+
+        switch (record.op) {
+        case Op::Sequence:
+        case Op::Selector: {
+            if (state == Node::State::Halted)
+                return Status::Failure;
+            state = Node::State::Running;
+            std::uint32_t &cursor = cursors_[record.slot];
+
+            // Sequence stops on the first Failure, Selector on the first Success
+            const Status decisive = record.op == Op::Sequence ? Status::Failure : Status::Success;
+            while (cursor < record.end) {
+                Status status = run(cursor);
+                if (status == Status::Running)
+                    return Status::Running;
+                if (status == decisive) {
+                    resetAt(index);
+                    return decisive;
+                }
+                cursor = def_->program_[cursor].end;
+                if (cursor < record.end && TickBudget::exhausted())
+                    return Status::Running;
+            }
+            resetAt(index);
+            return decisive == Status::Failure ? Status::Success : Status::Failure;
+        }
+
+        case Op::Decorator: {
+            if (state == Node::State::Halted)
+                return Status::Failure;
+            state = Node::State::Running;
+            Status result = (*def_->decorators_[record.slot])(run(index + 1));
+            if (result != Status::Running)
+                state = Node::State::Idle;
+            return result;
+        }
+
+        case Op::Repeat: {
+            if (state == Node::State::Halted)
+                return Status::Failure;
+            state = Node::State::Running;
+            std::uint32_t &count = cursors_[record.slot];
+            Status status = run(index + 1);
+            if (status == Status::Running)
+                return Status::Running;
+            if (status == Status::Failure) {
+                resetAt(index);
+                return Status::Failure;
+            }
+            ++count;
+            if (record.limit > 0 && static_cast<std::int32_t>(count) >= record.limit) {
+                resetAt(index);
+                return Status::Success;
+            }
+            resetAt(index + 1);
+            return Status::Running;
+        }
+
+        case Op::Retry: {
+            if (state == Node::State::Halted)
+                return Status::Failure;
+            state = Node::State::Running;
+            std::uint32_t &count = cursors_[record.slot];
+            Status status = run(index + 1);
+            if (status == Status::Running)
+                return Status::Running;
+            if (status == Status::Success) {
+                resetAt(index);
+                return Status::Success;
+            }
+            ++count;
+            resetAt(index + 1);
+            if (record.limit > 0 && static_cast<std::int32_t>(count) >= record.limit) {
+                resetAt(index);
+                return Status::Failure;
+            }
+            return Status::Running;
+        }
+
+        case Op::Subtree:
+            return record.end == index + 1 ? Status::Failure : run(index + 1);
+
+        case Op::Action: {
+            if (state == Node::State::Halted)
+                return Status::Failure;
+            state = Node::State::Running;
+            Status result = (*def_->actions_[record.slot])(blackboard_);
+            if (result != Status::Running)
+                state = Node::State::Idle;
+            return result;
+        }
+
+        case Op::Embedded:
+            return embedded_[record.slot]->tick(blackboard_);
+        }
+        return Status::Failure;
+    }
+
+    void TreeInstance::resetAt(std::uint32_t index) {
+        const Record &record = def_->program_[index];
+        Node::State &state = states_[index];
+
+        switch (record.op) {
+        case Op::Sequence:
+        case Op::Selector:
+            // Only children up to and including the current one have run, and none since an idle reset
+            if (state != Node::State::Idle) {
+                for (std::uint32_t child = index + 1; child < record.end && child <= cursors_[record.slot];
+                     child = def_->program_[child].end) {
+                    resetAt(child);
+                }
+            }
+            state = Node::State::Idle;
+            cursors_[record.slot] = index + 1;
+            break;
+        case Op::Repeat:
+        case Op::Retry:
+            cursors_[record.slot] = 0;
+            [[fallthrough]];
+        case Op::Decorator:
+        case Op::Subtree:
+            state = Node::State::Idle;
+            if (record.end > index + 1)
+                resetAt(index + 1);
+            break;
+        case Op::Action:
+            state = Node::State::Idle;
+            break;
+        case Op::Embedded:
+            embedded_[record.slot]->reset();
+            break;
+        }
+    }
+
+    void TreeInstance::haltAt(std::uint32_t index) {
+        const Record &record = def_->program_[index];
+        Node::State &state = states_[index];
+
+        switch (record.op) {
+        case Op::Sequence:
+        case Op::Selector:
+            // Only the current child can be running
+            if (state == Node::State::Running && cursors_[record.slot] < record.end)
+                haltAt(cursors_[record.slot]);
+            state = Node::State::Halted;
+            break;
+        case Op::Repeat:
+        case Op::Retry:
+            cursors_[record.slot] = 0;
+            [[fallthrough]];
+        case Op::Decorator:
+        case Op::Subtree:
+            state = Node::State::Halted;
+            if (record.end > index + 1)
+                haltAt(index + 1);
+            break;
+        case Op::Action:
+            state = Node::State::Halted;
+            break;
+        case Op::Embedded:
+            embedded_[record.slot]->halt();
+            break;
+        }
+    }
+
+} // namespace stateup::tree
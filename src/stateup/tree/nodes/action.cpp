@@ -14,19 +14,33 @@ namespace stateup::tree {
 
         state_ = State::Running;
 
+        const std::shared_ptr<Wakeup> &wakeup = blackboard.wakeup();
+
         // Prefer coroutine task if provided
         if (taskFunc_) {
             if (!task_.has_value()) {
                 task_ = taskFunc_(blackboard);
+            } else if (park_.parked()) {
+                // Suspended on a timer or signal: don't resume before it is due
+                if (!park_.due(TickTime::now())) {
+                    scheduleWakeup(wakeup);
+                    return Status::Running;
+                }
+                park_.clear();
             }
-            // Advance the coroutine
+            // Advance the coroutine; awaitables record in park_ what it waits for
+            park_.wakeup = &wakeup;
+            Park *outer = std::exchange(Park::current, &park_);
             task_->resume();
+            Park::current = outer;
             if (task_->done()) {
+                park_.clear();
                 auto result = task_->result();
                 task_.reset();
                 state_ = result == Status::Running ? State::Running : State::Idle;
                 return result;
             }
+            scheduleWakeup(wakeup);
             return Status::Running;
         }
 
@@ -41,18 +55,35 @@ namespace stateup::tree {
                 state_ = result == Status::Running ? State::Running : State::Idle;
                 return result;
             }
+            // A future cannot notify anyone, so poll it at the wakeup's interval
+            if (wakeup)
+                wakeup->scheduleAt(TickTime::now() + wakeup->futurePollInterval());
             return Status::Running;
         }
 
         Status result = func_(blackboard);
         if (result != Status::Running) {
             state_ = State::Idle;
+        } else if (wakeup) {
+            wakeup->pollAgain();
         }
         return result;
     }
 
+    void Action::scheduleWakeup(const std::shared_ptr<Wakeup> &wakeup) const {
+        if (!wakeup)
+            return;
+        if (park_.signal)
+            wakeup->expectNotify();
+        else if (park_.parked())
+            wakeup->scheduleAt(park_.until);
+        else
+            wakeup->pollAgain(); // suspended without an awaitable: resume every tick
+    }
+
     void Action::reset() {
         Node::reset();
+        park_.clear();
         if (pending_.valid()) {
             // No standard way to cancel std::future; let it complete in background
         }
@@ -63,6 +94,7 @@ namespace stateup::tree {
 
     void Action::halt() {
         Node::halt();
+        park_.clear();
         if (task_.has_value()) {
             task_.reset();
         }
@@ -1,18 +1,17 @@
 #include <stateup/tree/nodes/advanced.hpp>
+#include <stateup/tree/structure/wakeup.hpp>
+#include <stdexcept>
 
 namespace stateup::tree {
 
-    // Thread-local RNG for RandomSelector
-    thread_local std::mt19937 RandomSelector::rng_(std::random_device{}());
-
-    // Thread-local RNG for ProbabilitySelector
-    thread_local std::mt19937 ProbabilitySelector::rng_(std::random_device{}());
-
     // ============================================================================
     // RandomSelector Implementation
     // ============================================================================
 
-    void RandomSelector::addChild(const NodePtr &child) { children_.push_back(child); }
+    void RandomSelector::addChild(const NodePtr &child) {
+        children_.push_back(child);
+        active_.grow();
+    }
 
     Status RandomSelector::tick(Blackboard &blackboard) {
         if (children_.empty()) {
@@ -22,11 +21,12 @@ namespace stateup::tree {
         // If no child is currently running, pick a random one
         if (currentIndex_ == SIZE_MAX || state_ == State::Idle) {
             std::uniform_int_distribution<size_t> dist(0, children_.size() - 1);
-            currentIndex_ = dist(rng_);
+            currentIndex_ = dist(TickRandom::engine(rng_));
             setState(State::Running);
         }
 
         // Execute the selected child
+        active_.mark(currentIndex_);
         Status childStatus = children_[currentIndex_]->tick(blackboard);
 
         if (childStatus == Status::Success) {
@@ -48,10 +48,10 @@ namespace stateup::tree {
 
     void RandomSelector::reset() {
         Node::reset();
-        for (auto &child : children_) {
-            if (child)
-                child->reset();
-        }
+        active_.drain([this](size_t i) {
+            if (children_[i])
+                children_[i]->reset();
+        });
         currentIndex_ = SIZE_MAX;
     }
 
@@ -71,6 +71,22 @@ namespace stateup::tree {
         // Clamp probability to [0.0, 1.0]
         float clampedProb = std::max(0.0f, std::min(1.0f, probability));
         children_.push_back({child, clampedProb});
+        active_.grow();
+        samplerStale_ = true;
+    }
+
+    // Child i takes the part of the roll above every earlier threshold and up to its own; the last child also
+    // takes whatever lies above all of them
+    void ProbabilitySelector::buildSampler() {
+        std::vector<float> chances(children_.size(), 0.0f);
+        float covered = 0.0f;
+        for (size_t i = 0; i < children_.size(); ++i) {
+            chances[i] = std::max(0.0f, children_[i].probability - covered);
+            covered = std::max(covered, children_[i].probability);
+        }
+        chances.back() += 1.0f - covered;
+        sampler_.build(chances);
+        samplerStale_ = false;
     }
 
     Status ProbabilitySelector::tick(Blackboard &blackboard) {
@@ -80,28 +96,14 @@ namespace stateup::tree {
 
         // If no child is currently running, select one based on probabilities
         if (currentIndex_ == SIZE_MAX || state_ == State::Idle) {
-            std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-            float roll = dist(rng_);
-
-            // Find the first child whose probability threshold is met
-            bool childSelected = false;
-            for (size_t i = 0; i < children_.size(); ++i) {
-                if (roll <= children_[i].probability) {
-                    currentIndex_ = i;
-                    childSelected = true;
-                    break;
-                }
-            }
-
-            // If no child was selected (all probabilities < roll), pick the last one
-            if (!childSelected) {
-                currentIndex_ = children_.size() - 1;
-            }
-
+            if (samplerStale_)
+                buildSampler();
+            currentIndex_ = sampler_.sample(TickRandom::engine(rng_));
             setState(State::Running);
         }
 
         // Execute the selected child
+        active_.mark(currentIndex_);
         Status childStatus = children_[currentIndex_].node->tick(blackboard);
 
         if (childStatus == Status::Success) {
@@ -123,10 +125,10 @@ namespace stateup::tree {
 
     void ProbabilitySelector::reset() {
         Node::reset();
-        for (auto &child : children_) {
-            if (child.node)
-                child.node->reset();
-        }
+        active_.drain([this](size_t i) {
+            if (children_[i].node)
+                children_[i].node->reset();
+        });
         currentIndex_ = SIZE_MAX;
     }
 
@@ -142,7 +144,10 @@ namespace stateup::tree {
     // OneShotSequence Implementation
     // ============================================================================
 
-    void OneShotSequence::addChild(const NodePtr &child) { children_.push_back(child); }
+    void OneShotSequence::addChild(const NodePtr &child) {
+        children_.push_back(child);
+        active_.grow();
+    }
 
     Status OneShotSequence::tick(Blackboard &blackboard) {
         if (children_.empty()) {
@@ -158,6 +163,7 @@ namespace stateup::tree {
             }
 
             // Execute current child
+            active_.mark(currentIndex_);
             Status childStatus = children_[currentIndex_]->tick(blackboard);
 
             if (childStatus == Status::Running) {
@@ -186,10 +192,10 @@ namespace stateup::tree {
 
     void OneShotSequence::reset() {
         Node::reset();
-        for (auto &child : children_) {
-            if (child)
-                child->reset();
-        }
+        active_.drain([this](size_t i) {
+            if (children_[i])
+                children_[i]->reset();
+        });
         currentIndex_ = 0;
         // Note: We don't clear executedChildren_ on reset - that's intentional
         // Use clearExecutionHistory() if you want to allow re-execution
@@ -223,7 +229,7 @@ namespace stateup::tree {
         // Execute child
         Status childStatus = child_->tick(blackboard);
 
-        auto now = Clock::now();
+        auto now = TickTime::now();
 
         // Check if result changed
         if (!lastResult_.has_value() || lastResult_.value() != childStatus) {
@@ -231,6 +237,8 @@ namespace stateup::tree {
             lastResult_ = childStatus;
             lastChangeTime_ = now;
             isStable_ = false;
+            if (const auto &wakeup = blackboard.wakeup())
+                wakeup->scheduleAt(now + debounceTime_);
             setState(State::Running);
             return Status::Running;
         }
@@ -246,6 +254,8 @@ namespace stateup::tree {
                 return childStatus;
             } else {
                 // Still waiting for stability
+                if (const auto &wakeup = blackboard.wakeup())
+                    wakeup->scheduleAt(lastChangeTime_.value() + debounceTime_);
                 setState(State::Running);
                 return Status::Running;
             }
@@ -284,4 +294,54 @@ namespace stateup::tree {
 
     DebounceDecorator::Duration DebounceDecorator::getDebounceTime() const { return debounceTime_; }
 
+    // ============================================================================
+    // ThrottleNode Implementation
+    // ============================================================================
+
+    ThrottleNode::ThrottleNode(NodePtr child, Duration period) : child_(std::move(child)), period_(period) {
+        if (period_ <= Duration::zero()) {
+            throw std::invalid_argument("Throttle period must be positive");
+        }
+    }
+
+    Status ThrottleNode::tick(Blackboard &blackboard) {
+        if (isHalted() || !child_) {
+            return Status::Failure;
+        }
+
+        const auto now = TickTime::now();
+        if (!cached_ || !nextDue_ || now >= *nextDue_) {
+            cached_ = child_->tick(blackboard);
+            // Stay on the period grid; skip periods the host missed rather than catching up
+            nextDue_ = nextDue_ ? *nextDue_ + period_ : now + period_;
+            if (*nextDue_ <= now) {
+                nextDue_ = now + period_;
+            }
+        }
+
+        if (const auto &wakeup = blackboard.wakeup())
+            wakeup->scheduleAt(*nextDue_);
+        setState(*cached_ == Status::Running ? State::Running : State::Idle);
+        return *cached_;
+    }
+
+    // A finished status and the period grid survive reset() and halt(): composites reset their children after
+    // every completion, and the branch must still wait out its period. A running child is reset, so it restarts
+    // on the next tick.
+    void ThrottleNode::reset() {
+        Node::reset();
+        if (child_)
+            child_->reset();
+        if (cached_ == Status::Running)
+            cached_.reset();
+    }
+
+    void ThrottleNode::halt() {
+        Node::halt();
+        if (child_)
+            child_->halt();
+        if (cached_ == Status::Running)
+            cached_.reset();
+    }
+
 } // namespace stateup::tree
@@ -1,4 +1,5 @@
 #include <stateup/tree/nodes/control_flow.hpp>
+#include <stateup/tree/structure/tick_budget.hpp>
 
 namespace stateup::tree {
 
@@ -91,6 +92,10 @@ namespace stateup::tree {
             // Child succeeded, prepare for next iteration
             child_->reset();
             currentIterations_++;
+
+            // Out of tick budget: re-check the condition and continue on the next tick
+            if (TickBudget::exhausted())
+                return Status::Running;
         }
 
         // Condition became false
@@ -177,6 +182,83 @@ namespace stateup::tree {
         activeChild_ = nullptr;
     }
 
+    // ============================================================================
+    // IntSwitchNode Implementation
+    // ============================================================================
+
+    IntSwitchNode::IntSwitchNode(SelectorFunc selector) : selector_(std::move(selector)) {}
+
+    void IntSwitchNode::addCase(std::int64_t caseValue, NodePtr node) {
+        for (const auto &[key, index] : keys_) {
+            if (key == caseValue) {
+                dropIfActive(cases_[index]);
+                cases_[index] = std::move(node);
+                return;
+            }
+        }
+        keys_.emplace_back(caseValue, static_cast<std::uint32_t>(cases_.size()));
+        cases_.push_back(std::move(node));
+        dispatchStale_ = true;
+    }
+
+    void IntSwitchNode::setDefault(NodePtr node) {
+        dropIfActive(defaultNode_);
+        defaultNode_ = std::move(node);
+    }
+
+    // A running branch being replaced is halted while its owner still holds it; the next tick picks a case anew
+    void IntSwitchNode::dropIfActive(const NodePtr &replaced) {
+        if (!activeChild_ || activeChild_ != replaced.get())
+            return;
+        activeChild_->halt();
+        activeChild_->reset();
+        activeChild_ = nullptr;
+        if (state_ == State::Running)
+            setState(State::Idle);
+    }
+
+    Status IntSwitchNode::tick(Blackboard &blackboard) {
+        // Halted until reset, like SwitchNode
+        if (state_ == State::Halted)
+            return Status::Failure;
+
+        // Choose a case unless one is still running
+        if (!activeChild_) {
+            if (dispatchStale_) {
+                dispatch_.build(keys_);
+                dispatchStale_ = false;
+            }
+            const std::uint32_t index = dispatch_.find(select(blackboard));
+            activeChild_ = index != core::IntDispatch::kNone ? cases_[index].get() : defaultNode_.get();
+            if (!activeChild_) {
+                return Status::Failure; // No matching case and no default
+            }
+            setState(State::Running);
+        }
+
+        Status childStatus = activeChild_->tick(blackboard);
+        if (childStatus != Status::Running) {
+            setState(State::Idle);
+            activeChild_ = nullptr;
+        }
+        return childStatus;
+    }
+
+    // Only a running case holds state; finished ones were left Idle by their own tick
+    void IntSwitchNode::reset() {
+        Node::reset();
+        if (activeChild_)
+            activeChild_->reset();
+        activeChild_ = nullptr;
+    }
+
+    // The halted case stays active so that reset() resets it
+    void IntSwitchNode::halt() {
+        Node::halt();
+        if (activeChild_)
+            activeChild_->halt();
+    }
+
     // ============================================================================
     // MemoryNode Implementation
     // ============================================================================
@@ -227,6 +309,49 @@ namespace stateup::tree {
         return false;
     }
 
+    // ============================================================================
+    // CachedNode Implementation
+    // ============================================================================
+
+    CachedNode::CachedNode(NodePtr child) : child_(std::move(child)) {}
+
+    Status CachedNode::tick(Blackboard &blackboard) {
+        if (state_ == State::Halted)
+            return Status::Failure;
+        if (cachedStatus_.has_value() && blackboard.unchanged(reads_)) {
+            blackboard.reportReads(reads_); // an enclosing CachedNode depends on the same keys
+            return cachedStatus_.value();
+        }
+        cachedStatus_.reset();
+
+        Status childStatus;
+        {
+            auto recording = blackboard.recordReads(reads_);
+            childStatus = child_->tick(blackboard);
+        }
+
+        if (childStatus == Status::Success || childStatus == Status::Failure) {
+            cachedStatus_ = childStatus;
+            setState(State::Idle);
+        } else {
+            setState(State::Running);
+        }
+        return childStatus;
+    }
+
+    // The cached status survives reset(): composites reset their children after every completion, and the status
+    // stays valid for as long as the inputs do. A halt drops it, so the child runs again once the node is reset.
+    void CachedNode::reset() {
+        Node::reset();
+        child_->reset();
+    }
+
+    void CachedNode::halt() {
+        Node::halt();
+        child_->halt();
+        cachedStatus_.reset();
+    }
+
     // ============================================================================
     // ForNode Implementation
     // ============================================================================
@@ -265,6 +390,10 @@ namespace stateup::tree {
             // Child succeeded, move to next iteration
             currentIndex_++;
             child_->reset();
+
+            // Out of tick budget: continue with the next iteration on the next tick
+            if (currentIndex_ < targetCount_ && TickBudget::exhausted())
+                return Status::Running;
         }
 
         // All iterations completed
@@ -290,6 +419,7 @@ namespace stateup::tree {
 
     void ConditionalSequence::addChild(NodePtr child, ConditionFunc precondition) {
         children_.push_back({std::move(child), std::move(precondition)});
+        active_.grow();
     }
 
     Status ConditionalSequence::tick(Blackboard &blackboard) {
@@ -306,6 +436,7 @@ namespace stateup::tree {
             }
 
             // Execute child
+            active_.mark(currentIndex_);
             Status childStatus = conditionalChild.node->tick(blackboard);
 
             if (childStatus == Status::Running) {
@@ -331,10 +462,10 @@ namespace stateup::tree {
 
     void ConditionalSequence::reset() {
         Node::reset();
-        for (auto &child : children_) {
-            if (child.node)
-                child.node->reset();
-        }
+        active_.drain([this](size_t i) {
+            if (children_[i].node)
+                children_[i].node->reset();
+        });
         currentIndex_ = 0;
     }
 
@@ -352,6 +483,7 @@ namespace stateup::tree {
 
     void ReactiveSequence::addChild(NodePtr child, ConditionFunc condition) {
         children_.push_back({std::move(child), std::move(condition)});
+        active_.grow();
     }
 
     Status ReactiveSequence::tick(Blackboard &blackboard) {
@@ -362,9 +494,11 @@ namespace stateup::tree {
             // Check condition if exists
             if (reactiveChild.condition) {
                 if (!reactiveChild.condition(blackboard)) {
-                    // Condition failed - halt current child and restart from beginning
-                    if (i <= currentIndex_ && currentIndex_ < children_.size()) {
+                    // Condition failed - halt current child and restart from beginning. The child is reset as well
+                    // so it can run again the next time the condition holds.
+                    if (i <= currentIndex_ && currentIndex_ < children_.size() && active_.contains(currentIndex_)) {
                         children_[currentIndex_].node->halt();
+                        children_[currentIndex_].node->reset();
                     }
                     currentIndex_ = 0;
                     setState(State::Idle);
@@ -374,6 +508,7 @@ namespace stateup::tree {
 
             // If we've reached the currently executing child, tick it
             if (i == currentIndex_) {
+                active_.mark(i);
                 Status childStatus = reactiveChild.node->tick(blackboard);
 
                 if (childStatus == Status::Running) {
@@ -405,10 +540,10 @@ namespace stateup::tree {
 
     void ReactiveSequence::reset() {
         Node::reset();
-        for (auto &child : children_) {
-            if (child.node)
-                child.node->reset();
-        }
+        active_.drain([this](size_t i) {
+            if (children_[i].node)
+                children_[i].node->reset();
+        });
         currentIndex_ = 0;
     }
 
@@ -426,6 +561,7 @@ namespace stateup::tree {
 
     void DynamicSelector::addChild(NodePtr child, PriorityFunc priorityFunc) {
         children_.push_back({std::move(child), std::move(priorityFunc)});
+        active_.grow();
     }
 
     Status DynamicSelector::tick(Blackboard &blackboard) {
@@ -454,6 +590,7 @@ namespace stateup::tree {
         currentIndex_ = highestPriorityIndex;
 
         // Execute the highest priority child
+        active_.mark(currentIndex_);
         Status childStatus = children_[currentIndex_].node->tick(blackboard);
 
         if (childStatus == Status::Success) {
@@ -476,10 +613,10 @@ namespace stateup::tree {
 
     void DynamicSelector::reset() {
         Node::reset();
-        for (auto &child : children_) {
-            if (child.node)
-                child.node->reset();
-        }
+        active_.drain([this](size_t i) {
+            if (children_[i].node)
+                children_[i].node->reset();
+        });
         currentIndex_ = SIZE_MAX;
     }
 
@@ -2,7 +2,8 @@
 
 namespace stateup::tree {
 
-    Decorator::Decorator(Func func, NodePtr child) : func_(std::move(func)), child_(std::move(child)) {}
+    Decorator::Decorator(Func func, NodePtr child, bool stateless)
+        : func_(std::move(func)), child_(std::move(child)), stateless_(stateless) {}
 
     Status Decorator::tick(Blackboard &blackboard) {
         if (state_ == State::Halted)
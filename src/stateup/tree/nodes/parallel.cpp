@@ -1,13 +1,21 @@
 #include "stateup/tree/nodes/parallel.hpp"
 #include "stateup/core/executor.hpp"
+#include "stateup/tree/structure/tick_random.hpp"
+#include "stateup/tree/structure/wakeup.hpp"
 // <execution> removed: using internal ThreadPool
 #include <limits>
-#include <numeric>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace stateup::tree {
 
+    namespace {
+        thread_local const std::atomic<bool> *currentCancel = nullptr;
+    } // namespace
+
+    bool cancellationRequested() { return currentCancel && currentCancel->load(std::memory_order_relaxed); }
+
     Parallel::Parallel(Policy successPolicy, Policy failurePolicy)
         : successPolicy_(successPolicy), failurePolicy_(failurePolicy) {}
 
@@ -23,9 +31,23 @@ namespace stateup::tree {
         }
     }
 
+    Parallel::~Parallel() {
+        cancelJobs();
+        std::unique_lock<std::mutex> lock(jobsMutex_);
+        jobsIdle_.wait(lock, [this] { return jobsInFlight_ == 0; });
+    }
+
     void Parallel::addChild(const NodePtr &child) {
         children_.emplace_back(child);
         childStates_.emplace_back(Status::Idle);
+        jobs_.emplace_back(std::make_unique<Job>());
+        costs_.emplace_back();
+        pooled_.reserve(children_.size());
+    }
+
+    size_t Parallel::jobsInFlight() const {
+        std::lock_guard<std::mutex> lock(jobsMutex_);
+        return jobsInFlight_;
     }
 
     Status Parallel::tick(Blackboard &blackboard) {
@@ -37,65 +59,91 @@ namespace stateup::tree {
         if (children_.empty())
             return Status::Success;
 
-        // Prepare indices to process all non-terminal children
-        std::vector<size_t> indices(children_.size());
-        std::iota(indices.begin(), indices.end(), 0);
+        if (mode_ == Mode::Concurrent && blackboard.lockPolicy() != LockPolicy::None)
+            return tickConcurrent(blackboard);
 
-        // Run child ticks in parallel where available; otherwise sequential.
+        // Children whose estimated tick cost is below the pool threshold run inline on the calling thread; the pool
+        // is only used when at least two children are expensive (or not measured yet), since one job alone gains
+        // nothing from it. A LockPolicy::None blackboard is not synchronized, so everything runs inline then.
         // Note: Blackboard writes are synchronized internally; parallel children may still observe each other's writes.
-        static stateup::core::ThreadPool defaultPool;
-        stateup::core::ThreadPool *pool = this->executor_ ? this->executor_ : &defaultPool;
         std::atomic<bool> stop{false};
-        const size_t total = indices.size();
-        std::atomic<size_t> processed{0};
+        const size_t total = children_.size();
         std::atomic<size_t> succ{0};
         std::atomic<size_t> fail{0};
-        pool->bulk_early_stop(
-            [&](size_t k) -> bool {
-                if (stop.load(std::memory_order_relaxed))
-                    return true;
-                size_t i = indices[k];
-                auto prev = childStates_[i];
-                if (prev == Status::Success || prev == Status::Failure) {
-                    processed.fetch_add(1, std::memory_order_relaxed);
-                    return true; // skip
-                }
-                Status status = children_[i]->tick(blackboard);
-                childStates_[i] = status;
-                if (status == Status::Success)
-                    succ.fetch_add(1, std::memory_order_relaxed);
-                if (status == Status::Failure)
-                    fail.fetch_add(1, std::memory_order_relaxed);
-                size_t done = processed.fetch_add(1, std::memory_order_relaxed) + 1;
-                size_t unresolved =
-                    total - (succ.load(std::memory_order_relaxed) + fail.load(std::memory_order_relaxed));
-                // Early-stop conditions
-                if (!successThreshold_.has_value()) {
-                    if (successPolicy_ == Policy::RequireOne && status == Status::Success)
-                        return false;
-                    if (successPolicy_ == Policy::RequireAll && status == Status::Failure)
-                        return false; // cannot all succeed
-                } else {
-                    size_t s = succ.load(std::memory_order_relaxed);
-                    size_t required = successThreshold_.value();
-                    if (s >= required)
-                        return false;
-                    if (s + unresolved < required)
-                        return false; // impossible now
-                }
-                if (failureThreshold_.has_value()) {
-                    size_t f = fail.load(std::memory_order_relaxed);
-                    if (f >= failureThreshold_.value())
-                        return false;
-                } else {
-                    if (failurePolicy_ == Policy::RequireOne && status == Status::Failure)
-                        return false;
-                    // RequireAll failure early-stop is non-trivial safely; skip
-                }
-                (void)done;
+        auto tickChild = [&](size_t i) -> bool {
+            if (stop.load(std::memory_order_relaxed))
                 return true;
-            },
-            indices.size(), stop);
+            auto prev = childStates_[i];
+            if (prev == Status::Success || prev == Status::Failure) {
+                return true; // skip
+            }
+            Status status = costs_[i].run([&] { return children_[i]->tick(blackboard); });
+            childStates_[i] = status;
+            if (status == Status::Success)
+                succ.fetch_add(1, std::memory_order_relaxed);
+            if (status == Status::Failure)
+                fail.fetch_add(1, std::memory_order_relaxed);
+            size_t unresolved = total - (succ.load(std::memory_order_relaxed) + fail.load(std::memory_order_relaxed));
+            // Early-stop conditions
+            if (!successThreshold_.has_value()) {
+                if (successPolicy_ == Policy::RequireOne && status == Status::Success)
+                    return false;
+                if (successPolicy_ == Policy::RequireAll && status == Status::Failure)
+                    return false; // cannot all succeed
+            } else {
+                size_t s = succ.load(std::memory_order_relaxed);
+                size_t required = successThreshold_.value();
+                if (s >= required)
+                    return false;
+                if (s + unresolved < required)
+                    return false; // impossible now
+            }
+            if (failureThreshold_.has_value()) {
+                size_t f = fail.load(std::memory_order_relaxed);
+                if (f >= failureThreshold_.value())
+                    return false;
+            } else {
+                if (failurePolicy_ == Policy::RequireOne && status == Status::Failure)
+                    return false;
+                // RequireAll failure early-stop is non-trivial safely; skip
+            }
+            return true;
+        };
+
+        pooled_.clear();
+        if (blackboard.lockPolicy() != LockPolicy::None) {
+            for (size_t i = 0; i < total; ++i) {
+                const bool resolved = childStates_[i] == Status::Success || childStates_[i] == Status::Failure;
+                if (!resolved && costs_[i].expensive(poolThreshold_))
+                    pooled_.push_back(i);
+            }
+            if (pooled_.size() < 2)
+                pooled_.clear();
+        }
+
+        // Inline children first (in order), skipping the ones reserved for the pool
+        for (size_t i = 0, next = 0; i < total; ++i) {
+            if (next < pooled_.size() && pooled_[next] == i) {
+                ++next;
+                continue;
+            }
+            if (!tickChild(i)) {
+                stop.store(true, std::memory_order_relaxed);
+                break;
+            }
+        }
+        if (!pooled_.empty() && !stop.load(std::memory_order_relaxed)) {
+            stateup::core::ThreadPool *pool = this->executor_ ? this->executor_ : &stateup::core::defaultPool();
+            const auto now = TickTime::now();
+            const std::uint64_t seed = TickRandom::seed();
+            pool->bulk_early_stop(
+                [&](size_t k) {
+                    TickTime time(now);
+                    TickRandom random(seed);
+                    return tickChild(pooled_[k]);
+                },
+                pooled_.size(), stop);
+        }
 
         // Aggregate results
         size_t success = 0, failure = 0;
@@ -127,9 +175,114 @@ namespace stateup::tree {
         return Status::Running;
     }
 
+    Status Parallel::tickConcurrent(Blackboard &blackboard) {
+        // Harvest jobs that finished since the last tick
+        for (size_t i = 0; i < children_.size(); ++i) {
+            Job &job = *jobs_[i];
+            if (!job.unharvested || job.busy.load(std::memory_order_acquire))
+                continue;
+            job.unharvested = false;
+            if (job.stale) {
+                // Result of a decided run: stop the child now that no job touches it
+                job.stale = false;
+                children_[i]->halt();
+                children_[i]->reset();
+                childStates_[i] = Status::Idle;
+            } else {
+                childStates_[i] = job.result;
+            }
+        }
+
+        size_t success = 0, failure = 0;
+        for (Status status : childStates_) {
+            if (status == Status::Success)
+                ++success;
+            else if (status == Status::Failure)
+                ++failure;
+        }
+        const size_t unresolved = children_.size() - success - failure;
+        std::optional<Status> decided;
+        if (successSatisfied(success))
+            decided = Status::Success;
+        else if (failureSatisfied(failure) || !successStillPossible(success, unresolved))
+            decided = Status::Failure;
+        if (decided) {
+            reset();
+            return *decided;
+        }
+
+        // Relaunch every unresolved child without a job in flight
+        bool waiting = false;
+        for (size_t i = 0; i < children_.size(); ++i) {
+            if (jobs_[i]->unharvested) {
+                waiting = true;
+                continue;
+            }
+            if (childStates_[i] == Status::Idle || childStates_[i] == Status::Running) {
+                launch(i, blackboard);
+                waiting = true;
+            }
+        }
+        if (waiting && blackboard.wakeup())
+            blackboard.wakeup()->expectNotify();
+        return Status::Running;
+    }
+
+    void Parallel::launch(size_t index, Blackboard &blackboard) {
+        Job &job = *jobs_[index];
+        job.cancel.store(false, std::memory_order_relaxed);
+        job.unharvested = true;
+        job.busy.store(true, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(jobsMutex_);
+            ++jobsInFlight_;
+        }
+        std::shared_ptr<Wakeup> wakeup = blackboard.wakeup();
+        stateup::core::ThreadPool *pool = executor_ ? executor_ : &stateup::core::defaultPool();
+        pool->submit([this, index, &blackboard, wakeup = std::move(wakeup), now = TickTime::now(),
+                      seed = TickRandom::seed()]() {
+            Job &job = *jobs_[index];
+            TickTime time(now);
+            TickRandom random(seed);
+            const std::atomic<bool> *outer = std::exchange(currentCancel, &job.cancel);
+            Status status = Status::Failure;
+            try {
+                status = children_[index]->tick(blackboard);
+            } catch (...) {
+                // A throwing child fails, as nothing waits on this job's future
+            }
+            currentCancel = outer;
+            job.result = status;
+            job.busy.store(false, std::memory_order_release);
+            if (wakeup)
+                wakeup->notify();
+            std::lock_guard<std::mutex> lock(jobsMutex_);
+            --jobsInFlight_;
+            jobsIdle_.notify_all();
+        });
+    }
+
+    // Children whose job is still running cannot be touched from this thread; ask them to stop and halt them when
+    // the job is harvested
+    void Parallel::cancelJobs() {
+        for (auto &job : jobs_) {
+            if (job->unharvested) {
+                job->stale = true;
+                job->cancel.store(true, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Children still Idle in childStates_ have not been ticked since the last reset; reset() and halt() skip them
     void Parallel::reset() {
         Node::reset();
+        cancelJobs();
         for (size_t i = 0; i < children_.size(); ++i) {
+            if (jobs_[i]->unharvested || childStates_[i] == Status::Idle)
+                continue;
+            // A child that returned Running was interrupted; halt it before returning to Idle
+            if (childStates_[i] == Status::Running && mode_ == Mode::Concurrent)
+                children_[i]->halt();
             childStates_[i] = Status::Idle;
             children_[i]->reset();
         }
@@ -137,8 +290,11 @@ namespace stateup::tree {
 
     void Parallel::halt() {
         Node::halt();
+        cancelJobs();
         haltRunningChildren();
         for (size_t i = 0; i < children_.size(); ++i) {
+            if (jobs_[i]->unharvested || childStates_[i] == Status::Idle)
+                continue;
             children_[i]->reset();
             childStates_[i] = Status::Idle;
         }
@@ -146,8 +302,9 @@ namespace stateup::tree {
 
     void Parallel::haltRunningChildren() {
         for (size_t i = 0; i < children_.size(); ++i) {
-            if (childStates_[i] == Status::Running) {
+            if (childStates_[i] == Status::Running && !jobs_[i]->unharvested) {
                 children_[i]->halt();
+                children_[i]->reset();
                 childStates_[i] = Status::Idle;
             }
         }
@@ -1,16 +1,51 @@
 #include "stateup/tree/nodes/selector.hpp"
+#include "stateup/core/executor.hpp"
+#include "stateup/tree/structure/tick_budget.hpp"
+#include "stateup/tree/structure/tick_clock.hpp"
+#include "stateup/tree/structure/tick_random.hpp"
+#include <algorithm>
+#include <atomic>
 
 namespace stateup::tree {
 
-    void Selector::addChild(const NodePtr &child) { children_.emplace_back(child); }
+    void Selector::addChild(const NodePtr &child, bool pure) {
+        children_.emplace_back(child);
+        pure_.push_back(pure);
+        costs_.emplace_back();
+        statuses_.push_back(Status::Idle);
+        reads_.emplace_back();
+    }
 
     Status Selector::tick(Blackboard &blackboard) {
         if (state_ == State::Halted)
             return Status::Failure;
 
+        // A child still running from the last tick goes on alone: speculating past it would be wasted every tick
+        size_t plainUntil = state_ == State::Running ? currentIndex_ + 1 : 0;
+        const bool speculate = speculative_ && blackboard.lockPolicy() != LockPolicy::None;
         state_ = State::Running;
         while (currentIndex_ < children_.size()) {
-            Status status = children_[currentIndex_]->tick(blackboard);
+            if (speculate && currentIndex_ >= plainUntil) {
+                size_t end = currentIndex_;
+                pooled_.clear();
+                for (; end < children_.size() && pure_[end]; ++end) {
+                    if (costs_[end].expensive(poolThreshold_))
+                        pooled_.push_back(end);
+                }
+                if (pooled_.size() < 2) {
+                    // Not worth a dispatch: tick this run one by one
+                    plainUntil = std::max(end, currentIndex_ + 1);
+                } else {
+                    Status result = Status::Failure;
+                    if (tickSpeculatively(blackboard, end, result))
+                        return result;
+                    if (currentIndex_ < children_.size() && TickBudget::exhausted())
+                        return Status::Running;
+                    continue;
+                }
+            }
+            Status status =
+                speculate ? tickChild(currentIndex_, blackboard) : children_[currentIndex_]->tick(blackboard);
             if (status == Status::Running)
                 return Status::Running;
             if (status == Status::Success) {
@@ -18,28 +53,128 @@ namespace stateup::tree {
                 return Status::Success;
             }
             ++currentIndex_;
+            // Out of tick budget: try the next child on the next tick
+            if (currentIndex_ < children_.size() && TickBudget::exhausted())
+                return Status::Running;
         }
         reset();
         return Status::Failure;
     }
 
+    Status Selector::tickChild(size_t index, Blackboard &blackboard) {
+        return costs_[index].run([&] { return children_[index]->tick(blackboard); });
+    }
+
+    bool Selector::tickSpeculatively(Blackboard &blackboard, size_t end, Status &result) {
+        ++speculativeTicks_;
+        const size_t first = currentIndex_;
+
+        // Cheap children tick inline, in order, up to the first that does not fail; the expensive ones before that
+        // point tick on the executor
+        size_t limit = end;
+        for (size_t i = first, next = 0; i < end; ++i) {
+            if (next < pooled_.size() && pooled_[next] == i) {
+                ++next;
+                continue;
+            }
+            statuses_[i] = tickChild(i, blackboard);
+            if (statuses_[i] != Status::Failure) {
+                limit = i;
+                break;
+            }
+        }
+        pooled_.erase(std::lower_bound(pooled_.begin(), pooled_.end(), limit), pooled_.end());
+
+        // Once a child has decided, the lower-priority ones that have not started yet are skipped
+        std::atomic<size_t> decided{limit};
+        auto tickPooled = [&](size_t k) {
+            const size_t i = pooled_[k];
+            if (decided.load(std::memory_order_acquire) < i) {
+                statuses_[i] = Status::Idle;
+                return;
+            }
+            statuses_[i] = tickChild(i, blackboard);
+            if (statuses_[i] != Status::Failure) {
+                size_t current = decided.load(std::memory_order_relaxed);
+                while (i < current && !decided.compare_exchange_weak(current, i, std::memory_order_acq_rel)) {
+                }
+            }
+        };
+        if (pooled_.size() == 1) {
+            tickPooled(0);
+        } else if (!pooled_.empty()) {
+            stateup::core::ThreadPool *pool = executor_ ? executor_ : &stateup::core::defaultPool();
+            const auto now = TickTime::now();
+            const std::uint64_t seed = TickRandom::seed();
+            // A recording of reads (see CachedNode) only sees its own thread: record each pooled child's reads on
+            // its worker and report them to it afterwards
+            const bool recording = blackboard.recordingReads();
+            pool->bulk(
+                [&](size_t k) {
+                    TickTime time(now);
+                    TickRandom random(seed);
+                    if (!recording)
+                        return tickPooled(k);
+                    auto reads = blackboard.recordReads(reads_[pooled_[k]]);
+                    tickPooled(k);
+                },
+                pooled_.size());
+            if (recording) {
+                for (size_t i : pooled_)
+                    blackboard.reportReads(reads_[i]);
+            }
+        }
+
+        // The first child that did not fail decides, exactly as in the plain mode; the others are cancelled
+        const size_t ticked = std::min(limit + 1, end);
+        size_t winner = end;
+        for (size_t i = first; i < ticked; ++i) {
+            if (statuses_[i] != Status::Failure) {
+                winner = i;
+                break;
+            }
+        }
+        if (winner == end) {
+            currentIndex_ = end;
+            return false;
+        }
+        for (size_t i = winner + 1; i < ticked; ++i) {
+            if (statuses_[i] == Status::Running)
+                children_[i]->halt();
+            if (statuses_[i] != Status::Idle)
+                children_[i]->reset();
+        }
+        currentIndex_ = winner;
+        result = statuses_[winner];
+        if (result == Status::Success)
+            reset();
+        return true;
+    }
+
     void Selector::reset() {
+        // An idle selector reset its children when it finished and has not ticked any since
+        const bool ticked = state_ != State::Idle;
         Node::reset();
-        // FIX: Only reset children that were actually tried
-        for (size_t i = 0; i < currentIndex_ && i < children_.size(); ++i) {
-            children_[i]->reset();
-        }
-        // Reset the current running child if any
-        if (currentIndex_ < children_.size()) {
-            children_[currentIndex_]->reset();
+        if (ticked) {
+            // FIX: Only reset children that were actually tried
+            for (size_t i = 0; i < currentIndex_ && i < children_.size(); ++i) {
+                children_[i]->reset();
+            }
+            // Reset the current running child if any
+            if (currentIndex_ < children_.size()) {
+                children_[currentIndex_]->reset();
+            }
         }
         currentIndex_ = 0;
     }
 
+    // Only the current child can be running; earlier ones already finished and later ones have not started (or
+    // were cancelled after speculating)
     void Selector::halt() {
+        const bool running = state_ == State::Running;
         Node::halt();
-        for (auto &child : children_) {
-            child->halt();
+        if (running && currentIndex_ < children_.size()) {
+            children_[currentIndex_]->halt();
         }
     }
 
@@ -1,4 +1,10 @@
 #include "stateup/tree/nodes/sequence.hpp"
+#include "stateup/core/executor.hpp"
+#include "stateup/tree/structure/tick_budget.hpp"
+#include "stateup/tree/structure/tick_clock.hpp"
+#include "stateup/tree/structure/tick_random.hpp"
+#include <algorithm>
+#include <stdexcept>
 
 namespace stateup::tree {
 
@@ -25,6 +31,9 @@ namespace stateup::tree {
                 return Status::Failure;
             }
             ++currentIndex_;
+            // Out of tick budget: continue with the next child on the next tick
+            if (currentIndex_ < children_.size() && TickBudget::exhausted())
+                return Status::Running;
         }
         // Only reset on completion
         reset();
@@ -32,23 +41,221 @@ namespace stateup::tree {
     }
 
     void Sequence::reset() {
+        // An idle sequence reset its children when it finished and has not ticked any since
+        const bool ticked = state_ != State::Idle;
         Node::reset();
-        // FIX: Only reset children that were actually executed
-        for (size_t i = 0; i < currentIndex_ && i < children_.size(); ++i) {
-            children_[i]->reset();
-        }
-        // Reset the current running child if any
-        if (currentIndex_ < children_.size()) {
-            children_[currentIndex_]->reset();
+        if (ticked) {
+            // FIX: Only reset children that were actually executed
+            for (size_t i = 0; i < currentIndex_ && i < children_.size(); ++i) {
+                children_[i]->reset();
+            }
+            // Reset the current running child if any
+            if (currentIndex_ < children_.size()) {
+                children_[currentIndex_]->reset();
+            }
         }
         currentIndex_ = 0;
     }
 
+    // Only the current child can be running; earlier ones already finished and later ones have not started
     void Sequence::halt() {
+        const bool running = state_ == State::Running;
         Node::halt();
-        for (auto &child : children_) {
-            child->halt();
+        if (running && currentIndex_ < children_.size()) {
+            children_[currentIndex_]->halt();
+        }
+    }
+
+    namespace {
+        bool overlaps(const std::vector<std::string> &a, const std::vector<std::string> &b) {
+            for (const auto &key : a) {
+                if (std::find(b.begin(), b.end(), key) != b.end())
+                    return true;
+            }
+            return false;
+        }
+    } // namespace
+
+    bool KeyAccess::independentOf(const KeyAccess &other) const {
+        return !overlaps(writes, other.writes) && !overlaps(writes, other.reads) && !overlaps(reads, other.writes);
+    }
+
+    // ============================================================================
+    // SequenceGroup Implementation
+    // ============================================================================
+
+    SequenceGroup::SequenceGroup(std::vector<NodePtr> children, std::vector<KeyAccess> access)
+        : children_(std::move(children)), access_(std::move(access)) {
+        if (children_.size() != access_.size()) {
+            throw std::invalid_argument("SequenceGroup needs one KeyAccess per child");
+        }
+        costs_.resize(children_.size());
+        statuses_.resize(children_.size(), Status::Idle);
+        reads_.resize(children_.size());
+        pooled_.reserve(children_.size());
+        size_t writes = 0;
+        for (size_t i = 0; i < children_.size(); ++i) {
+            active_.grow();
+            writes += access_[i].writes.size();
+        }
+        saved_.resize(writes);
+        savedOwner_.resize(writes);
+    }
+
+    Status SequenceGroup::tick(Blackboard &blackboard) {
+        if (state_ == State::Halted)
+            return Status::Failure;
+
+        // A child still running from the last tick goes on alone: ticking fresh children beside it would redo
+        // and roll back their work on every tick it keeps running
+        if (state_ == State::Running) {
+            const size_t i = currentIndex_;
+            Status status = costs_[i].run([&] { return children_[i]->tick(blackboard); });
+            if (status == Status::Running)
+                return Status::Running;
+            if (status == Status::Failure)
+                return finish(Status::Failure);
+            if (++currentIndex_ == children_.size())
+                return finish(Status::Success);
+            if (TickBudget::exhausted())
+                return Status::Running;
+        }
+        state_ = State::Running;
+
+        // Going concurrent only pays off when at least two children cost more than a dispatch
+        pooled_.clear();
+        if (blackboard.lockPolicy() != LockPolicy::None) {
+            for (size_t i = currentIndex_; i < children_.size(); ++i) {
+                if (costs_[i].expensive(poolThreshold_))
+                    pooled_.push_back(i);
+            }
         }
+        if (pooled_.size() < 2)
+            return tickInOrder(blackboard);
+        return tickConcurrently(blackboard);
+    }
+
+    Status SequenceGroup::tickInOrder(Blackboard &blackboard) {
+        while (currentIndex_ < children_.size()) {
+            const size_t i = currentIndex_;
+            active_.mark(i);
+            Status status = costs_[i].run([&] { return children_[i]->tick(blackboard); });
+            if (status == Status::Running)
+                return Status::Running;
+            if (status == Status::Failure)
+                return finish(Status::Failure);
+            ++currentIndex_;
+            if (currentIndex_ < children_.size() && TickBudget::exhausted())
+                return Status::Running;
+        }
+        return finish(Status::Success);
+    }
+
+    Status SequenceGroup::tickConcurrently(Blackboard &blackboard) {
+        ++concurrentTicks_;
+        const size_t first = currentIndex_;
+        const size_t count = children_.size();
+
+        // Checkpoint what the children after the first are about to write; only they can run ahead of a sequence
+        size_t savedCount = 0;
+        for (size_t i = first + 1; i < count; ++i) {
+            for (const auto &key : access_[i].writes) {
+                blackboard.save(key, saved_[savedCount]);
+                savedOwner_[savedCount++] = i;
+            }
+        }
+
+        // Cheap children tick inline, in order, up to the first that does not succeed; the expensive ones before
+        // that point tick on the executor
+        size_t limit = count;
+        for (size_t i = first, next = 0; i < count; ++i) {
+            if (next < pooled_.size() && pooled_[next] == i) {
+                ++next;
+                continue;
+            }
+            active_.mark(i);
+            statuses_[i] = costs_[i].run([&] { return children_[i]->tick(blackboard); });
+            if (statuses_[i] != Status::Success) {
+                limit = i;
+                break;
+            }
+        }
+        pooled_.erase(std::lower_bound(pooled_.begin(), pooled_.end(), limit), pooled_.end());
+        for (size_t i : pooled_)
+            active_.mark(i);
+        auto tickPooled = [&](size_t k) {
+            const size_t i = pooled_[k];
+            statuses_[i] = costs_[i].run([&] { return children_[i]->tick(blackboard); });
+        };
+        if (pooled_.size() == 1) {
+            tickPooled(0);
+        } else if (!pooled_.empty()) {
+            stateup::core::ThreadPool *pool = executor_ ? executor_ : &stateup::core::defaultPool();
+            const auto now = TickTime::now();
+            const std::uint64_t seed = TickRandom::seed();
+            // A recording of reads (see CachedNode) only sees its own thread: record each pooled child's reads on
+            // its worker and report them to it afterwards
+            const bool recording = blackboard.recordingReads();
+            pool->bulk(
+                [&](size_t k) {
+                    TickTime time(now);
+                    TickRandom random(seed);
+                    if (!recording)
+                        return tickPooled(k);
+                    auto reads = blackboard.recordReads(reads_[pooled_[k]]);
+                    tickPooled(k);
+                },
+                pooled_.size());
+            if (recording) {
+                for (size_t i : pooled_)
+                    blackboard.reportReads(reads_[i]);
+            }
+        }
+
+        // The first child that did not succeed decides, exactly as in a Sequence
+        size_t decided = count;
+        const size_t ticked = std::min(limit + 1, count);
+        for (size_t i = first; i < ticked; ++i) {
+            if (statuses_[i] != Status::Success) {
+                decided = i;
+                break;
+            }
+        }
+        if (decided == count)
+            return finish(Status::Success);
+
+        // Children past it would not have run: undo their writes and their state
+        for (size_t k = 0; k < savedCount; ++k) {
+            if (savedOwner_[k] > decided)
+                blackboard.restore(saved_[k]);
+        }
+        for (size_t i = decided + 1; i < ticked; ++i)
+            children_[i]->reset();
+
+        if (statuses_[decided] == Status::Running) {
+            currentIndex_ = decided;
+            return Status::Running;
+        }
+        return finish(Status::Failure);
+    }
+
+    Status SequenceGroup::finish(Status status) {
+        reset();
+        return status;
+    }
+
+    void SequenceGroup::reset() {
+        Node::reset();
+        active_.drain([this](size_t i) { children_[i]->reset(); });
+        currentIndex_ = 0;
+    }
+
+    // Only the current child can be running; the ones after it were rolled back
+    void SequenceGroup::halt() {
+        const bool running = state_ == State::Running;
+        Node::halt();
+        if (running && currentIndex_ < children_.size())
+            children_[currentIndex_]->halt();
     }
 
 } // namespace stateup::tree
@@ -4,12 +4,58 @@
 
 namespace stateup::tree {
 
-    // UtilitySelector implementation
-    UtilitySelector::UtilityChild::UtilityChild(NodePtr n, UtilityFunc f)
-        : node(std::move(n)), utilityFunc(std::move(f)) {}
+    // UtilityScores implementation
+    void UtilityScores::add(UtilityFunc func) {
+        funcs_.push_back(std::move(func));
+        option_.push_back(SIZE_MAX);
+        scores_.push_back(0.0f);
+    }
+
+    void UtilityScores::add(const std::vector<Consideration> &considerations) {
+        funcs_.emplace_back();
+        option_.push_back(model_.addOption(considerations));
+        scores_.push_back(0.0f);
+        inputs_.resize(model_.inputCount());
+        modelScores_.resize(model_.optionCount());
+        modelCached_ = false;
+    }
+
+    const std::vector<float> &UtilityScores::evaluate(Blackboard &blackboard) {
+        if (model_.optionCount() > 0) {
+            if (modelCached_ && blackboard.unchanged(reads_)) {
+                blackboard.reportReads(reads_);
+            } else {
+                // Revisions are taken before reading, like memoize() with declared keys
+                reads_.clear();
+                reads_.source = &blackboard;
+                reads_.structureRevision = blackboard.structureRevision();
+                reads_.checkedRevision = blackboard.revision();
+                for (const auto &key : model_.inputs()) {
+                    reads_.keys.emplace_back(key, blackboard.keyRevision(key));
+                }
+                model_.gather(blackboard, inputs_.data());
+                model_.score(inputs_.data(), modelScores_.data());
+                modelCached_ = true;
+                ++modelEvaluations_;
+            }
+        }
+        for (size_t i = 0; i < scores_.size(); ++i) {
+            scores_[i] = option_[i] == SIZE_MAX ? funcs_[i](blackboard) : modelScores_[option_[i]];
+        }
+        return scores_;
+    }
 
+    // UtilitySelector implementation
     void UtilitySelector::addChild(NodePtr child, UtilityFunc utilityFunc) {
-        children_.emplace_back(std::move(child), std::move(utilityFunc));
+        children_.push_back(std::move(child));
+        scores_.add(std::move(utilityFunc));
+        active_.grow();
+    }
+
+    void UtilitySelector::addChild(NodePtr child, const std::vector<Consideration> &considerations) {
+        children_.push_back(std::move(child));
+        scores_.add(considerations);
+        active_.grow();
     }
 
     Status UtilitySelector::tick(Blackboard &blackboard) {
@@ -21,26 +67,35 @@ namespace stateup::tree {
         state_ = State::Running;
 
         // FIX: Handle negative utilities properly
+        const std::vector<float> &scores = scores_.evaluate(blackboard);
         float maxUtility = std::numeric_limits<float>::lowest();
         size_t bestIndex = 0;
 
-        for (size_t i = 0; i < children_.size(); ++i) {
-            float utility = children_[i].utilityFunc(blackboard);
-            if (utility > maxUtility) {
-                maxUtility = utility;
+        for (size_t i = 0; i < scores.size(); ++i) {
+            if (scores[i] > maxUtility) {
+                maxUtility = scores[i];
                 bestIndex = i;
             }
         }
 
-        // If we switched to a different child, reset the previous one
+        // Hysteresis: the last choice stays unless it is clearly beaten
+        if (hysteresis_ > 0.0f && lastChoice_ < children_.size() && bestIndex != lastChoice_ &&
+            maxUtility <= scores[lastChoice_] + hysteresis_) {
+            bestIndex = lastChoice_;
+        }
+        lastChoice_ = bestIndex;
+
+        // If we switched to a different child, halt and reset the previous one so it can be picked again later
         if (bestIndex != currentIndex_) {
-            if (currentIndex_ < children_.size()) {
-                children_[currentIndex_].node->halt();
+            if (currentIndex_ < children_.size() && active_.contains(currentIndex_)) {
+                children_[currentIndex_]->halt();
+                children_[currentIndex_]->reset();
             }
             currentIndex_ = bestIndex;
         }
 
-        Status result = children_[currentIndex_].node->tick(blackboard);
+        active_.mark(currentIndex_);
+        Status result = children_[currentIndex_]->tick(blackboard);
         if (result != Status::Running)
             state_ = State::Idle;
 
@@ -49,25 +104,31 @@ namespace stateup::tree {
 
     void UtilitySelector::reset() {
         Node::reset();
-        for (auto &child : children_) {
-            child.node->reset();
-        }
+        active_.drain([this](size_t i) { children_[i]->reset(); });
         currentIndex_ = SIZE_MAX; // Invalid index
     }
 
+    // Only the selected child can be running
     void UtilitySelector::halt() {
         Node::halt();
-        for (auto &child : children_) {
-            child.node->halt();
+        if (currentIndex_ < children_.size() && active_.contains(currentIndex_)) {
+            children_[currentIndex_]->halt();
         }
     }
 
     // WeightedRandomSelector implementation
-    WeightedRandomSelector::WeightedChild::WeightedChild(NodePtr n, UtilityFunc f)
-        : node(std::move(n)), weightFunc(std::move(f)) {}
-
     void WeightedRandomSelector::addChild(NodePtr child, UtilityFunc weightFunc) {
-        children_.emplace_back(std::move(child), std::move(weightFunc));
+        children_.push_back(std::move(child));
+        weights_.add(std::move(weightFunc));
+        active_.grow();
+        samplerStale_ = true;
+    }
+
+    void WeightedRandomSelector::addChild(NodePtr child, const std::vector<Consideration> &considerations) {
+        children_.push_back(std::move(child));
+        weights_.add(considerations);
+        active_.grow();
+        samplerStale_ = true;
     }
 
     Status WeightedRandomSelector::tick(Blackboard &blackboard) {
@@ -79,7 +140,7 @@ namespace stateup::tree {
         state_ = State::Running;
 
         if (currentIndex_ < children_.size()) {
-            Status activeResult = children_[currentIndex_].node->tick(blackboard);
+            Status activeResult = children_[currentIndex_]->tick(blackboard);
             if (activeResult != Status::Running) {
                 state_ = State::Idle;
                 currentIndex_ = SIZE_MAX;
@@ -87,48 +148,24 @@ namespace stateup::tree {
             return activeResult;
         }
 
-        // Calculate total weight
-        float totalWeight = 0.0f;
-        std::vector<float> weights;
-        weights.reserve(children_.size());
-
-        for (auto &child : children_) {
-            float weight = std::max(0.0f, child.weightFunc(blackboard));
-            weights.push_back(weight);
-            totalWeight += weight;
+        // Rebuild the alias table only when a weight changed; negative weights count as zero
+        const std::vector<float> &weights = weights_.evaluate(blackboard);
+        if (samplerStale_ || weights != sampledWeights_) {
+            sampledWeights_ = weights;
+            sampler_.build(sampledWeights_);
+            samplerStale_ = false;
         }
-
-        if (totalWeight <= 0.0f) {
+        if (sampler_.empty()) {
             state_ = State::Idle;
             currentIndex_ = SIZE_MAX;
             return Status::Failure;
         }
 
-        // FIX: Use thread-safe random number generation
-        static thread_local std::random_device rd;
-        static thread_local std::mt19937 gen(rd());
-        std::uniform_real_distribution<float> dis(0.0f, totalWeight);
-        float random = dis(gen);
-        float accumulator = 0.0f;
-
-        for (size_t i = 0; i < children_.size(); ++i) {
-            accumulator += weights[i];
-            if (random <= accumulator) {
-                Status result = children_[i].node->tick(blackboard);
-                if (result == Status::Running) {
-                    currentIndex_ = i;
-                } else {
-                    state_ = State::Idle;
-                    currentIndex_ = SIZE_MAX;
-                }
-                return result;
-            }
-        }
-
-        // Fallback to last child
-        Status result = children_.back().node->tick(blackboard);
+        const size_t i = sampler_.sample(TickRandom::engine(rng_));
+        active_.mark(i);
+        Status result = children_[i]->tick(blackboard);
         if (result == Status::Running) {
-            currentIndex_ = children_.size() - 1;
+            currentIndex_ = i;
         } else {
             state_ = State::Idle;
             currentIndex_ = SIZE_MAX;
@@ -138,16 +175,15 @@ namespace stateup::tree {
 
     void WeightedRandomSelector::reset() {
         Node::reset();
-        for (auto &child : children_) {
-            child.node->reset();
-        }
+        active_.drain([this](size_t i) { children_[i]->reset(); });
         currentIndex_ = SIZE_MAX;
     }
 
+    // Only the selected child can be running
     void WeightedRandomSelector::halt() {
         Node::halt();
-        for (auto &child : children_) {
-            child.node->halt();
+        if (currentIndex_ < children_.size()) {
+            children_[currentIndex_]->halt();
         }
         currentIndex_ = SIZE_MAX;
     }
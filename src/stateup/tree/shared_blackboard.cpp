@@ -0,0 +1,263 @@
+#include "stateup/tree/shared_blackboard.hpp"
+#include <atomic>
+#include <fcntl.h>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+namespace stateup::tree {
+
+    struct SharedBlackboard::Header {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t capacity;
+        std::uint64_t valueSize;
+        std::uint64_t slotStride;
+        std::atomic<std::uint64_t> used;
+    };
+
+    namespace {
+
+        constexpr std::uint32_t kSegmentMagic = 0x53554253; // "SUBS"
+        constexpr std::uint32_t kSegmentVersion = 1;
+        constexpr size_t kCacheLine = 64;
+
+        size_t roundUp(size_t value, size_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+        size_t nextPowerOfTwo(size_t value) {
+            size_t result = 1;
+            while (result < value)
+                result <<= 1;
+            return result;
+        }
+
+        std::string shmName(const std::string &name) { return name.empty() || name[0] != '/' ? "/" + name : name; }
+
+        std::uint32_t hashKey(const std::string &key) { return TypeRegistry::hashName(key); }
+
+        inline void cpuRelax(unsigned &spins) {
+            if (++spins > 64) {
+                std::this_thread::yield();
+                spins = 0;
+            }
+        }
+
+    } // namespace
+
+    std::shared_ptr<SharedBlackboard> SharedBlackboard::create(const std::string &name, size_t capacity,
+                                                               size_t valueSize) {
+        if (capacity == 0 || valueSize == 0)
+            throw std::invalid_argument("SharedBlackboard: capacity and value size must be non-zero");
+
+        capacity = nextPowerOfTwo(capacity);
+        const size_t headerSize = roundUp(sizeof(Header), kCacheLine);
+        const size_t stride = roundUp(sizeof(SlotHeader) + valueSize, kCacheLine);
+        const size_t total = headerSize + capacity * stride;
+
+        const std::string path = shmName(name);
+        int fd = ::shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)
+            throw std::runtime_error("SharedBlackboard: cannot create segment '" + path + "'");
+        if (::ftruncate(fd, static_cast<off_t>(total)) != 0) {
+            ::close(fd);
+            ::shm_unlink(path.c_str());
+            throw std::runtime_error("SharedBlackboard: cannot size segment '" + path + "'");
+        }
+        void *base = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            ::shm_unlink(path.c_str());
+            throw std::runtime_error("SharedBlackboard: cannot map segment '" + path + "'");
+        }
+
+        // ftruncate zero-fills the segment, so every slot starts Empty; only the header needs construction
+        auto *header = new (base) Header{};
+        header->capacity = capacity;
+        header->valueSize = valueSize;
+        header->slotStride = stride;
+        header->used.store(0, std::memory_order_relaxed);
+        for (size_t i = 0; i < capacity; ++i) {
+            auto *slot = reinterpret_cast<unsigned char *>(base) + headerSize + i * stride;
+            new (slot) SlotHeader{};
+        }
+        header->version = kSegmentVersion;
+        std::atomic_thread_fence(std::memory_order_release);
+        std::atomic_ref<std::uint32_t>(header->magic).store(kSegmentMagic, std::memory_order_relaxed);
+
+        return std::shared_ptr<SharedBlackboard>(new SharedBlackboard(path, base, total));
+    }
+
+    std::shared_ptr<SharedBlackboard> SharedBlackboard::open(const std::string &name) {
+        const std::string path = shmName(name);
+        int fd = ::shm_open(path.c_str(), O_RDWR, 0600);
+        if (fd < 0)
+            throw std::runtime_error("SharedBlackboard: no segment named '" + path + "'");
+        struct stat info{};
+        if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+            ::close(fd);
+            throw std::runtime_error("SharedBlackboard: segment '" + path + "' is not initialized");
+        }
+        const size_t total = static_cast<size_t>(info.st_size);
+        void *base = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED)
+            throw std::runtime_error("SharedBlackboard: cannot map segment '" + path + "'");
+
+        // The magic is published last; seeing it makes the rest of the header visible
+        auto *header = static_cast<Header *>(base);
+        const std::uint32_t magic = std::atomic_ref<std::uint32_t>(header->magic).load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (magic != kSegmentMagic || header->version != kSegmentVersion) {
+            ::munmap(base, total);
+            throw std::runtime_error("SharedBlackboard: segment '" + path + "' has an incompatible layout");
+        }
+        // The segment may be truncated or written by a peer. Its capacity must be a power of two (find() masks
+        // with it), its slots large enough for their values, and every slot inside the mapping.
+        const std::uint64_t capacity = header->capacity;
+        const std::uint64_t stride = header->slotStride;
+        const size_t headerSize = roundUp(sizeof(Header), kCacheLine);
+        const bool valid = capacity != 0 && (capacity & (capacity - 1)) == 0 && header->valueSize < stride &&
+                           stride >= sizeof(SlotHeader) + header->valueSize && stride % alignof(SlotHeader) == 0 &&
+                           total >= headerSize && capacity <= (total - headerSize) / stride;
+        if (!valid) {
+            ::munmap(base, total);
+            throw std::runtime_error("SharedBlackboard: segment '" + path + "' has an invalid size or geometry");
+        }
+        return std::shared_ptr<SharedBlackboard>(new SharedBlackboard(path, base, total));
+    }
+
+    bool SharedBlackboard::unlink(const std::string &name) { return ::shm_unlink(shmName(name).c_str()) == 0; }
+
+    SharedBlackboard::SharedBlackboard(std::string name, void *base, size_t mappedSize)
+        : name_(std::move(name)), base_(base), mappedSize_(mappedSize) {
+        auto *header = static_cast<Header *>(base_);
+        capacity_ = header->capacity;
+        valueSize_ = header->valueSize;
+        slotStride_ = header->slotStride;
+    }
+
+    SharedBlackboard::~SharedBlackboard() {
+        if (base_)
+            ::munmap(base_, mappedSize_);
+    }
+
+    SharedBlackboard::SlotHeader *SharedBlackboard::slotAt(size_t index) const {
+        auto *bytes = static_cast<unsigned char *>(base_) + roundUp(sizeof(Header), kCacheLine);
+        return reinterpret_cast<SlotHeader *>(bytes + index * slotStride_);
+    }
+
+    SharedBlackboard::SlotHeader *SharedBlackboard::find(const std::string &key) const {
+        if (key.size() > kMaxKeyLength)
+            return nullptr;
+        const std::uint32_t hash = hashKey(key);
+        const size_t mask = capacity_ - 1;
+        for (size_t probe = 0; probe < capacity_; ++probe) {
+            SlotHeader *slot = slotAt((hash + probe) & mask);
+            std::uint32_t state = slot->state.load(std::memory_order_acquire);
+            unsigned spins = 0;
+            while (state == SlotHeader::Claimed) {
+                cpuRelax(spins);
+                state = slot->state.load(std::memory_order_acquire);
+            }
+            if (state == SlotHeader::Empty)
+                return nullptr;
+            if (slot->keyHash == hash && key == slot->key)
+                return slot;
+        }
+        return nullptr;
+    }
+
+    SharedBlackboard::SlotHeader *SharedBlackboard::intern(const std::string &key) {
+        if (key.size() > kMaxKeyLength)
+            throw std::invalid_argument("SharedBlackboard: key '" + key + "' exceeds " +
+                                        std::to_string(kMaxKeyLength) + " characters");
+        auto *header = static_cast<Header *>(base_);
+        const std::uint32_t hash = hashKey(key);
+        const size_t mask = capacity_ - 1;
+        for (size_t probe = 0; probe < capacity_; ++probe) {
+            SlotHeader *slot = slotAt((hash + probe) & mask);
+            std::uint32_t state = slot->state.load(std::memory_order_acquire);
+            if (state == SlotHeader::Empty) {
+                if (slot->state.compare_exchange_strong(state, SlotHeader::Claimed, std::memory_order_acq_rel)) {
+                    slot->keyHash = hash;
+                    std::memcpy(slot->key, key.c_str(), key.size() + 1);
+                    header->used.fetch_add(1, std::memory_order_relaxed);
+                    slot->state.store(SlotHeader::Ready, std::memory_order_release);
+                    return slot;
+                }
+                // Lost the race for this slot; fall through and inspect the winner's key
+            }
+            unsigned spins = 0;
+            while (state == SlotHeader::Claimed) {
+                cpuRelax(spins);
+                state = slot->state.load(std::memory_order_acquire);
+            }
+            if (slot->keyHash == hash && key == slot->key)
+                return slot;
+        }
+        throw std::runtime_error("SharedBlackboard: segment '" + name_ + "' is full");
+    }
+
+    void SharedBlackboard::write(SlotHeader *header, unsigned char *data, std::uint32_t typeId, const void *value,
+                                 size_t size) {
+        // Acquire the seqlock: move the sequence from even to odd
+        std::uint64_t sequence = header->sequence.load(std::memory_order_relaxed);
+        unsigned spins = 0;
+        for (;;) {
+            if ((sequence & 1) == 0 &&
+                header->sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire)) {
+                break;
+            }
+            cpuRelax(spins);
+            sequence = header->sequence.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        header->typeId = typeId;
+        header->size = static_cast<std::uint32_t>(size);
+        std::memcpy(data, value, size);
+        header->sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    bool SharedBlackboard::read(const SlotHeader *header, const unsigned char *data, std::uint32_t typeId, void *value,
+                                size_t size) {
+        unsigned spins = 0;
+        for (;;) {
+            const std::uint64_t before = header->sequence.load(std::memory_order_acquire);
+            if (before == 0)
+                return false; // interned but never written
+            if (before & 1) {
+                cpuRelax(spins);
+                continue;
+            }
+            const bool match = header->typeId == typeId && header->size == size;
+            if (match)
+                std::memcpy(value, data, size);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (header->sequence.load(std::memory_order_relaxed) == before)
+                return match;
+        }
+    }
+
+    std::uint64_t SharedBlackboard::version(const std::string &key) const {
+        const SlotHeader *slot = find(key);
+        return slot ? slot->sequence.load(std::memory_order_acquire) / 2 : 0;
+    }
+
+    std::vector<std::string> SharedBlackboard::getAllKeys() const {
+        std::vector<std::string> keys;
+        for (size_t i = 0; i < capacity_; ++i) {
+            const SlotHeader *slot = slotAt(i);
+            if (slot->state.load(std::memory_order_acquire) == SlotHeader::Ready)
+                keys.emplace_back(slot->key);
+        }
+        return keys;
+    }
+
+    size_t SharedBlackboard::size() const {
+        return static_cast<const Header *>(base_)->used.load(std::memory_order_relaxed);
+    }
+
+} // namespace stateup::tree
@@ -0,0 +1,143 @@
+#include "stateup/tree/utility_curves.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace stateup::tree {
+
+    namespace {
+        inline float clamp01(float value) { return std::min(std::max(value, 0.0f), 1.0f); }
+
+        inline float logisticAt(float x, float midpoint, float steepness) {
+            return 1.0f / (1.0f + std::exp(-steepness * (x - midpoint)));
+        }
+
+        // Points are read through pointX(i) and pointY(i), so curves and the model's flat arrays share the walk
+        template <typename X, typename Y> float piecewiseAt(size_t count, X pointX, Y pointY, float x) {
+            if (x <= pointX(0))
+                return clamp01(pointY(0));
+            for (size_t i = 1; i < count; ++i) {
+                if (x <= pointX(i)) {
+                    const float span = pointX(i) - pointX(i - 1);
+                    const float t = span > 0.0f ? (x - pointX(i - 1)) / span : 1.0f;
+                    return clamp01(pointY(i - 1) + t * (pointY(i) - pointY(i - 1)));
+                }
+            }
+            return clamp01(pointY(count - 1));
+        }
+    } // namespace
+
+    // ============================================================================
+    // ResponseCurve Implementation
+    // ============================================================================
+
+    ResponseCurve ResponseCurve::linear(float slope, float intercept) { return {Kind::Linear, slope, intercept}; }
+
+    ResponseCurve ResponseCurve::logistic(float midpoint, float steepness) {
+        return {Kind::Logistic, midpoint, steepness};
+    }
+
+    ResponseCurve ResponseCurve::piecewise(std::vector<std::pair<float, float>> points) {
+        if (points.empty()) {
+            throw std::invalid_argument("ResponseCurve::piecewise needs at least one point");
+        }
+        if (!std::is_sorted(points.begin(), points.end(),
+                            [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; })) {
+            throw std::invalid_argument("ResponseCurve::piecewise points must be sorted by x");
+        }
+        ResponseCurve curve(Kind::Piecewise, 0.0f, 0.0f);
+        curve.points_ = std::move(points);
+        return curve;
+    }
+
+    float ResponseCurve::operator()(float x) const {
+        switch (kind_) {
+        case Kind::Linear:
+            return clamp01(a_ * x + b_);
+        case Kind::Logistic:
+            return logisticAt(x, a_, b_);
+        case Kind::Piecewise:
+            break;
+        }
+        auto pointX = [this](size_t i) { return points_[i].first; };
+        auto pointY = [this](size_t i) { return points_[i].second; };
+        return piecewiseAt(points_.size(), pointX, pointY, x);
+    }
+
+    // ============================================================================
+    // UtilityModel Implementation
+    // ============================================================================
+
+    size_t UtilityModel::inputSlot(const std::string &key, float fallback) {
+        auto it = std::find(inputKeys_.begin(), inputKeys_.end(), key);
+        if (it != inputKeys_.end())
+            return static_cast<size_t>(it - inputKeys_.begin());
+        inputKeys_.push_back(key);
+        fallbacks_.push_back(fallback);
+        return inputKeys_.size() - 1;
+    }
+
+    size_t UtilityModel::addOption(const std::vector<Consideration> &considerations) {
+        const auto option = static_cast<std::uint32_t>(optionCount_++);
+        for (const auto &consideration : considerations) {
+            const auto input = static_cast<std::uint32_t>(inputSlot(consideration.input, consideration.fallback));
+            const ResponseCurve &curve = consideration.curve;
+            if (curve.kind() == ResponseCurve::Kind::Piecewise) {
+                piecewise_.input.push_back(input);
+                piecewise_.option.push_back(option);
+                for (const auto &[x, y] : curve.points()) {
+                    piecewise_.x.push_back(x);
+                    piecewise_.y.push_back(y);
+                }
+                piecewise_.begin.push_back(static_cast<std::uint32_t>(piecewise_.x.size()));
+                continue;
+            }
+            Block &block = curve.kind() == ResponseCurve::Kind::Linear ? linear_ : logistic_;
+            block.input.push_back(input);
+            block.option.push_back(option);
+            block.a.push_back(curve.a());
+            block.b.push_back(curve.b());
+        }
+        return option;
+    }
+
+    void UtilityModel::gather(const Blackboard &blackboard, float *inputs, size_t stride) const {
+        for (size_t i = 0; i < inputKeys_.size(); ++i) {
+            inputs[i * stride] = blackboard.get<float>(inputKeys_[i]).value_or(fallbacks_[i]);
+        }
+    }
+
+    // One pass per consideration over all agents, so the inner loops stay free of per-agent dispatch
+    void UtilityModel::scoreBatch(const float *inputs, size_t agents, float *scores) const {
+        std::fill(scores, scores + optionCount_ * agents, 1.0f);
+
+        for (size_t c = 0; c < linear_.input.size(); ++c) {
+            const float *x = inputs + linear_.input[c] * agents;
+            float *s = scores + linear_.option[c] * agents;
+            const float slope = linear_.a[c];
+            const float intercept = linear_.b[c];
+            for (size_t i = 0; i < agents; ++i)
+                s[i] *= clamp01(slope * x[i] + intercept);
+        }
+        for (size_t c = 0; c < logistic_.input.size(); ++c) {
+            const float *x = inputs + logistic_.input[c] * agents;
+            float *s = scores + logistic_.option[c] * agents;
+            const float midpoint = logistic_.a[c];
+            const float steepness = logistic_.b[c];
+            for (size_t i = 0; i < agents; ++i)
+                s[i] *= logisticAt(x[i], midpoint, steepness);
+        }
+        for (size_t c = 0; c < piecewise_.input.size(); ++c) {
+            const float *x = inputs + piecewise_.input[c] * agents;
+            float *s = scores + piecewise_.option[c] * agents;
+            const float *px = piecewise_.x.data() + piecewise_.begin[c];
+            const float *py = piecewise_.y.data() + piecewise_.begin[c];
+            const size_t count = piecewise_.begin[c + 1] - piecewise_.begin[c];
+            auto pointX = [px](size_t k) { return px[k]; };
+            auto pointY = [py](size_t k) { return py[k]; };
+            for (size_t i = 0; i < agents; ++i)
+                s[i] *= piecewiseAt(count, pointX, pointY, x[i]);
+        }
+    }
+
+} // namespace stateup::tree
@@ -200,3 +200,24 @@ TEST_CASE("Builder actionTask integrates coroutine actions") {
     // Second tick: coroutine child succeeds, then next action succeeds => whole sequence Success
     CHECK(tree.tick() == Status::Success);
 }
+
+TEST_CASE("Action callbacks are stored inline and move-only") {
+    Blackboard bb;
+    auto token = std::make_shared<int>(7);
+
+    Action::Func func = [token](Blackboard &) { return *token == 7 ? Status::Success : Status::Failure; };
+    CHECK(token.use_count() == 2);
+
+    Action::Func moved = std::move(func);
+    CHECK_FALSE(func);
+    CHECK(token.use_count() == 2);
+    CHECK(moved(bb) == Status::Success);
+
+    moved = nullptr;
+    CHECK(token.use_count() == 1);
+
+    // Empty std::function objects and null pointers stay empty
+    CHECK_FALSE(Action::Func(std::function<Status(Blackboard &)>()));
+    CHECK_FALSE(Action::Func(static_cast<Status (*)(Blackboard &)>(nullptr)));
+    CHECK_THROWS_AS(Action::Func()(bb), std::bad_function_call);
+}
@@ -3,6 +3,7 @@
 #include <doctest/doctest.h>
 #include <thread>
 #include <unordered_set>
+#include <vector>
 
 using namespace stateup::tree;
 
@@ -503,6 +504,136 @@ TEST_CASE("DebounceDecorator - Stable failure") {
     CHECK(result == Status::Failure); // Should return stable failure
 }
 
+// ============================================================================
+// ThrottleNode Tests
+// ============================================================================
+
+TEST_CASE("ThrottleNode - Ticks the child once per period and caches in between") {
+    auto clock = std::make_shared<SimulatedClock>();
+    int calls = 0;
+    Builder builder;
+    builder.throttle(std::chrono::milliseconds(100)).action([&calls](Blackboard &) {
+        ++calls;
+        return calls % 2 ? Status::Success : Status::Failure;
+    });
+    Tree tree = builder.build();
+    tree.setClock(clock);
+
+    // A 1 kHz host over one simulated second runs the 10 Hz child ten times
+    std::vector<Status> results;
+    for (int ms = 0; ms < 1000; ++ms) {
+        results.push_back(tree.tick());
+        clock->advance(std::chrono::milliseconds(1));
+    }
+    CHECK(calls == 10);
+    CHECK(results[0] == Status::Success);
+    CHECK(results[99] == Status::Success);
+    CHECK(results[100] == Status::Failure);
+    CHECK(results[999] == Status::Failure);
+
+    // The tree's wakeup points at the next due time
+    auto throttle = std::dynamic_pointer_cast<ThrottleNode>(tree.getRoot());
+    REQUIRE(throttle);
+    CHECK(throttle->nextDue() == std::chrono::steady_clock::time_point{} + std::chrono::milliseconds(1000));
+}
+
+TEST_CASE("ThrottleNode - Stays on the period grid and skips missed periods") {
+    auto clock = std::make_shared<SimulatedClock>();
+    int calls = 0;
+    auto child = std::make_shared<Action>([&calls](Blackboard &) {
+        ++calls;
+        return Status::Success;
+    });
+    auto throttle = std::make_shared<ThrottleNode>(child, std::chrono::milliseconds(100));
+    Tree tree(throttle);
+    tree.setClock(clock);
+    const auto start = clock->now();
+
+    tree.tick();
+    clock->advance(std::chrono::milliseconds(130)); // late: the next run is still due at 200 ms
+    tree.tick();
+    CHECK(calls == 2);
+    CHECK(throttle->nextDue() == start + std::chrono::milliseconds(200));
+
+    clock->advance(std::chrono::milliseconds(500)); // 630 ms: four periods missed, no burst
+    tree.tick();
+    tree.tick();
+    CHECK(calls == 3);
+    CHECK(throttle->nextDue() == start + std::chrono::milliseconds(730));
+
+    CHECK_THROWS_AS(ThrottleNode(child, std::chrono::milliseconds(0)), std::invalid_argument);
+}
+
+TEST_CASE("ThrottleNode - Inside a sequence, a parallel and around a subtree") {
+    auto clock = std::make_shared<SimulatedClock>();
+    int fast = 0, slow = 0, planned = 0;
+    auto planner = Builder()
+                       .sequence()
+                       .action([&planned](Blackboard &) {
+                           ++planned;
+                           return Status::Success;
+                       })
+                       .end()
+                       .buildRoot();
+
+    Builder builder;
+    builder.parallel(Parallel::Policy::RequireAll, Parallel::Policy::RequireOne)
+        .action([&fast](Blackboard &) {
+            ++fast;
+            return Status::Success;
+        })
+        .throttle(std::chrono::milliseconds(10))
+        .sequence()
+        .action([&slow](Blackboard &) {
+            ++slow;
+            return Status::Success;
+        })
+        .throttle(std::chrono::milliseconds(50))
+        .subtree(planner)
+        .end()
+        .end();
+    Tree tree = builder.build();
+    tree.setClock(clock);
+
+    // The parallel and the sequence reset their children after every completion; the throttles keep their
+    // schedule anyway
+    for (int ms = 0; ms < 100; ++ms) {
+        CHECK(tree.tick() == Status::Success);
+        clock->advance(std::chrono::milliseconds(1));
+    }
+    CHECK(fast == 100);
+    CHECK(slow == 10);
+    CHECK(planned == 2);
+}
+
+TEST_CASE("ThrottleNode - A running child is ticked on schedule and restarts after a reset") {
+    auto clock = std::make_shared<SimulatedClock>();
+    int calls = 0;
+    auto child = std::make_shared<Action>([&calls](Blackboard &) {
+        ++calls;
+        return Status::Running;
+    });
+    auto throttle = std::make_shared<ThrottleNode>(child, std::chrono::seconds(1));
+    Tree tree(throttle);
+    tree.setClock(clock);
+
+    CHECK(tree.tick() == Status::Running);
+    CHECK(tree.tick() == Status::Running);
+    CHECK(calls == 1);
+    CHECK(throttle->state() == Node::State::Running);
+
+    tree.reset();
+    CHECK(tree.tick() == Status::Running); // the running status was dropped, so the child runs now
+    CHECK(calls == 2);
+
+    tree.halt();
+    CHECK(throttle->tick(tree.blackboard()) == Status::Failure);
+    tree.reset();
+    throttle->invalidate();
+    CHECK(tree.tick() == Status::Running);
+    CHECK(calls == 3);
+}
+
 // ============================================================================
 // Integration Tests
 // ============================================================================
@@ -0,0 +1,57 @@
+#include <stateup/core/alias_table.hpp>
+#include <doctest/doctest.h>
+#include <random>
+#include <vector>
+
+using stateup::core::AliasTable;
+
+TEST_CASE("AliasTable - draws follow the weights") {
+    const std::vector<float> weights = {1.0f, 0.0f, 2.0f, -4.0f, 5.0f, 0.5f, 0.0f, 1.5f};
+    AliasTable table(weights);
+    REQUIRE_FALSE(table.empty());
+    CHECK(table.size() == weights.size());
+    CHECK(table.total() == doctest::Approx(10.0));
+
+    std::mt19937 rng(42);
+    constexpr int kDraws = 200'000;
+    std::vector<int> counts(weights.size(), 0);
+    for (int i = 0; i < kDraws; ++i) {
+        const size_t index = table.sample(rng);
+        REQUIRE(index < weights.size());
+        ++counts[index];
+    }
+    for (size_t i = 0; i < weights.size(); ++i) {
+        const double expected = weights[i] > 0.0f ? weights[i] / 10.0 : 0.0;
+        if (expected == 0.0) {
+            CHECK(counts[i] == 0);
+        } else {
+            CHECK(counts[i] / static_cast<double>(kDraws) == doctest::Approx(expected).epsilon(0.05));
+        }
+    }
+}
+
+TEST_CASE("AliasTable - rebuilds in place and reports empty weights") {
+    AliasTable table;
+    CHECK(table.empty());
+    CHECK_FALSE(table.build({0.0f, -1.0f}));
+    CHECK(table.empty());
+
+    std::mt19937 rng(7);
+    REQUIRE(table.build({0.0f, 0.0f, 3.0f}));
+    for (int i = 0; i < 100; ++i) {
+        CHECK(table.sample(rng) == 2);
+    }
+
+    // A single entry and many equal entries both work
+    REQUIRE(table.build({0.25f}));
+    CHECK(table.sample(rng) == 0);
+    std::vector<float> wide(500, 1.0f);
+    REQUIRE(table.build(wide));
+    std::vector<int> seen(wide.size(), 0);
+    for (int i = 0; i < 50'000; ++i) {
+        ++seen[table.sample(rng)];
+    }
+    for (int count : seen) {
+        CHECK(count > 40); // ~100 each
+    }
+}
@@ -0,0 +1,184 @@
+#include <stateup/stateup.hpp>
+#include <stateup/tree/events.hpp>
+#include <doctest/doctest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+// Replaces the global allocation functions for this test binary and counts every heap allocation made while an
+// AllocationAudit is alive, on any thread. A warmed-up tick of the trees and machines below must not allocate.
+
+namespace {
+    std::atomic<bool> auditing{false};
+    std::atomic<size_t> allocations{0};
+
+    void *allocate(std::size_t size) {
+        if (auditing.load(std::memory_order_relaxed))
+            allocations.fetch_add(1, std::memory_order_relaxed);
+        if (void *p = std::malloc(size ? size : 1))
+            return p;
+        throw std::bad_alloc();
+    }
+
+    void *allocateAligned(std::size_t size, std::align_val_t align) {
+        if (auditing.load(std::memory_order_relaxed))
+            allocations.fetch_add(1, std::memory_order_relaxed);
+        const std::size_t alignment = static_cast<std::size_t>(align);
+        if (void *p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment))
+            return p;
+        throw std::bad_alloc();
+    }
+
+    struct AllocationAudit {
+        AllocationAudit() {
+            allocations.store(0);
+            auditing.store(true);
+        }
+        ~AllocationAudit() { auditing.store(false); }
+        size_t count() const { return allocations.load(); }
+    };
+
+    // Ticks once to warm up, then counts the allocations of the following ticks
+    template <typename F> size_t allocationsPerRun(F &&tick, int runs = 100) {
+        tick();
+        tick();
+        AllocationAudit audit;
+        for (int i = 0; i < runs; ++i) {
+            tick();
+        }
+        return audit.count();
+    }
+} // namespace
+
+void *operator new(std::size_t size) { return allocate(size); }
+void *operator new[](std::size_t size) { return allocate(size); }
+void *operator new(std::size_t size, std::align_val_t align) { return allocateAligned(size, align); }
+void *operator new[](std::size_t size, std::align_val_t align) { return allocateAligned(size, align); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+using namespace stateup;
+using namespace stateup::tree;
+
+TEST_CASE("Allocation audit - the counter sees allocations") {
+    Blackboard bb;
+    AllocationAudit audit;
+    bb.set("long", std::string(100, 'x'));
+    CHECK(audit.count() > 0);
+}
+
+TEST_CASE("Allocation audit - composites, decorators, caches and blackboard access") {
+    auto tree = Builder()
+                    .sequence()
+                    .action([](Blackboard &bb) {
+                        bb.set("ticks", bb.get<int>("ticks").value_or(0) + 1);
+                        return Status::Success;
+                    })
+                    .selector()
+                    .inverter()
+                    .action([](Blackboard &bb) { return bb.has("ticks") ? Status::Success : Status::Failure; })
+                    .action([](Blackboard &) { return Status::Success; })
+                    .end()
+                    .reactiveSequence()
+                    .action([](Blackboard &bb) { return bb.get<int>("ticks").value_or(0) > 0 ? Status::Success : Status::Failure; })
+                    .succeeder()
+                    .action([](Blackboard &) { return Status::Failure; })
+                    .end()
+                    .cached()
+                    .action([](Blackboard &bb) { return bb.get<int>("limit").value_or(0) > 0 ? Status::Success : Status::Failure; })
+                    .cached()
+                    .action([](Blackboard &bb) { return bb.get<int>("ticks").value_or(0) > 0 ? Status::Success : Status::Failure; })
+                    .repeat(3)
+                    .action([](Blackboard &) { return Status::Success; })
+                    .retry(2)
+                    .action([](Blackboard &) { return Status::Success; })
+                    .switchNode([](Blackboard &bb) { return std::string(bb.get<int>("ticks").value_or(0) % 2 ? "odd" : "even"); })
+                    .addCase("odd", [](Builder &b) { b.action([](Blackboard &) { return Status::Success; }); })
+                    .addCase("even", [](Builder &b) { b.action([](Blackboard &) { return Status::Success; }); })
+                    .end()
+                    .build();
+
+    tree.blackboard().set("limit", 1);
+    // repeat(3) reports Running between iterations, so not every tick succeeds
+    CHECK(allocationsPerRun([&] { CHECK(tree.tick() != Status::Failure); }) == 0);
+    CHECK(tree.blackboard().get<int>("ticks").value_or(0) > 0);
+}
+
+TEST_CASE("Allocation audit - running, parked and debounced children") {
+    auto tree = Builder()
+                    .parallel(Parallel::Policy::RequireAll, Parallel::Policy::RequireOne)
+                    .action([](Blackboard &) { return Status::Running; })
+                    .actionTask([](Blackboard &) -> core::task<Status> {
+                        co_await sleepFor(std::chrono::hours(1));
+                        co_return Status::Success;
+                    })
+                    .action([](Blackboard &bb) { return bb.has("missing") ? Status::Failure : Status::Running; })
+                    .debounce(std::chrono::hours(1))
+                    .action([](Blackboard &) { return Status::Success; })
+                    .end()
+                    .build();
+
+    CHECK(allocationsPerRun([&] { CHECK(tree.tick() == Status::Running); }) == 0);
+}
+
+TEST_CASE("Allocation audit - monitored ticks with a deadline") {
+    auto tree = Builder()
+                    .sequence()
+                    .action([](Blackboard &) { return Status::Success; })
+                    .action([](Blackboard &) { return Status::Success; })
+                    .end()
+                    .build();
+    tree.monitor();
+
+    CHECK(allocationsPerRun([&] { CHECK(tree.tickWithin(std::chrono::seconds(1)) == Status::Success); }) == 0);
+    CHECK(tree.monitor().stats().ticks == 102);
+}
+
+TEST_CASE("Allocation audit - state machine without a firing transition") {
+    state::StateMachine machine;
+    auto idle = std::make_shared<state::State>("Idle");
+    auto walk = std::make_shared<state::State>("Walk");
+    machine.addState(idle);
+    machine.addState(walk);
+    machine.setInitialState(idle);
+    machine.addTransition(idle, walk, [](Blackboard &bb) { return bb.get<int>("speed").value_or(0) > 5; });
+    machine.addTransition(idle, walk, [](Blackboard &bb) { return bb.has("go"); });
+    machine.blackboard().set("speed", 1);
+
+    CHECK(allocationsPerRun([&] { machine.tick(); }) == 0);
+    CHECK(machine.getCurrentStateName() == "Idle");
+}
+
+TEST_CASE("Allocation audit - state machine firing a transition every tick") {
+    state::StateMachine machine;
+    auto idle = std::make_shared<state::State>("Idle, waiting for orders");
+    auto walk = std::make_shared<state::State>("Walking to the next waypoint");
+    machine.addState(idle);
+    machine.addState(walk);
+    machine.setInitialState(idle);
+    machine.addTransition(idle, walk, [](Blackboard &) { return true; });
+    machine.addTransition(walk, idle, [](Blackboard &) { return true; });
+
+    // Runs past the history ring's capacity, so old entries are overwritten too
+    CHECK(allocationsPerRun([&] { machine.tick(); }, 250) == 0);
+    CHECK(machine.getStateHistory().size() == 100);
+    CHECK(machine.getStateHistory().back() == machine.getCurrentStateName());
+}
+
+TEST_CASE("Allocation audit - publishing to subscribers") {
+    EventBus bus;
+    int received = 0;
+    bus.subscribe("tick", [&received](const EventDataPtr &) { ++received; });
+    bus.subscribe("tick", [&received](const EventDataPtr &) { ++received; });
+    const std::string event = "tick";
+
+    CHECK(allocationsPerRun([&] { bus.publish(event); }) == 0);
+    CHECK(received == 2 * 102);
+}
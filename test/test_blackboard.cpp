@@ -160,3 +160,113 @@ TEST_CASE("Blackboard observer notifications") {
     CHECK(events[2].type == Blackboard::Event::Type::Get);
     CHECK_FALSE(events[2].success);
 }
+
+TEST_CASE("Blackboard lock policies") {
+    const LockPolicy policies[] = {LockPolicy::None, LockPolicy::Mutex, LockPolicy::SharedMutex, LockPolicy::Sharded};
+
+    for (auto policy : policies) {
+        Blackboard bb(policy);
+        CHECK(bb.lockPolicy() == policy);
+
+        bb.set("a", 1);
+        bb.set("b", std::string("two"));
+        REQUIRE(bb.get<int>("a").has_value());
+        CHECK(bb.get<int>("a").value() == 1);
+        CHECK(bb.get<std::string>("b").value() == "two");
+        CHECK_FALSE(bb.get<float>("a").has_value());
+        CHECK(bb.has("b"));
+        CHECK(bb.getAllKeys().size() == 2);
+
+        {
+            auto scope = bb.pushScope();
+            bb.set("a", 10);
+            CHECK(bb.get<int>("a").value() == 10);
+        }
+        CHECK(bb.get<int>("a").value() == 1);
+
+        bb.remove("a");
+        CHECK_FALSE(bb.has("a"));
+        bb.clear();
+        CHECK(bb.getAllKeys().empty());
+    }
+}
+
+TEST_CASE("Blackboard lock policy can be switched keeping entries") {
+    Blackboard bb(LockPolicy::None);
+    for (int i = 0; i < 64; ++i) {
+        bb.set("key_" + std::to_string(i), i);
+    }
+    auto scope = bb.pushScope();
+    bb.set("key_0", -1);
+
+    bb.setLockPolicy(LockPolicy::Sharded);
+    CHECK(bb.lockPolicy() == LockPolicy::Sharded);
+    CHECK(bb.getAllKeys().size() == 64);
+    CHECK(bb.get<int>("key_0").value() == -1);
+    CHECK(bb.get<int>("key_63").value() == 63);
+
+    scope.release();
+    CHECK(bb.get<int>("key_0").value() == 0);
+
+    bb.setLockPolicy(LockPolicy::SharedMutex);
+    CHECK(bb.get<int>("key_42").value() == 42);
+}
+
+TEST_CASE("Blackboard locked policies are thread safe") {
+    const LockPolicy policies[] = {LockPolicy::Mutex, LockPolicy::SharedMutex, LockPolicy::Sharded};
+
+    for (auto policy : policies) {
+        Blackboard bb(policy);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&bb, t]() {
+                for (int j = 0; j < 200; ++j) {
+                    std::string key = "t" + std::to_string(t) + "_" + std::to_string(j);
+                    bb.set(key, j);
+                    bb.set("shared", j);
+                    (void)bb.get<int>("shared");
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        CHECK(bb.getAllKeys().size() == 8 * 200 + 1);
+        CHECK(bb.get<int>("t7_199").value() == 199);
+    }
+}
+
+TEST_CASE("Lock policy is configurable from tree and state machine builders") {
+    auto caller = std::this_thread::get_id();
+    std::vector<std::thread::id> seen(3);
+
+    Builder builder;
+    builder.lockPolicy(LockPolicy::None).parallel(Parallel::Policy::RequireAll, Parallel::Policy::RequireOne);
+    for (size_t i = 0; i < seen.size(); ++i) {
+        builder.action([&seen, i](Blackboard &bb) {
+            seen[i] = std::this_thread::get_id();
+            bb.set("child_" + std::to_string(i), true);
+            return Status::Success;
+        });
+    }
+    auto tree = builder.end().build();
+
+    CHECK(tree.lockPolicy() == LockPolicy::None);
+    CHECK(tree.tick() == Status::Success);
+    for (auto id : seen) {
+        CHECK(id == caller);
+    }
+    CHECK(tree.blackboard().get<bool>("child_2").value());
+
+    auto machine = stateup::state::Builder()
+                       .state("idle")
+                       .transitionTo("done", [](Blackboard &bb) { return bb.get<bool>("go").value_or(false); })
+                       .initial("idle")
+                       .lockPolicy(LockPolicy::Sharded)
+                       .build();
+    CHECK(machine->lockPolicy() == LockPolicy::Sharded);
+    machine->tick();
+    machine->blackboard().set("go", true);
+    machine->tick();
+    CHECK(machine->getCurrentStateName() == "done");
+}
@@ -0,0 +1,190 @@
+#include <stateup/stateup.hpp>
+#include <stateup/tree/blackboard_replication.hpp>
+#include <doctest/doctest.h>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace stateup::tree;
+
+TEST_CASE("Blackboard revisions track writes and structural changes") {
+    Blackboard bb;
+    CHECK(bb.revision() == 0);
+    bb.set("a", 1);
+    bb.set("b", 2);
+    CHECK(bb.revision() == 2);
+
+    std::vector<std::string> changed;
+    auto since = bb.forEachChangedSince(1, [&](const std::string &key, const std::any &, std::type_index) {
+        changed.push_back(key);
+    });
+    CHECK(since == 2);
+    CHECK(changed == std::vector<std::string>{"b"});
+
+    const auto structure = bb.structureRevision();
+    bb.remove("missing");
+    CHECK(bb.structureRevision() == structure);
+    bb.remove("a");
+    CHECK(bb.structureRevision() == structure + 1);
+    {
+        auto scope = bb.pushScope();
+        bb.set("b", 3);
+    }
+    CHECK(bb.structureRevision() == structure + 2);
+}
+
+TEST_CASE("Delta frames only carry changed keys") {
+    Blackboard leader;
+    Blackboard mirror;
+    DeltaEncoder encoder;
+    BlackboardFollower follower(mirror);
+    std::vector<std::uint8_t> frame;
+
+    for (int i = 0; i < 100; ++i) {
+        leader.set("key" + std::to_string(i), i);
+    }
+    CHECK(encoder.encode(leader, frame)); // first frame is a keyframe
+    const size_t keyframeSize = frame.size();
+    CHECK(follower.apply(frame));
+    CHECK(mirror.get<int>("key42").value() == 42);
+
+    leader.set("key7", 700);
+    leader.set("speed", 1.5);
+    CHECK_FALSE(encoder.encode(leader, frame));
+    CHECK(frame.size() < keyframeSize / 10);
+    CHECK(follower.apply(frame));
+    CHECK(mirror.get<int>("key7").value() == 700);
+    CHECK(mirror.get<double>("speed").value() == doctest::Approx(1.5));
+
+    // Nothing changed: header-only delta
+    CHECK_FALSE(encoder.encode(leader, frame));
+    CHECK(frame.size() == DeltaEncoder::kFrameHeaderSize);
+    CHECK(follower.apply(frame));
+
+    // Removal forces a keyframe so the follower drops the key too
+    leader.remove("key3");
+    CHECK(encoder.encode(leader, frame));
+    CHECK(follower.apply(frame));
+    CHECK_FALSE(mirror.has("key3"));
+    CHECK(mirror.getAllKeys().size() == leader.getAllKeys().size());
+}
+
+TEST_CASE("Follower waits for a keyframe after a missed delta") {
+    Blackboard leader;
+    Blackboard mirror;
+    DeltaEncoder encoder(TypeRegistry::defaults(), 4);
+    BlackboardFollower follower(mirror);
+    std::vector<std::uint8_t> frame;
+
+    leader.set("x", 1);
+    encoder.encode(leader, frame);
+    CHECK(follower.apply(frame));
+
+    leader.set("x", 2);
+    encoder.encode(leader, frame); // lost in transit
+    leader.set("y", 3);
+    encoder.encode(leader, frame);
+    CHECK_FALSE(follower.apply(frame));
+    CHECK_FALSE(follower.synchronized());
+
+    leader.set("z", 4);
+    encoder.encode(leader, frame);
+    CHECK_FALSE(follower.apply(frame));
+    CHECK(encoder.encode(leader, frame)); // every fourth frame is a keyframe
+    CHECK(follower.apply(frame));
+    CHECK(follower.synchronized());
+    CHECK(mirror.get<int>("x").value() == 2);
+    CHECK(mirror.get<int>("y").value() == 3);
+
+    std::vector<std::uint8_t> garbage(8, 0);
+    CHECK_THROWS_AS(follower.apply(garbage), std::runtime_error);
+}
+
+TEST_CASE("Replicator streams frames through the writer thread") {
+    Blackboard leader;
+    Blackboard mirror;
+    BlackboardFollower follower(mirror);
+    std::mutex mutex;
+    size_t applied = 0;
+
+    {
+        BlackboardReplicator replicator(leader, [&](const std::uint8_t *data, size_t size) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (follower.apply(data, size))
+                ++applied;
+        });
+        for (int tick = 0; tick < 500; ++tick) {
+            leader.set("tick", tick);
+            replicator.capture();
+        }
+        replicator.flush();
+        CHECK(replicator.capture()); // ring is empty again; picks up anything a dropped capture missed
+        replicator.flush();
+        auto stats = replicator.stats();
+        CHECK(stats.frames + stats.dropped == 501);
+        CHECK(stats.keyframes >= 1);
+        CHECK(stats.bytes > 0);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    CHECK(follower.synchronized());
+    CHECK(mirror.get<int>("tick").value() == 499);
+}
+
+TEST_CASE("Replicator drops captures when the ring is full without losing changes") {
+    Blackboard leader;
+    std::atomic<bool> release{false};
+    std::vector<std::vector<std::uint8_t>> frames;
+
+    BlackboardReplicator::Options options;
+    options.ringCapacity = 2;
+    BlackboardReplicator replicator(
+        leader,
+        [&](const std::uint8_t *data, size_t size) {
+            while (!release.load())
+                std::this_thread::yield();
+            frames.emplace_back(data, data + size);
+        },
+        options);
+
+    leader.set("a", 1);
+    CHECK(replicator.capture());
+    leader.set("b", 2);
+    CHECK(replicator.capture());
+    leader.set("c", 3);
+    CHECK_FALSE(replicator.capture()); // writer is stalled, ring holds two frames
+    CHECK(replicator.stats().dropped == 1);
+
+    release = true;
+    replicator.flush();
+    CHECK(replicator.capture()); // carries "c"
+    replicator.flush();
+
+    Blackboard mirror;
+    BlackboardFollower follower(mirror);
+    for (const auto &frame : frames) {
+        CHECK(follower.apply(frame));
+    }
+    CHECK(mirror.get<int>("c").value() == 3);
+}
+
+TEST_CASE("Replicated file stream can be replayed") {
+    const std::string filename = "/tmp/stateup_replication_test.bin";
+    Blackboard leader;
+    {
+        BlackboardReplicator replicator(leader, BlackboardReplicator::fileSink(filename));
+        for (int tick = 0; tick < 50; ++tick) {
+            leader.set("tick", tick);
+            leader.set("name", std::string("harvester"));
+            replicator.capture();
+        }
+    }
+
+    Blackboard mirror;
+    BlackboardFollower follower(mirror);
+    CHECK(follower.replay(filename) > 0);
+    CHECK(mirror.get<int>("tick").value() == 49);
+    CHECK(mirror.get<std::string>("name").value() == "harvester");
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,139 @@
+#include <stateup/stateup.hpp>
+#include <stateup/tree/blackboard_serializer.hpp>
+#include <doctest/doctest.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace stateup::tree;
+
+namespace {
+    struct Pose {
+        double x;
+        double y;
+        float yaw;
+    };
+
+    struct Waypoints {
+        std::vector<int> ids;
+    };
+} // namespace
+
+TEST_CASE("Binary snapshot round-trips builtin types") {
+    Blackboard source;
+    source.set("count", 42);
+    source.set("ratio", 0.5f);
+    source.set("distance", 12.25);
+    source.set("armed", true);
+    source.set("name", std::string("harvester"));
+    source.set("ticks", 123456789012LL);
+
+    BlackboardSerializer::SnapshotStats stats;
+    auto bytes = BlackboardSerializer::snapshot(source, TypeRegistry::defaults(), &stats);
+    CHECK(stats.records == 6);
+    CHECK(stats.skipped == 0);
+
+    Blackboard target;
+    target.set("stale", 1);
+    auto restored = BlackboardSerializer::restore(target, bytes);
+    CHECK(restored.records == 6);
+
+    CHECK_FALSE(target.has("stale"));
+    CHECK(target.get<int>("count").value() == 42);
+    CHECK(target.get<float>("ratio").value() == doctest::Approx(0.5f));
+    CHECK(target.get<double>("distance").value() == doctest::Approx(12.25));
+    CHECK(target.get<bool>("armed").value());
+    CHECK(target.get<std::string>("name").value() == "harvester");
+    CHECK(target.get<long long>("ticks").value() == 123456789012LL);
+}
+
+TEST_CASE("Binary snapshot uses registered codecs and skips unknown types") {
+    TypeRegistry registry = TypeRegistry::defaults();
+    registry.registerType<Pose>("test::Pose");
+
+    Blackboard source;
+    source.set("pose", Pose{1.0, 2.0, 0.25f});
+    source.set("route", Waypoints{{1, 2, 3}});
+
+    BlackboardSerializer::SnapshotStats stats;
+    auto bytes = BlackboardSerializer::snapshot(source, registry, &stats);
+    CHECK(stats.records == 1);
+    CHECK(stats.skipped == 1);
+
+    registry.registerType<Waypoints>(
+        "test::Waypoints",
+        [](const Waypoints &value, std::vector<std::uint8_t> &out) {
+            for (int id : value.ids)
+                out.push_back(static_cast<std::uint8_t>(id));
+        },
+        [](const std::uint8_t *data, size_t size, Waypoints &value) {
+            value.ids.assign(data, data + size);
+            return true;
+        });
+    bytes = BlackboardSerializer::snapshot(source, registry, &stats);
+    CHECK(stats.records == 2);
+
+    Blackboard target;
+    BlackboardSerializer::restore(target, bytes, registry);
+    auto pose = target.get<Pose>("pose");
+    REQUIRE(pose.has_value());
+    CHECK(pose->x == doctest::Approx(1.0));
+    CHECK(pose->yaw == doctest::Approx(0.25f));
+    CHECK(target.get<Waypoints>("route")->ids == std::vector<int>{1, 2, 3});
+
+    // A reader without the custom codecs skips those records
+    Blackboard partial;
+    auto partialStats = BlackboardSerializer::restore(partial, bytes);
+    CHECK(partialStats.records == 0);
+    CHECK(partialStats.skipped == 2);
+}
+
+TEST_CASE("Binary snapshot rejects malformed data") {
+    Blackboard bb;
+    std::vector<std::uint8_t> garbage{'n', 'o', 'p', 'e'};
+    CHECK_THROWS_AS(BlackboardSerializer::restore(bb, garbage), std::runtime_error);
+
+    Blackboard source;
+    source.set("value", 7);
+    auto bytes = BlackboardSerializer::snapshot(source);
+    bytes.resize(bytes.size() - 2);
+    CHECK_THROWS_AS(BlackboardSerializer::restore(bb, bytes), std::runtime_error);
+}
+
+TEST_CASE("Binary snapshot through a memory-mapped file") {
+    const std::string path = "/tmp/stateup_snapshot_test.bin";
+
+    Blackboard source;
+    const int entries = 100000;
+    for (int i = 0; i < entries; ++i) {
+        source.set("key_" + std::to_string(i), i);
+    }
+    REQUIRE(BlackboardSerializer::saveSnapshot(source, path));
+
+    Blackboard target;
+    auto start = std::chrono::steady_clock::now();
+    REQUIRE(BlackboardSerializer::loadSnapshot(target, path));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    CHECK(target.getAllKeys().size() == static_cast<size_t>(entries));
+    CHECK(target.get<int>("key_99999").value() == 99999);
+    CHECK(elapsed < std::chrono::seconds(2));
+    std::remove(path.c_str());
+
+    CHECK_FALSE(BlackboardSerializer::loadSnapshot(target, "/nonexistent/dir/snapshot.bin"));
+}
+
+TEST_CASE("Text serialization reads each entry once without observer events") {
+    Blackboard bb;
+    bb.set("speed", 1.5);
+    bb.set("label", std::string("row"));
+
+    int events = 0;
+    bb.setObserver([&events](const Blackboard::Event &) { ++events; });
+    auto text = BlackboardSerializer::serialize(bb);
+
+    CHECK(events == 0);
+    CHECK(text.find("\"speed\"") != std::string::npos);
+    CHECK(text.find("\"value\": \"row\"") != std::string::npos);
+}
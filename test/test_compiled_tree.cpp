@@ -0,0 +1,250 @@
+#include <stateup/stateup.hpp>
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace stateup::tree;
+
+namespace {
+    using Trace = std::vector<std::string>;
+
+    // Scripted action: returns the given statuses in turn (last one repeats) and records each call
+    Action::Func scripted(Trace &trace, std::string name, std::vector<Status> script) {
+        // Too big to sit inline in an Action::Func, so the script lives behind a pointer
+        struct Script {
+            std::string name;
+            std::vector<Status> statuses;
+            size_t calls = 0;
+        };
+        auto state = std::make_shared<Script>(Script{std::move(name), std::move(script)});
+        return [&trace, state](Blackboard &) {
+            trace.push_back(state->name);
+            return state->statuses[std::min(state->calls++, state->statuses.size() - 1)];
+        };
+    }
+
+    void describe(Builder &builder, Trace &trace) {
+        builder.sequence()
+            .action(scripted(trace, "a", {Status::Success}))
+            .selector()
+            .action(scripted(trace, "b", {Status::Failure, Status::Running, Status::Success}))
+            .inverter()
+            .action(scripted(trace, "c", {Status::Success, Status::Failure}))
+            .end()
+            .repeat(2)
+            .action(scripted(trace, "d", {Status::Success, Status::Running, Status::Success}))
+            .retry(3)
+            .action(scripted(trace, "e", {Status::Failure, Status::Failure, Status::Success}))
+            .parallel(Parallel::Policy::RequireAll, Parallel::Policy::RequireOne)
+            .action(scripted(trace, "p", {Status::Running, Status::Success}))
+            .end()
+            .condition([](Blackboard &bb) { return bb.get<int>("flag").value_or(0) > 0; },
+                       [&trace](Builder &then) { then.action(scripted(trace, "then", {Status::Success})); },
+                       [&trace](Builder &otherwise) { otherwise.action(scripted(trace, "else", {Status::Success})); })
+            .end();
+    }
+} // namespace
+
+TEST_CASE("CompiledTree ticks identically to the pointer tree") {
+    Trace pointerTrace, compiledTrace;
+    Builder pointerBuilder, compiledBuilder;
+    describe(pointerBuilder, pointerTrace);
+    describe(compiledBuilder, compiledTrace);
+
+    auto tree = pointerBuilder.lockPolicy(LockPolicy::None).build();
+    auto compiled = compiledBuilder.lockPolicy(LockPolicy::None).buildCompiled();
+
+    CHECK(compiled.lockPolicy() == LockPolicy::None);
+    CHECK(compiled.embeddedCount() == 2); // parallel and condition
+
+    for (int i = 0; i < 24; ++i) {
+        if (i == 10) {
+            tree.blackboard().set("flag", 1);
+            compiled.blackboard().set("flag", 1);
+        }
+        if (i == 15) {
+            tree.halt();
+            compiled.halt();
+        }
+        CHECK(tree.tick() == compiled.tick());
+    }
+    CHECK(pointerTrace == compiledTrace);
+}
+
+TEST_CASE("CompiledTree lowers plain trees completely") {
+    int ticks = 0;
+    auto compiled = Builder()
+                        .selector()
+                        .failer()
+                        .action([&](Blackboard &) {
+                            ++ticks;
+                            return Status::Success;
+                        })
+                        .sequence()
+                        .action([&](Blackboard &bb) {
+                            bb.set("reached", true);
+                            return Status::Success;
+                        })
+                        .end()
+                        .end()
+                        .buildCompiled();
+
+    CHECK(compiled.size() == 5);
+    CHECK(compiled.embeddedCount() == 0);
+    CHECK(compiled.tick() == Status::Success);
+    CHECK(ticks == 1);
+    CHECK(compiled.blackboard().get<bool>("reached").value_or(false));
+}
+
+TEST_CASE("CompiledTree keeps shared and async nodes embedded") {
+    int calls = 0;
+    auto shared = std::make_shared<Action>(Action::Func([&](Blackboard &) {
+        ++calls;
+        return Status::Success;
+    }));
+    auto root = std::make_shared<Sequence>();
+    root->addChild(shared);
+    root->addChild(std::make_shared<SubtreeNode>(shared));
+    root->addChild(std::make_shared<Action>(Action::TaskFunc([](Blackboard &) -> stateup::core::task<Status> {
+        co_return Status::Success;
+    })));
+
+    CompiledTree compiled(root);
+    CHECK(compiled.embeddedCount() == 3); // both uses of the shared action, and the coroutine action
+    CHECK(compiled.tick() == Status::Success);
+    CHECK(calls == 2);
+
+    // The embedded nodes are the source tree's, so the compiled definition serves no second instance
+    CHECK_THROWS_AS(TreeInstance(compiled.definition()), std::invalid_argument);
+
+    CompiledTree empty(nullptr);
+    CHECK(empty.size() == 0);
+    CHECK(empty.tick() == Status::Failure);
+}
+
+TEST_CASE("TreeInstances of one definition keep separate run state") {
+    int describes = 0;
+    auto definition = TreeDefinition::define([&](Builder &builder) {
+        ++describes;
+        builder.sequence()
+            .action([](Blackboard &bb) {
+                int step = bb.get<int>("step").value_or(0);
+                bb.set("step", step + 1);
+                return step == 0 ? Status::Running : Status::Success;
+            })
+            .retry(2)
+            .action([](Blackboard &bb) { return bb.has("ready") ? Status::Success : Status::Failure; })
+            .end();
+    });
+    CHECK(describes == 1);
+    CHECK(definition->embeddedCount() == 0);
+
+    TreeInstance first(definition, LockPolicy::None);
+    TreeInstance second(definition, LockPolicy::None);
+    CHECK(describes == 1); // fully lowered: instances never rebuild the tree
+    second.blackboard().set("ready", true);
+
+    CHECK(first.tick() == Status::Running);
+    CHECK(first.tick() == Status::Running); // first retry attempt failed
+    CHECK(second.tick() == Status::Running);
+    CHECK(second.tick() == Status::Success);
+    CHECK(first.tick() == Status::Failure); // second attempt failed, retry exhausted
+    CHECK(first.blackboard().get<int>("step").value() == 2);
+    CHECK(second.blackboard().get<int>("step").value() == 2);
+}
+
+TEST_CASE("TreeDefinition gives embedded nodes and reused subtrees per-instance state") {
+    int describes = 0;
+    auto definition = TreeDefinition::define([&](Builder &builder) {
+        ++describes;
+        auto patrol = std::make_shared<Sequence>();
+        patrol->addChild(std::make_shared<Action>(Action::Func([](Blackboard &bb) {
+            bb.set("patrols", bb.get<int>("patrols").value_or(0) + 1);
+            return Status::Running;
+        })));
+        builder.selector()
+            .subtree(patrol)
+            .subtree(patrol)
+            .whileLoop([](Blackboard &) { return false; }, [](Builder &body) {
+                body.action([](Blackboard &) { return Status::Success; });
+            })
+            .end();
+    });
+    CHECK(definition->embeddedCount() == 1); // the while loop; the shared patrol subtree is inlined twice
+
+    TreeInstance a(definition, LockPolicy::None);
+    TreeInstance b(definition, LockPolicy::None);
+    CHECK(describes == 3);
+    CHECK(a.tick() == Status::Running);
+    CHECK(a.tick() == Status::Running);
+    CHECK(b.tick() == Status::Running);
+    CHECK(a.blackboard().get<int>("patrols").value() == 2);
+    CHECK(b.blackboard().get<int>("patrols").value() == 1);
+
+    CHECK_THROWS_AS(TreeInstance(nullptr), std::invalid_argument);
+}
+
+TEST_CASE("TreeDefinition embeds stateful decorators per instance") {
+    auto definition = TreeDefinition::define([](Builder &builder) {
+        builder.sequence()
+            .inverter()
+            .action([](Blackboard &) { return Status::Failure; })
+            .decorator(decorators::Repeat(3))
+            .action([](Blackboard &bb) {
+                bb.set("runs", bb.get<int>("runs").value_or(0) + 1);
+                return Status::Success;
+            })
+            .end();
+    });
+    CHECK(definition->embeddedCount() == 1); // the repeat; the stateless inverter is lowered
+
+    TreeInstance x(definition, LockPolicy::None);
+    TreeInstance y(definition, LockPolicy::None);
+    CHECK(x.tick() == Status::Running);
+    CHECK(y.tick() == Status::Running);
+    CHECK(x.tick() == Status::Running); // y's run does not count towards x's three
+    CHECK(x.tick() == Status::Success);
+    CHECK(x.blackboard().get<int>("runs").value() == 3);
+    CHECK(y.tick() == Status::Running);
+    CHECK(y.tick() == Status::Success);
+}
+
+TEST_CASE("Destroying a CompiledTree joins its concurrent jobs before its blackboard") {
+    // Records, when the blackboard drops it, whether the job ticking on that blackboard had finished
+    struct Sentinel {
+        std::shared_ptr<std::atomic<bool>> finished;
+        bool *finishedFirst;
+        ~Sentinel() { *finishedFirst = finished->load(); }
+    };
+
+    stateup::core::ThreadPool pool(1);
+    auto started = std::make_shared<std::atomic<bool>>(false);
+    auto finished = std::make_shared<std::atomic<bool>>(false);
+    bool finishedFirst = false;
+    {
+        auto tree = Builder()
+                        .executor(&pool)
+                        .concurrentParallel(Parallel::Policy::RequireAll, Parallel::Policy::RequireOne)
+                        .action([started, finished](Blackboard &bb) {
+                            started->store(true);
+                            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                            bb.set("done", true);
+                            finished->store(true);
+                            return Status::Success;
+                        })
+                        .end()
+                        .buildCompiled();
+        CHECK(tree.embeddedCount() == 1);
+        tree.blackboard().set("sentinel", std::make_shared<Sentinel>(Sentinel{finished, &finishedFirst}));
+        CHECK(tree.tick() == Status::Running);
+        while (!started->load())
+            std::this_thread::yield();
+    } // destroyed mid-job
+    CHECK(finished->load());
+    CHECK(finishedFirst);
+}
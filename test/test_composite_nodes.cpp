@@ -1,7 +1,13 @@
 #include <stateup/stateup.hpp>
 #include <doctest/doctest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 using namespace stateup::tree;
 
@@ -9,6 +15,7 @@ namespace {
     struct TrackingNode : Node {
         std::function<Status()> behavior;
         int haltCount = 0;
+        int resetCount = 0;
 
         Status tick(Blackboard &) override {
             setState(State::Running);
@@ -18,7 +25,10 @@ namespace {
             return result;
         }
 
-        void reset() override { Node::reset(); }
+        void reset() override {
+            ++resetCount;
+            Node::reset();
+        }
 
         void halt() override {
             ++haltCount;
@@ -315,3 +325,362 @@ TEST_CASE("Parallel threshold behavior") {
         CHECK(parallel.tick(bb) == Status::Failure);
     }
 }
+
+TEST_CASE("Parallel concurrent mode") {
+    using namespace std::chrono_literals;
+    using Clock = std::chrono::steady_clock;
+    stateup::core::ThreadPool pool(3);
+
+    SUBCASE("Ticks return without waiting and losers are cancelled") {
+        std::atomic<bool> sawCancel{false};
+        auto slow = std::make_shared<Action>([&](Blackboard &) {
+            for (int i = 0; i < 100; ++i) {
+                if (cancellationRequested()) {
+                    sawCancel = true;
+                    return Status::Failure;
+                }
+                std::this_thread::sleep_for(5ms);
+            }
+            return Status::Failure;
+        });
+        auto fast = std::make_shared<Action>([](Blackboard &) {
+            std::this_thread::sleep_for(20ms);
+            return Status::Success;
+        });
+
+        auto parallel = std::make_shared<Parallel>(Parallel::Policy::RequireOne, Parallel::Policy::RequireAll);
+        parallel->setMode(Parallel::Mode::Concurrent);
+        parallel->setExecutor(&pool);
+        parallel->addChild(slow);
+        parallel->addChild(fast);
+        Tree tree(parallel);
+
+        const auto start = Clock::now();
+        CHECK(tree.tick() == Status::Running);
+        CHECK(Clock::now() - start < 15ms);
+        CHECK(parallel->jobsInFlight() == 2);
+
+        Status status = Status::Running;
+        while (status == Status::Running) {
+            status = tree.tickWhenReady(1s);
+        }
+        CHECK(status == Status::Success);
+        CHECK(Clock::now() - start < 400ms);
+
+        // The slow child notices the cancellation and its job drains
+        for (int i = 0; i < 200 && parallel->jobsInFlight() > 0; ++i) {
+            std::this_thread::sleep_for(1ms);
+        }
+        CHECK(parallel->jobsInFlight() == 0);
+        CHECK(sawCancel);
+    }
+
+    SUBCASE("Running children are relaunched each tick") {
+        std::atomic<int> ticks{0};
+        auto counter = std::make_shared<Action>([&](Blackboard &) {
+            return ++ticks < 3 ? Status::Running : Status::Success;
+        });
+        Parallel parallel(Parallel::Policy::RequireAll, Parallel::Policy::RequireOne);
+        parallel.setMode(Parallel::Mode::Concurrent);
+        parallel.setExecutor(&pool);
+        parallel.addChild(counter);
+
+        Blackboard bb;
+        Status status = Status::Running;
+        for (int i = 0; i < 1000 && status == Status::Running; ++i) {
+            status = parallel.tick(bb);
+            std::this_thread::sleep_for(1ms);
+        }
+        CHECK(status == Status::Success);
+        CHECK(ticks == 3);
+    }
+
+    SUBCASE("Unlocked blackboards tick inline") {
+        auto tree = Builder()
+                        .lockPolicy(LockPolicy::None)
+                        .concurrentParallel(Parallel::Policy::RequireAll, Parallel::Policy::RequireOne)
+                        .action([](Blackboard &) { return Status::Success; })
+                        .end()
+                        .build();
+        CHECK(tree.tick() == Status::Success);
+    }
+}
+
+TEST_CASE("Parallel adaptive dispatch") {
+    using namespace std::chrono_literals;
+    stateup::core::ThreadPool pool(2);
+    const auto caller = std::this_thread::get_id();
+
+    std::mutex mutex;
+    std::vector<std::thread::id> cheapThreads, slowThreads;
+    auto record = [&mutex](std::vector<std::thread::id> &threads) {
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.push_back(std::this_thread::get_id());
+    };
+
+    auto parallel = std::make_shared<Parallel>(Parallel::Policy::RequireAll, Parallel::Policy::RequireOne);
+    parallel->setExecutor(&pool);
+    parallel->setPoolThreshold(1ms);
+    for (int i = 0; i < 3; ++i) {
+        parallel->addChild(std::make_shared<Action>([&](Blackboard &) {
+            record(cheapThreads);
+            return Status::Running;
+        }));
+    }
+    for (int i = 0; i < 2; ++i) {
+        parallel->addChild(std::make_shared<Action>([&](Blackboard &) {
+            std::this_thread::sleep_for(3ms);
+            record(slowThreads);
+            return Status::Running;
+        }));
+    }
+    Tree tree(parallel);
+
+    // Nothing is measured yet, so the first tick pools every child
+    CHECK(tree.tick() == Status::Running);
+    CHECK(parallel->childCost(0).measured());
+    CHECK(parallel->childCost(0).estimate() < 1ms);
+    CHECK(parallel->childCost(3).estimate() >= 1ms);
+
+    cheapThreads.clear();
+    slowThreads.clear();
+    CHECK(tree.tick() == Status::Running);
+    REQUIRE(cheapThreads.size() == 3);
+    REQUIRE(slowThreads.size() == 2);
+    for (auto id : cheapThreads) {
+        CHECK(id == caller);
+    }
+    for (auto id : slowThreads) {
+        CHECK(id != caller);
+    }
+
+    // With a single expensive child there is nothing to overlap, so it runs inline too
+    {
+        auto lone = std::make_shared<Parallel>(Parallel::Policy::RequireAll, Parallel::Policy::RequireOne);
+        lone->setExecutor(&pool);
+        lone->setPoolThreshold(1ms);
+        std::vector<std::thread::id> threads;
+        lone->addChild(std::make_shared<Action>([&](Blackboard &) {
+            std::this_thread::sleep_for(3ms);
+            threads.push_back(std::this_thread::get_id());
+            return Status::Success;
+        }));
+        Blackboard bb;
+        CHECK(lone->tick(bb) == Status::Success);
+        REQUIRE(threads.size() == 1);
+        CHECK(threads[0] == caller);
+    }
+}
+
+TEST_CASE("Pooled nodes nested on one single-worker pool") {
+    // Each selector issues its bulk from inside the parallel's, on the same pool and its only worker
+    using namespace std::chrono_literals;
+    stateup::core::ThreadPool pool(1);
+    std::atomic<int> ticks{0};
+    auto parallel = std::make_shared<Parallel>(Parallel::Policy::RequireAll, Parallel::Policy::RequireOne);
+    parallel->setExecutor(&pool);
+    parallel->setPoolThreshold(0ns);
+    for (int i = 0; i < 3; ++i) {
+        auto selector = std::make_shared<Selector>();
+        selector->setSpeculative(true);
+        selector->setExecutor(&pool);
+        selector->setPoolThreshold(0ns);
+        for (int c = 0; c < 3; ++c) {
+            selector->addChild(std::make_shared<Action>([&ticks, c](Blackboard &) {
+                ++ticks;
+                return c == 2 ? Status::Success : Status::Failure;
+            }),
+                               true);
+        }
+        parallel->addChild(selector);
+    }
+    Tree tree(parallel);
+
+    for (int i = 0; i < 10; ++i)
+        CHECK(tree.tick() == Status::Success);
+    CHECK(ticks == 90);
+}
+
+TEST_CASE("Halt and reset follow the active path") {
+    auto first = std::make_shared<TrackingNode>();
+    auto current = std::make_shared<TrackingNode>();
+    auto later = std::make_shared<TrackingNode>();
+    int currentTicks = 0;
+    current->behavior = [&currentTicks]() { return ++currentTicks < 3 ? Status::Running : Status::Success; };
+
+    auto sequence = std::make_shared<Sequence>();
+    sequence->addChild(first);
+    sequence->addChild(current);
+    sequence->addChild(later);
+    Tree tree(sequence);
+
+    CHECK(tree.tick() == Status::Running);
+    tree.halt();
+    CHECK(first->haltCount == 0);
+    CHECK(current->haltCount == 1);
+    CHECK(later->haltCount == 0);
+    CHECK_FALSE(later->isHalted());
+
+    // The halted tree resumes from the start and can reach children that were never running
+    CHECK(tree.tick() == Status::Running);
+    CHECK(tree.tick() == Status::Success);
+    CHECK(later->resetCount == 1);
+
+    SUBCASE("An idle composite does not walk its children") {
+        const int firstResets = first->resetCount;
+        tree.reset();
+        tree.halt();
+        CHECK(first->resetCount == firstResets);
+        CHECK(current->haltCount == 1);
+    }
+
+    SUBCASE("Parallel halts and resets only children it ticked") {
+        auto parallel = std::make_shared<Parallel>(Parallel::Policy::RequireOne, Parallel::Policy::RequireAll);
+        auto winner = std::make_shared<TrackingNode>();
+        auto untouched = std::make_shared<TrackingNode>();
+        parallel->addChild(winner);
+        parallel->addChild(untouched);
+
+        Blackboard bb(LockPolicy::None);
+        CHECK(parallel->tick(bb) == Status::Success); // the first child decides, the second is never ticked
+        CHECK(untouched->resetCount == 0);
+        parallel->halt();
+        CHECK(untouched->haltCount == 0);
+    }
+}
+
+TEST_CASE("Selector speculative mode") {
+    using namespace std::chrono_literals;
+    stateup::core::ThreadPool pool(3);
+
+    SUBCASE("Matches a plain selector tick for tick") {
+        constexpr int kPure = 4;
+        std::vector<Status> script(kPure, Status::Failure);
+        auto build = [&](bool speculative) {
+            Builder builder;
+            builder.executor(&pool);
+            if (speculative)
+                builder.speculativeSelector();
+            else
+                builder.selector();
+            for (int i = 0; i < kPure; ++i) {
+                builder.pure().action([&script, i](Blackboard &) { return script[i]; });
+            }
+            // An impure fallback records the tick it ran in
+            return builder
+                .action([](Blackboard &bb) {
+                    bb.set("fallback", bb.get<int>("tick").value_or(0));
+                    return Status::Failure;
+                })
+                .end()
+                .build();
+        };
+        Tree speculative = build(true);
+        Tree plain = build(false);
+        auto selector = std::static_pointer_cast<Selector>(speculative.getRoot());
+        REQUIRE(selector->speculative());
+        CHECK(selector->isPure(0));
+        CHECK_FALSE(selector->isPure(kPure));
+        selector->setPoolThreshold(0ns);
+
+        std::uint32_t seed = 7;
+        for (int tick = 1; tick <= 300; ++tick) {
+            for (auto &status : script) {
+                seed = seed * 1664525u + 1013904223u;
+                const int roll = static_cast<int>((seed >> 16) % 10);
+                status = roll < 7 ? Status::Failure : roll < 9 ? Status::Running : Status::Success;
+            }
+            speculative.blackboard().set("tick", tick);
+            plain.blackboard().set("tick", tick);
+            REQUIRE(speculative.tick() == plain.tick());
+            REQUIRE(speculative.blackboard().get<int>("fallback") == plain.blackboard().get<int>("fallback"));
+        }
+        CHECK(selector->speculativeTicks() > 0);
+    }
+
+    SUBCASE("Lower-priority children are cancelled once a higher one decides") {
+        auto failing = std::make_shared<TrackingNode>();
+        auto winner = std::make_shared<TrackingNode>();
+        auto running = std::make_shared<TrackingNode>();
+        failing->behavior = [] {
+            std::this_thread::sleep_for(2ms);
+            return Status::Failure;
+        };
+        winner->behavior = [] {
+            std::this_thread::sleep_for(2ms);
+            return Status::Success;
+        };
+        running->behavior = [] { return Status::Running; };
+
+        Tree tree = Builder()
+                        .executor(&pool)
+                        .speculativeSelector()
+                        .pure()
+                        .leaf(failing)
+                        .pure()
+                        .leaf(winner)
+                        .pure()
+                        .leaf(running)
+                        .end()
+                        .build();
+        auto selector = std::static_pointer_cast<Selector>(tree.getRoot());
+
+        CHECK(tree.tick() == Status::Success);
+        CHECK(selector->speculativeTicks() == 1);
+        CHECK(running->haltCount + running->resetCount >= 1); // cancelled, or skipped before it started
+        CHECK_FALSE(running->isHalted());
+        CHECK(failing->resetCount >= 1);
+    }
+
+    SUBCASE("A running child resumes alone") {
+        std::atomic<int> firstTicks{0}, secondTicks{0};
+        Tree tree = Builder()
+                        .executor(&pool)
+                        .speculativeSelector()
+                        .pure()
+                        .action([&firstTicks](Blackboard &) {
+                            return ++firstTicks < 3 ? Status::Running : Status::Failure;
+                        })
+                        .pure()
+                        .action([&secondTicks](Blackboard &) {
+                            ++secondTicks;
+                            return Status::Success;
+                        })
+                        .end()
+                        .build();
+        std::static_pointer_cast<Selector>(tree.getRoot())->setPoolThreshold(0ns);
+
+        // The second may tick alongside the first, its success thrown away, or be skipped once the first decided
+        CHECK(tree.tick() == Status::Running);
+        const int speculated = secondTicks;
+        CHECK(speculated <= 1);
+        CHECK(tree.tick() == Status::Running);
+        CHECK(secondTicks == speculated);
+        CHECK(tree.tick() == Status::Success);
+        CHECK(secondTicks == speculated + 1);
+    }
+
+    SUBCASE("Unmarked children and an unsynchronized blackboard tick in order") {
+        std::atomic<int> ticks{0};
+        Tree tree = Builder()
+                        .lockPolicy(LockPolicy::None)
+                        .executor(&pool)
+                        .speculativeSelector()
+                        .pure()
+                        .action([&ticks](Blackboard &) {
+                            ++ticks;
+                            return Status::Success;
+                        })
+                        .pure()
+                        .action([&ticks](Blackboard &) {
+                            ++ticks;
+                            return Status::Success;
+                        })
+                        .end()
+                        .build();
+        CHECK(tree.tick() == Status::Success);
+        CHECK(ticks == 1);
+        CHECK(std::static_pointer_cast<Selector>(tree.getRoot())->speculativeTicks() == 0);
+        CHECK_THROWS(Builder().selector().pure().end());
+    }
+}
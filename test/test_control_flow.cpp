@@ -231,6 +231,165 @@ TEST_CASE("SwitchNode") {
     }
 }
 
+TEST_CASE("IntSwitchNode") {
+    SUBCASE("Dense and sparse keys dispatch to their case") {
+        for (std::int64_t stride : {1, 7919, -1'000'003}) {
+            int executed = -1;
+            auto switchNode =
+                std::make_shared<IntSwitchNode>([](Blackboard &bb) { return bb.get<std::int64_t>("key").value_or(0); });
+            for (int i = 0; i < 100; ++i)
+                switchNode->addCase(i * stride + 5, std::make_shared<Action>([&executed, i](Blackboard &) {
+                                        executed = i;
+                                        return Status::Success;
+                                    }));
+            switchNode->setDefault(std::make_shared<Action>([&executed](Blackboard &) {
+                executed = -2;
+                return Status::Success;
+            }));
+
+            Tree tree(switchNode);
+            for (int i = 0; i < 100; ++i) {
+                tree.blackboard().set("key", i * stride + 5);
+                CHECK(tree.tick() == Status::Success);
+                CHECK(executed == i);
+            }
+            CHECK(switchNode->dispatch().dense() == (stride == 1));
+            tree.blackboard().set("key", std::int64_t(100) * stride + 5);
+            tree.tick();
+            CHECK(executed == -2);
+            tree.blackboard().set("key", std::int64_t(4));
+            tree.tick();
+            CHECK(executed == -2);
+        }
+    }
+
+    SUBCASE("Enum keys through the builder; a running case keeps running") {
+        enum class Mode { Idle, Patrol, Attack };
+        std::string executed;
+        int attackTicks = 0;
+
+        auto tree = Builder()
+                        .enumSwitch<Mode>([](Blackboard &bb) { return bb.get<Mode>("mode").value_or(Mode::Idle); })
+                        .addCase(Mode::Patrol,
+                                 [&](Builder &b) {
+                                     b.action([&](Blackboard &) {
+                                         executed = "patrol";
+                                         return Status::Success;
+                                     });
+                                 })
+                        .addCase(Mode::Attack,
+                                 [&](Builder &b) {
+                                     b.action([&](Blackboard &) {
+                                         executed = "attack";
+                                         return ++attackTicks < 2 ? Status::Running : Status::Success;
+                                     });
+                                 })
+                        .defaultCase([&](Builder &b) {
+                            b.action([&](Blackboard &) {
+                                executed = "default";
+                                return Status::Success;
+                            });
+                        })
+                        .build();
+
+        tree.blackboard().set("mode", Mode::Patrol);
+        CHECK(tree.tick() == Status::Success);
+        CHECK(executed == "patrol");
+
+        tree.blackboard().set("mode", Mode::Attack);
+        CHECK(tree.tick() == Status::Running);
+        tree.blackboard().set("mode", Mode::Patrol);
+        CHECK(tree.tick() == Status::Success);
+        CHECK(executed == "attack");
+
+        tree.blackboard().set("mode", Mode::Idle);
+        CHECK(tree.tick() == Status::Success);
+        CHECK(executed == "default");
+    }
+
+    SUBCASE("Fail when no match and no default; integer case without intSwitch() throws") {
+        auto switchNode = std::make_shared<IntSwitchNode>([](Blackboard &) { return std::int64_t(3); });
+        switchNode->addCase(1, std::make_shared<Action>([](Blackboard &) { return Status::Success; }));
+        Tree tree(switchNode);
+        CHECK(tree.tick() == Status::Failure);
+
+        CHECK_THROWS_AS(Builder().addCase(1, [](Builder &) {}), std::runtime_error);
+    }
+
+    SUBCASE("A halted switch fails without ticking a case until reset") {
+        int caseTicks = 0;
+        auto switchNode = std::make_shared<IntSwitchNode>([](Blackboard &) { return std::int64_t(1); });
+        switchNode->addCase(1, std::make_shared<Action>([&caseTicks](Blackboard &) {
+            ++caseTicks;
+            return Status::Running;
+        }));
+        Blackboard blackboard;
+        CHECK(switchNode->tick(blackboard) == Status::Running);
+
+        switchNode->halt();
+        CHECK(switchNode->tick(blackboard) == Status::Failure);
+        CHECK(switchNode->tick(blackboard) == Status::Failure);
+        CHECK(caseTicks == 1);
+
+        switchNode->reset();
+        CHECK(switchNode->tick(blackboard) == Status::Running);
+        CHECK(caseTicks == 2);
+    }
+
+    SUBCASE("Replacing a running case halts it; reset touches only the running case") {
+        struct Probe : Node {
+            Status result = Status::Running;
+            int ticks = 0, halts = 0, resets = 0;
+            Status tick(Blackboard &) override {
+                ++ticks;
+                return result;
+            }
+            void halt() override {
+                ++halts;
+                Node::halt();
+            }
+            void reset() override {
+                ++resets;
+                Node::reset();
+            }
+        };
+        auto running = std::make_shared<Probe>();
+        auto finished = std::make_shared<Probe>();
+        finished->result = Status::Success;
+        std::int64_t key = 1;
+        auto switchNode = std::make_shared<IntSwitchNode>([&key](Blackboard &) { return key; });
+        switchNode->addCase(1, running);
+        switchNode->addCase(2, finished);
+        Blackboard blackboard;
+
+        key = 2;
+        CHECK(switchNode->tick(blackboard) == Status::Success);
+        key = 1;
+        CHECK(switchNode->tick(blackboard) == Status::Running);
+        switchNode->reset();
+        CHECK(running->resets == 1);
+        CHECK(finished->resets == 0);
+
+        CHECK(switchNode->tick(blackboard) == Status::Running);
+        auto replacement = std::make_shared<Probe>();
+        replacement->result = Status::Success;
+        switchNode->addCase(1, replacement);
+        CHECK(running->halts == 1);
+        CHECK(running.use_count() == 1); // the switch no longer holds it
+        CHECK(switchNode->tick(blackboard) == Status::Success);
+        CHECK(replacement->ticks == 1);
+
+        // Same for a running default
+        auto fallback = std::make_shared<Probe>();
+        switchNode->setDefault(fallback);
+        key = 3;
+        CHECK(switchNode->tick(blackboard) == Status::Running);
+        switchNode->setDefault(finished);
+        CHECK(fallback->halts == 1);
+        CHECK(switchNode->tick(blackboard) == Status::Success);
+    }
+}
+
 TEST_CASE("MemoryNode") {
     SUBCASE("Remember success status") {
         int executionCount = 0;
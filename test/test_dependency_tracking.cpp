@@ -0,0 +1,255 @@
+#include <stateup/stateup.hpp>
+#include <doctest/doctest.h>
+
+using namespace stateup::tree;
+
+TEST_CASE("Blackboard - read recording and key revisions") {
+    Blackboard bb(LockPolicy::None);
+    bb.set("a", 1);
+    bb.set("b", 2);
+    CHECK(bb.keyRevision("missing") == 0);
+    CHECK(bb.keyRevision("b") > bb.keyRevision("a"));
+
+    Blackboard::ReadSet reads;
+    {
+        auto recording = bb.recordReads(reads);
+        bb.get<int>("a");
+        bb.get<int>("a");
+        bb.has("missing");
+    }
+    REQUIRE(reads.keys.size() == 2);
+    CHECK(bb.unchanged(reads));
+
+    SUBCASE("Writing an unread key keeps the set unchanged") {
+        bb.set("b", 3);
+        CHECK(bb.unchanged(reads));
+    }
+    SUBCASE("Writing a read key changes it, even with the same value") {
+        bb.set("a", 1);
+        CHECK_FALSE(bb.unchanged(reads));
+    }
+    SUBCASE("A key that was missing appearing changes it") {
+        bb.set("missing", true);
+        CHECK_FALSE(bb.unchanged(reads));
+    }
+    SUBCASE("Removals change it") {
+        bb.remove("b");
+        CHECK_FALSE(bb.unchanged(reads));
+    }
+    SUBCASE("Shadowing a read key in a new scope changes it") {
+        auto scope = bb.pushScope();
+        CHECK(bb.unchanged(reads));
+        bb.set("a", 5);
+        CHECK_FALSE(bb.unchanged(reads));
+    }
+    SUBCASE("Another blackboard never matches") {
+        Blackboard other(LockPolicy::None);
+        CHECK_FALSE(other.unchanged(reads));
+    }
+}
+
+TEST_CASE("Blackboard - nested recordings report to the enclosing one") {
+    Blackboard bb;
+    bb.set("outer", 1);
+    bb.set("inner", 2);
+
+    Blackboard::ReadSet outer, inner;
+    {
+        auto outerRecording = bb.recordReads(outer);
+        bb.get<int>("outer");
+        {
+            auto innerRecording = bb.recordReads(inner);
+            bb.get<int>("inner");
+        }
+    }
+    CHECK(inner.keys.size() == 1);
+    CHECK(outer.keys.size() == 2);
+
+    // Reads outside any recording are not tracked
+    bb.get<int>("outer");
+    CHECK(outer.keys.size() == 2);
+}
+
+TEST_CASE("memoize - re-evaluates only when recorded inputs change") {
+    int calls = 0;
+    auto enabled = memoize([&calls](Blackboard &bb) {
+        ++calls;
+        return bb.get<bool>("enabled").value_or(false);
+    });
+
+    auto reactive = std::make_shared<ReactiveSequence>();
+    reactive->addChild(std::make_shared<Action>([](Blackboard &bb) {
+                           bb.set("ticks", bb.get<int>("ticks").value_or(0) + 1);
+                           return Status::Running;
+                       }),
+                       enabled);
+    Tree tree(reactive);
+    tree.blackboard().set("enabled", true);
+
+    CHECK(tree.tick() == Status::Running);
+    CHECK(tree.tick() == Status::Running);
+    CHECK(tree.tick() == Status::Running);
+    CHECK(calls == 1);
+    CHECK(tree.blackboard().get<int>("ticks").value() == 3);
+
+    tree.blackboard().set("enabled", false);
+    CHECK(tree.tick() == Status::Failure);
+    CHECK(calls == 2);
+    CHECK(tree.tick() == Status::Failure);
+    CHECK(calls == 2);
+}
+
+TEST_CASE("memoize - declared keys drive a UtilitySelector") {
+    int scored = 0;
+    auto utility = std::make_shared<UtilitySelector>();
+    utility->addChild(std::make_shared<Action>([](Blackboard &bb) {
+                          bb.set("chosen", std::string("attack"));
+                          return Status::Success;
+                      }),
+                      memoize({"enemy"}, [&scored](Blackboard &bb) {
+                          ++scored;
+                          return bb.get<float>("enemy").value_or(0.0f);
+                      }));
+    utility->addChild(std::make_shared<Action>([](Blackboard &bb) {
+                          bb.set("chosen", std::string("rest"));
+                          return Status::Success;
+                      }),
+                      [](Blackboard &) { return 0.5f; });
+    Tree tree(utility);
+
+    tree.blackboard().set("enemy", 0.9f);
+    tree.tick();
+    tree.tick();
+    CHECK(scored == 1);
+    CHECK(tree.blackboard().get<std::string>("chosen").value() == "attack");
+
+    tree.blackboard().set("enemy", 0.1f);
+    tree.tick();
+    CHECK(scored == 2);
+    CHECK(tree.blackboard().get<std::string>("chosen").value() == "rest");
+}
+
+TEST_CASE("CachedNode - skips a finished subtree until its inputs change") {
+    int evaluated = 0;
+    auto tree = Builder()
+                    .sequence()
+                    .cached()
+                    .selector()
+                    .action([&evaluated](Blackboard &bb) {
+                        ++evaluated;
+                        return bb.get<int>("threat").value_or(0) > 5 ? Status::Success : Status::Failure;
+                    })
+                    .action([&evaluated](Blackboard &bb) {
+                        ++evaluated;
+                        return bb.get<bool>("idle").value_or(true) ? Status::Success : Status::Failure;
+                    })
+                    .end()
+                    .end()
+                    .build();
+
+    auto &bb = tree.blackboard();
+    bb.set("threat", 0);
+    bb.set("unrelated", 1);
+    CHECK(tree.tick() == Status::Success);
+    CHECK(evaluated == 2);
+
+    bb.set("unrelated", 2);
+    for (int i = 0; i < 10; ++i) {
+        CHECK(tree.tick() == Status::Success);
+    }
+    CHECK(evaluated == 2);
+
+    bb.set("threat", 9);
+    CHECK(tree.tick() == Status::Success);
+    CHECK(evaluated == 3); // the second branch was not reached, so "idle" is no longer an input
+
+    bb.set("idle", false);
+    CHECK(tree.tick() == Status::Success);
+    CHECK(evaluated == 3);
+
+    // Resetting the tree keeps the result; only new inputs or invalidate() re-run the subtree
+    tree.reset();
+    CHECK(tree.tick() == Status::Success);
+    CHECK(evaluated == 3);
+}
+
+TEST_CASE("CachedNode - nested cache hits still count as reads of the enclosing node") {
+    int evaluated = 0;
+    auto counted = [&evaluated](const char *key) {
+        return [&evaluated, key](Blackboard &bb) {
+            ++evaluated;
+            return bb.get<bool>(key).value_or(false) ? Status::Success : Status::Failure;
+        };
+    };
+    auto tree = Builder()
+                    .cached()
+                    .selector()
+                    .cached()
+                    .action(counted("a"))
+                    .cached()
+                    .action(counted("b"))
+                    .end()
+                    .build();
+
+    CHECK(tree.tick() == Status::Failure);
+    CHECK(evaluated == 2);
+
+    // "b" changes: the outer node re-runs, the "a" check is served from its cache
+    tree.blackboard().set("b", false);
+    CHECK(tree.tick() == Status::Failure);
+    CHECK(evaluated == 3);
+
+    // "a" must still be an input of the outer node
+    tree.blackboard().set("a", true);
+    CHECK(tree.tick() == Status::Success);
+    CHECK(evaluated == 4);
+}
+
+TEST_CASE("CachedNode - running children are always ticked") {
+    auto cached = std::make_shared<CachedNode>(std::make_shared<Action>([](Blackboard &bb) {
+        int step = bb.get<int>("step").value_or(0);
+        if (step < 2) {
+            bb.set("step", step + 1);
+            return Status::Running;
+        }
+        return Status::Success;
+    }));
+    Tree tree(cached);
+
+    CHECK(tree.tick() == Status::Running);
+    CHECK_FALSE(cached->hasCachedStatus());
+    CHECK(tree.tick() == Status::Running);
+    CHECK(tree.tick() == Status::Success);
+    CHECK(cached->hasCachedStatus());
+    CHECK(tree.tick() == Status::Success);
+
+    cached->invalidate();
+    CHECK_FALSE(cached->hasCachedStatus());
+    CHECK(tree.tick() == Status::Success);
+}
+
+TEST_CASE("CachedNode - a halt drops the cached status") {
+    int evaluated = 0;
+    auto cached = std::make_shared<CachedNode>(std::make_shared<Action>([&evaluated](Blackboard &) {
+        ++evaluated;
+        return Status::Success;
+    }));
+    Blackboard bb;
+
+    CHECK(cached->tick(bb) == Status::Success);
+    CHECK(cached->hasCachedStatus());
+    cached->halt();
+    CHECK_FALSE(cached->hasCachedStatus());
+    CHECK(cached->tick(bb) == Status::Failure);
+    CHECK(evaluated == 1);
+
+    cached->reset();
+    CHECK(cached->tick(bb) == Status::Success);
+    CHECK(evaluated == 2);
+}
+
+TEST_CASE("Builder - pending cached() must wrap a node") {
+    Builder builder;
+    builder.sequence().cached();
+    CHECK_THROWS(builder.end());
+}
@@ -0,0 +1,76 @@
+#include <stateup/stateup.hpp>
+#include <doctest/doctest.h>
+
+using namespace stateup;
+using namespace stateup::tree;
+
+namespace {
+    // Runs for `steps` ticks (read from the blackboard), then succeeds or fails depending on "pass"
+    TreeDefinition::Ptr countdown() {
+        return TreeDefinition::define([](Builder &builder) {
+            builder.action([](Blackboard &bb) {
+                int left = bb.get<int>("steps").value_or(0);
+                if (left > 0) {
+                    bb.set("steps", left - 1);
+                    return Status::Running;
+                }
+                return bb.get<bool>("pass").value_or(true) ? Status::Success : Status::Failure;
+            });
+        });
+    }
+
+    template <typename TreeT> void seed(Forest<TreeT> &forest) {
+        for (size_t i = 0; i < forest.size(); ++i) {
+            forest[i].blackboard().set("steps", static_cast<int>(i % 4));
+            forest[i].blackboard().set("pass", i % 3 != 0);
+        }
+    }
+} // namespace
+
+TEST_CASE("Forest ticks all trees and aggregates their statuses") {
+    core::ThreadPool pool(4);
+    auto definition = countdown();
+
+    for (core::ThreadPool *executor : {static_cast<core::ThreadPool *>(nullptr), &pool}) {
+        Forest<TreeInstance> forest(executor, 16);
+        forest.reserve(100);
+        for (int i = 0; i < 100; ++i) {
+            forest.emplace(definition, LockPolicy::None);
+        }
+        seed(forest);
+
+        auto before = forest.counts();
+        CHECK(before.idle == 100);
+        CHECK(before.ticked == 0);
+
+        auto first = forest.tick();
+        CHECK(first.ticked == 100);
+        CHECK(first.running == 75); // steps 1..3
+        CHECK(first.finished() == 25);
+        CHECK(first.success + first.failure + first.running + first.idle == 100);
+
+        // Finished trees are skipped: only those still running are ticked again
+        auto second = forest.tickUnfinished();
+        CHECK(second.ticked == 75);
+        CHECK(second.running == 50);
+        CHECK(forest.tickUnfinished().ticked == 50);
+        auto last = forest.tickUnfinished();
+        CHECK(last.ticked == 25);
+        CHECK(last.running == 0);
+        CHECK(last.failure == 34); // i % 3 == 0
+        CHECK(last.success == 66);
+        CHECK(forest.tickUnfinished().ticked == 0);
+        CHECK(forest.status(1) == Status::Success);
+        CHECK(forest.status(0) == Status::Failure);
+
+        forest.reset();
+        CHECK(forest.counts().idle == 100);
+    }
+}
+
+TEST_CASE("Forest holds any tree type") {
+    Forest<Tree> forest;
+    forest.add(std::make_unique<Tree>(Builder().action([](Blackboard &) { return Status::Success; }).buildRoot()));
+    CHECK(forest.tick().success == 1);
+    CHECK_THROWS_AS(forest.add(nullptr), std::invalid_argument);
+}
@@ -242,3 +242,35 @@ TEST_CASE("Probabilistic transitions - probability of 0.0 never transitions") {
         REQUIRE(machine->getCurrentStateName() == "start");
     }
 }
+
+TEST_CASE("Probabilistic transitions - weighted set follows guards from tick to tick") {
+    // The sampler is reused while the valid weighted transitions stay the same and rebuilt when a guard flips
+    Builder builder;
+    auto machine = builder.state("start")
+                       .transitionTo("a", [](auto &bb) { return bb.template get<bool>("a_open").value_or(false); })
+                       .withWeight(1.0f)
+                       .transitionTo("b", [](auto &) { return true; })
+                       .withWeight(3.0f)
+                       .state("a")
+                       .transitionTo("start", [](auto &) { return true; })
+                       .state("b")
+                       .transitionTo("start", [](auto &) { return true; })
+                       .initial("start")
+                       .build();
+    machine->tick(); // Initialize
+
+    std::map<std::string, int> open, closed;
+    for (int round = 0; round < 2000; ++round) {
+        const bool aOpen = (round / 100) % 2 == 0;
+        machine->blackboard().set("a_open", aOpen);
+        machine->tick(); // start -> a or b
+        (aOpen ? open : closed)[machine->getCurrentStateName()]++;
+        machine->tick(); // back to start
+    }
+
+    CHECK(closed["a"] == 0);
+    CHECK(closed["b"] == 1000);
+    CHECK(open["a"] > 150); // ~250 of 1000
+    CHECK(open["a"] < 350);
+    CHECK(open["a"] + open["b"] == 1000);
+}
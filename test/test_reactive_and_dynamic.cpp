@@ -108,6 +108,27 @@ TEST_CASE("ReactiveSequence - Condition failure restarts sequence") {
     CHECK(result == Status::Failure);
 }
 
+TEST_CASE("ReactiveSequence - Preempted child runs again when the condition recovers") {
+    int ticks = 0;
+    auto body = Builder()
+                    .sequence()
+                    .action([&ticks](Blackboard &) { return ++ticks % 3 ? Status::Running : Status::Success; })
+                    .action([](Blackboard &) { return Status::Success; })
+                    .end()
+                    .buildRoot();
+    auto reactiveSeq = std::make_shared<ReactiveSequence>();
+    reactiveSeq->addChild(body, [](Blackboard &bb) { return bb.get<bool>("enabled").value_or(true); });
+    Tree tree(reactiveSeq);
+
+    CHECK(tree.tick() == Status::Running);
+    tree.blackboard().set("enabled", false);
+    CHECK(tree.tick() == Status::Failure); // halts and resets the running sequence
+    tree.blackboard().set("enabled", true);
+    CHECK(tree.tick() == Status::Running);
+    CHECK(tree.tick() == Status::Success);
+    CHECK(ticks == 3);
+}
+
 TEST_CASE("ReactiveSequence - All children succeed") {
     auto reactiveSeq = std::make_shared<ReactiveSequence>();
 
@@ -0,0 +1,194 @@
+#include <doctest/doctest.h>
+
+#include "stateup/core/executor.hpp"
+#include "stateup/core/random.hpp"
+#include "stateup/state/builder.hpp"
+#include "stateup/tree/builder.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace stateup::tree;
+using stateup::core::RandomStream;
+
+namespace {
+    constexpr int kBranches = 4;
+    constexpr int kChildren = 8;
+
+    struct Picks {
+        std::mutex mutex;
+        std::array<std::vector<int>, kBranches> branches;
+
+        size_t shortest() {
+            std::lock_guard<std::mutex> lock(mutex);
+            size_t count = SIZE_MAX;
+            for (const auto &branch : branches)
+                count = std::min(count, branch.size());
+            return count;
+        }
+    };
+
+    // A sequence of random selectors, each recording which of its children it ran
+    std::unique_ptr<Tree> randomTree(Picks &picks, std::uint64_t seed) {
+        Builder builder;
+        builder.sequence();
+        for (int b = 0; b < kBranches; ++b) {
+            builder.randomSelector();
+            for (int c = 0; c < kChildren; ++c)
+                builder.action([&picks, b, c](Blackboard &) {
+                    picks.branches[b].push_back(c);
+                    return Status::Success;
+                });
+            builder.end();
+        }
+        auto tree = std::make_unique<Tree>(builder.end().buildRoot());
+        tree->setSeed(seed);
+        return tree;
+    }
+
+    std::vector<std::string> machineRun(std::uint64_t seed) {
+        stateup::state::Builder builder;
+        auto machine = builder.state("a")
+                           .transitionTo("b", [](auto &) { return true; })
+                           .withWeight(1.0f)
+                           .transitionTo("c", [](auto &) { return true; })
+                           .withWeight(1.0f)
+                           .state("b")
+                           .transitionTo("a", [](auto &) { return true; })
+                           .withProbability(0.5f)
+                           .state("c")
+                           .transitionTo("a", [](auto &) { return true; })
+                           .withProbability(0.5f)
+                           .initial("a")
+                           .build();
+        machine->setSeed(seed);
+        std::vector<std::string> visited;
+        for (int i = 0; i < 64; ++i) {
+            machine->tick();
+            visited.push_back(machine->getCurrentStateName());
+        }
+        return visited;
+    }
+} // namespace
+
+TEST_CASE("RandomStream - draws depend only on seed, stream and position") {
+    RandomStream a(3, 42), b(3, 42), other(4, 42);
+    std::vector<std::uint64_t> drawn;
+    for (int i = 0; i < 16; ++i) {
+        drawn.push_back(a());
+        CHECK(b() == drawn.back());
+    }
+    CHECK(other() != drawn.front());
+
+    // Seeking back replays; reseeding keeps the position
+    a.seek(5);
+    CHECK(a() == drawn[5]);
+    b.seed(7);
+    CHECK(b.position() == 16);
+    CHECK(b() != drawn.front());
+
+    // Works with the standard distributions, roughly uniformly
+    std::uniform_int_distribution<int> die(0, 5);
+    std::array<int, 6> counts{};
+    for (int i = 0; i < 60'000; ++i)
+        ++counts[die(other)];
+    for (int count : counts)
+        CHECK(count / 60'000.0 == doctest::Approx(1.0 / 6.0).epsilon(0.05));
+}
+
+TEST_CASE("Seeded trees - same seed, same picks") {
+    Picks first, second, reseeded;
+    auto one = randomTree(first, 42);
+    auto two = randomTree(second, 42);
+    auto three = randomTree(reseeded, 43);
+    for (int i = 0; i < 32; ++i) {
+        one->tick();
+        two->tick();
+        three->tick();
+    }
+    for (int b = 0; b < kBranches; ++b) {
+        CHECK(first.branches[b] == second.branches[b]);
+        CHECK(first.branches[b] != reseeded.branches[b]);
+    }
+    // Selectors of one tree draw from different streams
+    CHECK(first.branches[0] != first.branches[1]);
+}
+
+TEST_CASE("Seeded trees - picks do not depend on where children tick") {
+    // The same selectors under a concurrent parallel, ticked inline and as jobs on a pool
+    auto build = [](Picks &picks, LockPolicy policy, stateup::core::ThreadPool *pool) {
+        Builder builder;
+        builder.executor(pool).concurrentParallel(Parallel::Policy::RequireAll, Parallel::Policy::RequireOne);
+        for (int b = 0; b < kBranches; ++b) {
+            builder.randomSelector();
+            for (int c = 0; c < kChildren; ++c)
+                builder.action([&picks, b, c](Blackboard &) {
+                    std::lock_guard<std::mutex> lock(picks.mutex);
+                    picks.branches[b].push_back(c);
+                    return Status::Success;
+                });
+            builder.end();
+        }
+        auto tree = std::make_unique<Tree>(builder.end().buildRoot(), policy);
+        tree->setSeed(7);
+        return tree;
+    };
+
+    stateup::core::ThreadPool pool(4);
+    Picks inlinePicks, pooledPicks;
+    auto inlineTree = build(inlinePicks, LockPolicy::None, nullptr);
+    auto pooledTree = build(pooledPicks, LockPolicy::Mutex, &pool);
+    while (inlinePicks.shortest() < 24)
+        inlineTree->tick();
+    while (pooledPicks.shortest() < 24)
+        pooledTree->tickWhenReady(std::chrono::milliseconds(10));
+
+    for (int b = 0; b < kBranches; ++b) {
+        std::lock_guard<std::mutex> lock(pooledPicks.mutex);
+        const auto &pooled = pooledPicks.branches[b];
+        CHECK(std::vector<int>(pooled.begin(), pooled.begin() + 24) ==
+              std::vector<int>(inlinePicks.branches[b].begin(), inlinePicks.branches[b].begin() + 24));
+    }
+}
+
+TEST_CASE("Seeded tree instances - one definition, separate seeds") {
+    auto definition = TreeDefinition::define([](Builder &builder) {
+        builder.randomSelector();
+        for (int c = 0; c < kChildren; ++c)
+            builder.action([c](Blackboard &bb) {
+                bb.set("pick", c);
+                return Status::Success;
+            });
+        builder.end();
+    });
+    auto run = [](TreeInstance &instance) {
+        std::vector<int> picks;
+        for (int i = 0; i < 32; ++i) {
+            instance.tick();
+            picks.push_back(instance.blackboard().get<int>("pick").value());
+        }
+        return picks;
+    };
+
+    TreeInstance a(definition, LockPolicy::None), b(definition, LockPolicy::None);
+    CHECK(a.seed() != b.seed());
+    CHECK(run(a) != run(b));
+
+    TreeInstance c(definition, LockPolicy::None), d(definition, LockPolicy::None);
+    c.setSeed(5);
+    d.setSeed(5);
+    CHECK(run(c) == run(d));
+}
+
+TEST_CASE("Seeded state machines - same seed, same transitions") {
+    CHECK(machineRun(11) == machineRun(11));
+    CHECK(machineRun(11) != machineRun(12));
+    const auto visited = machineRun(11);
+    CHECK(std::set<std::string>(visited.begin(), visited.end()).size() == 3);
+}
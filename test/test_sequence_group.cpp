@@ -0,0 +1,252 @@
+#include <stateup/stateup.hpp>
+#include <stateup/core/executor.hpp>
+#include <doctest/doctest.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace stateup::tree;
+
+namespace {
+    // Child i reports the status scripted under "s.<i>" and, when it runs, writes the current "tick" to "out.<i>"
+    Status scripted(Blackboard &bb, int i) {
+        const std::string id = std::to_string(i);
+        bb.set("out." + id, bb.get<int>("tick").value_or(0));
+        return static_cast<Status>(bb.get<int>("s." + id).value_or(static_cast<int>(Status::Success)));
+    }
+
+    Builder &addScripted(Builder &builder, int i, bool declare) {
+        const std::string id = std::to_string(i);
+        if (declare)
+            builder.access({"s." + id, "tick"}, {"out." + id});
+        return builder.action([i](Blackboard &bb) { return scripted(bb, i); });
+    }
+
+    std::vector<std::shared_ptr<SequenceGroup>> groupsOf(const NodePtr &root) {
+        std::vector<std::shared_ptr<SequenceGroup>> groups;
+        for (const auto &child : std::static_pointer_cast<Sequence>(root)->getChildren()) {
+            if (auto group = std::dynamic_pointer_cast<SequenceGroup>(child))
+                groups.push_back(group);
+        }
+        return groups;
+    }
+} // namespace
+
+TEST_CASE("Sequence group - build groups consecutive independent children") {
+    Builder builder;
+    builder.sequence()
+        .access({}, {"a"})
+        .action([](Blackboard &) { return Status::Success; })
+        .access({}, {"b"})
+        .action([](Blackboard &) { return Status::Success; })
+        .access({"a"}, {"c"}) // reads what the first one writes
+        .action([](Blackboard &) { return Status::Success; })
+        .action([](Blackboard &) { return Status::Success; }) // undeclared
+        .access({"x"}, {"e"})
+        .action([](Blackboard &) { return Status::Success; })
+        .access({"x"}, {"f"}) // shared reads are fine
+        .action([](Blackboard &) { return Status::Success; })
+        .end();
+    NodePtr root = builder.buildRoot();
+
+    const auto &children = std::static_pointer_cast<Sequence>(root)->getChildren();
+    REQUIRE(children.size() == 4);
+    auto first = std::dynamic_pointer_cast<SequenceGroup>(children[0]);
+    auto last = std::dynamic_pointer_cast<SequenceGroup>(children[3]);
+    REQUIRE(first);
+    REQUIRE(last);
+    CHECK(first->getChildren().size() == 2);
+    CHECK(last->getChildren().size() == 2);
+    CHECK_FALSE(std::dynamic_pointer_cast<SequenceGroup>(children[1]));
+    CHECK_FALSE(std::dynamic_pointer_cast<SequenceGroup>(children[2]));
+
+    CHECK(KeyAccess{{"k"}, {}}.independentOf(KeyAccess{{"k"}, {}}));
+    CHECK_FALSE(KeyAccess{{}, {"k"}}.independentOf(KeyAccess{{}, {"k"}}));
+    CHECK_FALSE(KeyAccess{{"k"}, {}}.independentOf(KeyAccess{{}, {"k"}}));
+}
+
+TEST_CASE("Sequence group - concurrent ticks match a plain sequence tick for tick") {
+    constexpr int kChildren = 6;
+    stateup::core::ThreadPool pool(4);
+
+    Builder grouped;
+    grouped.executor(&pool).sequence();
+    Builder plain;
+    plain.sequence();
+    for (int i = 0; i < kChildren; ++i) {
+        addScripted(grouped, i, true);
+        addScripted(plain, i, false);
+    }
+    Tree groupedTree = grouped.end().build();
+    Tree plainTree = plain.end().build();
+
+    auto groups = groupsOf(groupedTree.getRoot());
+    REQUIRE(groups.size() == 1);
+    groups[0]->setPoolThreshold(std::chrono::nanoseconds(0)); // every child counts as expensive
+
+    std::uint32_t seed = 2024;
+    auto next = [&seed](int n) {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<int>((seed >> 16) % static_cast<std::uint32_t>(n));
+    };
+    for (int tick = 1; tick <= 300; ++tick) {
+        for (Tree *tree : {&groupedTree, &plainTree}) {
+            tree->blackboard().set("tick", tick);
+        }
+        for (int i = 0; i < kChildren; ++i) {
+            // Mostly successes, so runs get deep enough for failures and running children to cut them short
+            const int roll = next(10);
+            const Status status = roll < 7 ? Status::Success : roll < 9 ? Status::Failure : Status::Running;
+            for (Tree *tree : {&groupedTree, &plainTree}) {
+                tree->blackboard().set("s." + std::to_string(i), static_cast<int>(status));
+            }
+        }
+        REQUIRE(groupedTree.tick() == plainTree.tick());
+        for (int i = 0; i < kChildren; ++i) {
+            const std::string key = "out." + std::to_string(i);
+            REQUIRE(groupedTree.blackboard().get<int>(key) == plainTree.blackboard().get<int>(key));
+        }
+    }
+    CHECK(groups[0]->concurrentTicks() > 0);
+}
+
+TEST_CASE("Sequence group - a failure rolls back the writes of later children") {
+    stateup::core::ThreadPool pool(2);
+    Builder builder;
+    builder.executor(&pool)
+        .sequence()
+        .access({}, {"first"})
+        .action([](Blackboard &bb) {
+            bb.set("first", 1);
+            return Status::Failure;
+        })
+        .access({}, {"second"})
+        .action([](Blackboard &bb) {
+            bb.set("second", 2);
+            return Status::Success;
+        })
+        .access({}, {"third"})
+        .action([](Blackboard &bb) {
+            bb.set("third", 3);
+            return Status::Success;
+        })
+        .end();
+    Tree tree = builder.build();
+    auto groups = groupsOf(tree.getRoot());
+    REQUIRE(groups.size() == 1);
+    groups[0]->setPoolThreshold(std::chrono::nanoseconds(0));
+
+    auto &bb = tree.blackboard();
+    bb.set("third", 30);
+    const auto before = bb.keyRevision("third");
+
+    CHECK(tree.tick() == Status::Failure);
+    CHECK(groups[0]->concurrentTicks() == 1);
+    CHECK(bb.get<int>("first") == 1);
+    CHECK_FALSE(bb.has("second"));     // was unset
+    CHECK(bb.get<int>("third") == 30); // old value restored
+    CHECK(bb.keyRevision("third") != before);
+}
+
+TEST_CASE("Sequence group - resumes at a running child like a sequence") {
+    stateup::core::ThreadPool pool(2);
+    int firstCalls = 0;
+    int afterCalls = 0;
+    Builder builder;
+    builder.executor(&pool)
+        .sequence()
+        .access({}, {"done"})
+        .action([&firstCalls](Blackboard &bb) {
+            ++firstCalls;
+            bb.set("done", firstCalls);
+            return firstCalls < 3 ? Status::Running : Status::Success;
+        })
+        .access({}, {"after"})
+        .action([&afterCalls](Blackboard &bb) {
+            ++afterCalls;
+            bb.set("after", true);
+            return Status::Success;
+        })
+        .end();
+    Tree tree = builder.build();
+    auto groups = groupsOf(tree.getRoot());
+    REQUIRE(groups.size() == 1);
+    groups[0]->setPoolThreshold(std::chrono::nanoseconds(0));
+
+    CHECK(tree.tick() == Status::Running);
+    CHECK_FALSE(tree.blackboard().has("after"));
+    CHECK(tree.tick() == Status::Running);
+    CHECK(tree.tick() == Status::Success);
+    CHECK(tree.blackboard().get<bool>("after") == true);
+    CHECK(firstCalls == 3);
+    // Ticked beside the first child once, then only after it succeeded: the running child resumed alone
+    CHECK(afterCalls == 2);
+    CHECK(groups[0]->concurrentTicks() == 1);
+
+    // On an unsynchronized blackboard the group ticks in order on the calling thread
+    const size_t concurrent = groups[0]->concurrentTicks();
+    tree.setLockPolicy(LockPolicy::None);
+    firstCalls = 0;
+    CHECK(tree.tick() == Status::Running);
+    CHECK(tree.tick() == Status::Running);
+    CHECK(tree.tick() == Status::Success);
+    CHECK(groups[0]->concurrentTicks() == concurrent);
+}
+
+TEST_CASE("Sequence group - a cached node above it sees what pooled children read") {
+    stateup::core::ThreadPool pool(2);
+    int runs = 0;
+    Builder builder;
+    builder.executor(&pool).cached().sequence();
+    for (int i = 0; i < 3; ++i) {
+        const std::string id = std::to_string(i);
+        builder.access({"in." + id}, {"out." + id}).action([i, &runs](Blackboard &bb) {
+            const std::string id = std::to_string(i);
+            bb.set("out." + id, bb.get<int>("in." + id).value_or(0));
+            runs += i == 0;
+            return Status::Success;
+        });
+    }
+    Tree tree = builder.end().build();
+    auto cached = std::dynamic_pointer_cast<CachedNode>(tree.getRoot());
+    REQUIRE(cached);
+    auto groups = groupsOf(cached->getChild());
+    REQUIRE(groups.size() == 1);
+    groups[0]->setPoolThreshold(std::chrono::nanoseconds(0));
+
+    auto &bb = tree.blackboard();
+    CHECK(tree.tick() == Status::Success);
+    CHECK(groups[0]->concurrentTicks() == 1);
+    CHECK(tree.tick() == Status::Success);
+    CHECK(runs == 1); // cached
+    for (int i = 0; i < 3; ++i) {
+        const std::string in = "in." + std::to_string(i);
+        bb.set(in, i + 10);
+        CHECK(tree.tick() == Status::Success);
+        CHECK(runs == i + 2); // each child's read, pooled or not, invalidates the cache
+        CHECK(bb.get<int>("out." + std::to_string(i)) == i + 10);
+    }
+}
+
+TEST_CASE("Speculative selector - a cached node above it sees what pooled children read") {
+    stateup::core::ThreadPool pool(2);
+    Builder builder;
+    builder.executor(&pool).cached().speculativeSelector();
+    for (const char *key : {"a", "b", "c"})
+        builder.pure().action([key](Blackboard &bb) { return bb.has(key) ? Status::Success : Status::Failure; });
+    Tree tree = builder.end().build();
+    auto cached = std::dynamic_pointer_cast<CachedNode>(tree.getRoot());
+    REQUIRE(cached);
+    auto selector = std::dynamic_pointer_cast<Selector>(cached->getChild());
+    REQUIRE(selector);
+    selector->setPoolThreshold(std::chrono::nanoseconds(0));
+
+    CHECK(tree.tick() == Status::Failure);
+    CHECK(selector->speculativeTicks() == 1);
+    CHECK(tree.tick() == Status::Failure);
+    CHECK(selector->speculativeTicks() == 1); // cached
+    tree.blackboard().set("c", true);
+    CHECK(tree.tick() == Status::Success); // the last child's read invalidates the cache
+    CHECK(selector->speculativeTicks() == 2);
+}
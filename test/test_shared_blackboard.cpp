@@ -0,0 +1,175 @@
+#include <stateup/tree/shared_blackboard.hpp>
+#include <doctest/doctest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace stateup::tree;
+
+namespace {
+    struct Pose {
+        double x;
+        double y;
+        double theta;
+    };
+
+    std::string segmentName(const char *suffix) { return "/stateup_test_" + std::to_string(::getpid()) + suffix; }
+
+    // Runs body in a forked child and returns its exit code
+    template <typename F> int inChild(F &&body) {
+        pid_t pid = ::fork();
+        if (pid == 0) {
+            ::_exit(body() ? 0 : 1);
+        }
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+} // namespace
+
+TEST_CASE("SharedBlackboard stores trivially copyable values") {
+    const auto name = segmentName("_basic");
+    auto bb = SharedBlackboard::create(name, 16, 32);
+    CHECK(bb->capacity() == 16);
+
+    CHECK_FALSE(bb->has("speed"));
+    CHECK_FALSE(bb->get<double>("speed").has_value());
+
+    bb->set("speed", 1.5);
+    bb->set("pose", Pose{1.0, 2.0, 0.5});
+    CHECK(bb->get<double>("speed").value() == doctest::Approx(1.5));
+    CHECK(bb->get<Pose>("pose")->y == doctest::Approx(2.0));
+    CHECK_FALSE(bb->get<int>("speed").has_value()); // type mismatch
+    CHECK(bb->version("speed") == 1);
+
+    auto slot = bb->slot<double>("speed");
+    slot.store(3.0);
+    CHECK(slot.load().value() == doctest::Approx(3.0));
+    CHECK(slot.version() == 2);
+
+    auto keys = bb->getAllKeys();
+    std::sort(keys.begin(), keys.end());
+    CHECK(keys == std::vector<std::string>{"pose", "speed"});
+
+    CHECK_THROWS_AS(bb->set(std::string(100, 'k'), 1), std::invalid_argument);
+    CHECK_THROWS_AS(SharedBlackboard::create(name), std::runtime_error);
+    CHECK(SharedBlackboard::unlink(name));
+}
+
+TEST_CASE("SharedBlackboard reports a full segment") {
+    const auto name = segmentName("_full");
+    auto bb = SharedBlackboard::create(name, 4, 8);
+    for (int i = 0; i < 4; ++i) {
+        bb->set("k" + std::to_string(i), i);
+    }
+    CHECK(bb->size() == 4);
+    CHECK_THROWS_AS(bb->set("overflow", 1), std::runtime_error);
+    SharedBlackboard::unlink(name);
+}
+
+TEST_CASE("SharedBlackboard rejects a segment whose geometry does not fit") {
+    const auto name = segmentName("_geometry");
+    auto bb = SharedBlackboard::create(name, 16, 32);
+    bb->set("speed", 1.5);
+
+    // Header layout: magic, version (4 bytes each), then capacity, valueSize and slotStride (8 bytes each)
+    int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+    REQUIRE(fd >= 0);
+    auto *raw = static_cast<unsigned char *>(::mmap(nullptr, 64, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+    REQUIRE(raw != MAP_FAILED);
+    auto field = [raw](size_t offset, std::uint64_t value) {
+        std::uint64_t old;
+        std::memcpy(&old, raw + offset, sizeof(old));
+        std::memcpy(raw + offset, &value, sizeof(value));
+        return old;
+    };
+    auto rejected = [&name] {
+        try {
+            SharedBlackboard::open(name);
+        } catch (const std::runtime_error &) {
+            return true;
+        }
+        return false;
+    };
+
+    const std::uint64_t capacity = field(8, 12); // not a power of two
+    CHECK(rejected());
+    field(8, std::uint64_t(1) << 40); // more slots than the segment holds
+    CHECK(rejected());
+    field(8, capacity);
+    const std::uint64_t stride = field(24, 16); // too small for a slot header and its value
+    CHECK(rejected());
+    field(24, stride);
+    const std::uint64_t valueSize = field(16, stride); // value as large as the whole slot
+    CHECK(rejected());
+    field(16, valueSize);
+    CHECK(SharedBlackboard::open(name)->get<double>("speed").value() == doctest::Approx(1.5));
+
+    // Truncated behind the creator's back
+    REQUIRE(::ftruncate(fd, 1024) == 0);
+    CHECK(rejected());
+
+    ::munmap(raw, 64);
+    ::close(fd);
+    SharedBlackboard::unlink(name);
+}
+
+TEST_CASE("SharedBlackboard is shared between forked processes") {
+    const auto name = segmentName("_fork");
+    auto bb = SharedBlackboard::create(name);
+    bb->set("from_parent", 7);
+
+    int code = inChild([&name] {
+        auto child = SharedBlackboard::open(name);
+        if (child->get<int>("from_parent").value_or(0) != 7)
+            return false;
+        child->set("from_child", Pose{4.0, 5.0, 6.0});
+        return true;
+    });
+    CHECK(code == 0);
+
+    auto pose = bb->get<Pose>("from_child");
+    REQUIRE(pose.has_value());
+    CHECK(pose->theta == doctest::Approx(6.0));
+    SharedBlackboard::unlink(name);
+}
+
+TEST_CASE("SharedBlackboard seqlock never exposes torn values") {
+    const auto name = segmentName("_seqlock");
+    auto bb = SharedBlackboard::create(name);
+    auto slot = bb->slot<Pose>("pose");
+    slot.store(Pose{0.0, 0.0, 0.0});
+
+    constexpr int kWrites = 200000;
+    pid_t writer = ::fork();
+    if (writer == 0) {
+        auto child = SharedBlackboard::open(name);
+        auto childSlot = child->slot<Pose>("pose");
+        for (int i = 1; i <= kWrites; ++i) {
+            double v = static_cast<double>(i);
+            childSlot.store(Pose{v, v, v});
+        }
+        ::_exit(0);
+    }
+
+    bool consistent = true;
+    double last = 0.0;
+    while (last < kWrites) {
+        auto pose = slot.load();
+        if (!pose || pose->x != pose->y || pose->y != pose->theta || pose->x < last) {
+            consistent = false;
+            break;
+        }
+        last = pose->x;
+    }
+    int status = 0;
+    ::waitpid(writer, &status, 0);
+    CHECK(consistent);
+    CHECK(slot.version() == kWrites + 1);
+    SharedBlackboard::unlink(name);
+}
@@ -1,8 +1,12 @@
 #include "doctest/doctest.h"
 
+#include "stateup/core/executor.hpp"
 #include "stateup/state/builder.hpp"
 #include "stateup/state/machine.hpp"
+#include <chrono>
 #include <string>
+#include <thread>
+#include <vector>
 
 using namespace stateup;
 
@@ -183,3 +187,41 @@ TEST_CASE("StateMachine: Blackboard access") {
     machine->tick();
     CHECK(machine->blackboard().get<std::string>("current_state").value() == "Idle");
 }
+
+TEST_CASE("StateMachine: Cheap conditions are evaluated inline") {
+    using namespace std::chrono_literals;
+    stateup::core::ThreadPool pool(2);
+    const auto caller = std::this_thread::get_id();
+
+    auto machine = std::make_unique<state::StateMachine>();
+    auto idleState = std::make_shared<IdleState>();
+    auto walkState = std::make_shared<WalkState>();
+    machine->addState(idleState);
+    machine->addState(walkState);
+    machine->setInitialState(idleState);
+    machine->setExecutor(&pool);
+    machine->setPoolThreshold(1ms);
+
+    std::thread::id cheapThread;
+    std::vector<std::thread::id> slowThreads(2);
+    machine->addTransition(idleState, walkState, [&](tree::Blackboard &) {
+        cheapThread = std::this_thread::get_id();
+        return false;
+    });
+    for (size_t i = 0; i < slowThreads.size(); ++i) {
+        machine->addTransition(idleState, walkState, [&, i](tree::Blackboard &) {
+            std::this_thread::sleep_for(3ms);
+            slowThreads[i] = std::this_thread::get_id();
+            return false;
+        });
+    }
+
+    machine->tick(); // enter Idle
+    machine->tick(); // every condition is pooled while unmeasured
+    machine->tick();
+    CHECK(machine->getCurrentStateName() == "Idle");
+    CHECK(cheapThread == caller);
+    for (auto id : slowThreads) {
+        CHECK(id != caller);
+    }
+}
@@ -0,0 +1,167 @@
+#include <stateup/stateup.hpp>
+#include <doctest/doctest.h>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+using namespace stateup::tree;
+namespace st = stateup::tree::static_tree;
+
+namespace {
+    // Leaves report the status scripted under their key and count their calls, so a static tree and its runtime
+    // twin can be driven tick by tick from two blackboards holding the same script
+    Status scripted(Blackboard &bb, const std::string &key) {
+        bb.set("calls." + key, bb.get<int>("calls." + key).value_or(0) + 1);
+        return static_cast<Status>(bb.get<int>(key).value_or(static_cast<int>(Status::Success)));
+    }
+
+    Status runA(Blackboard &bb) { return scripted(bb, "a"); }
+    Status runB(Blackboard &bb) { return scripted(bb, "b"); }
+    Status runC(Blackboard &bb) { return scripted(bb, "c"); }
+    bool ready(Blackboard &bb) { return bb.get<bool>("ready").value_or(true); }
+
+    Status succeed(Blackboard &) { return Status::Success; }
+    Status fail(Blackboard &) { return Status::Failure; }
+    Status keepRunning(Blackboard &) { return Status::Running; }
+
+    int calls(Blackboard &bb, const std::string &key) { return bb.get<int>("calls." + key).value_or(0); }
+} // namespace
+
+TEST_CASE("Static tree - matches the runtime nodes tick for tick") {
+    using Shape = st::seq<st::cond<&ready>, st::sel<st::inv<st::act<&runA>>, st::retry<3, st::act<&runB>>>, st::act<&runC>>;
+    st::StaticTree<Shape> fixed;
+    Blackboard fixedBoard;
+
+    auto dynamic = Builder()
+                       .sequence()
+                       .action([](Blackboard &bb) { return ready(bb) ? Status::Success : Status::Failure; })
+                       .selector()
+                       .inverter()
+                       .action(&runA)
+                       .retry(3)
+                       .action(&runB)
+                       .end()
+                       .action(&runC)
+                       .end()
+                       .buildRoot();
+    Blackboard dynamicBoard;
+
+    // A fixed pseudo-random script over every status a leaf can report
+    std::uint32_t seed = 12345;
+    auto next = [&seed](int n) {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<int>((seed >> 16) % static_cast<std::uint32_t>(n));
+    };
+    for (int tick = 0; tick < 500; ++tick) {
+        const bool isReady = next(5) != 0;
+        const int a = next(3), b = next(3), c = next(3);
+        for (Blackboard *bb : {&fixedBoard, &dynamicBoard}) {
+            bb->set("ready", isReady);
+            bb->set("a", a);
+            bb->set("b", b);
+            bb->set("c", c);
+        }
+        REQUIRE(fixed.tick(fixedBoard) == dynamic->tick(dynamicBoard));
+    }
+    for (const char *key : {"a", "b", "c"}) {
+        CHECK(calls(fixedBoard, key) == calls(dynamicBoard, key));
+        CHECK(calls(fixedBoard, key) > 0);
+    }
+}
+
+TEST_CASE("Static tree - sequence and selector resume at the running child") {
+    st::StaticTree<st::seq<st::act<&runA>, st::act<&runB>>> sequence;
+    Blackboard bb;
+    bb.set("a", static_cast<int>(Status::Success));
+    bb.set("b", static_cast<int>(Status::Running));
+
+    CHECK(sequence.tick(bb) == Status::Running);
+    CHECK(sequence.tick(bb) == Status::Running);
+    CHECK(calls(bb, "a") == 1);
+    CHECK(calls(bb, "b") == 2);
+    CHECK(sequence.state().index == 1);
+
+    bb.set("b", static_cast<int>(Status::Success));
+    CHECK(sequence.tick(bb) == Status::Success);
+    CHECK(sequence.state().index == 0);
+    CHECK(calls(bb, "a") == 1);
+
+    st::StaticTree<st::sel<st::act<&fail>, st::act<&keepRunning>, st::act<&succeed>>> selector;
+    CHECK(selector.tick(bb) == Status::Running);
+    CHECK(selector.state().index == 1);
+}
+
+TEST_CASE("Static tree - retry and inverter") {
+    Blackboard bb;
+    st::StaticTree<st::retry<3, st::act<&fail>>> retry;
+    CHECK(retry.tick(bb) == Status::Running);
+    CHECK(retry.state().attempts == 1);
+    CHECK(retry.tick(bb) == Status::Running);
+    CHECK(retry.tick(bb) == Status::Failure);
+    CHECK(retry.state().attempts == 0);
+
+    st::StaticTree<st::retry<3, st::act<&succeed>>> succeeds;
+    CHECK(succeeds.tick(bb) == Status::Success);
+
+    st::StaticTree<st::inv<st::act<&fail>>> inverted;
+    CHECK(inverted.tick(bb) == Status::Success);
+    st::StaticTree<st::inv<st::act<&keepRunning>>> running;
+    CHECK(running.tick(bb) == Status::Running);
+
+    // Captureless lambdas work as callbacks too
+    st::StaticTree<st::inv<st::cond<[](Blackboard &b) { return b.has("flag"); }>>> lambda;
+    CHECK(lambda.tick(bb) == Status::Success);
+    bb.set("flag", true);
+    CHECK(lambda.tick(bb) == Status::Failure);
+}
+
+TEST_CASE("Static tree - halt fails until reset and only reaches the running child") {
+    using Shape = st::seq<st::act<&succeed>, st::act<&keepRunning>, st::act<&succeed>>;
+    st::StaticTree<Shape> tree;
+    Blackboard bb;
+
+    CHECK(tree.tick(bb) == Status::Running);
+    tree.halt();
+    CHECK(tree.tick(bb) == Status::Failure);
+    CHECK(std::get<0>(tree.state().children).status == Node::State::Idle);
+    CHECK(std::get<1>(tree.state().children).status == Node::State::Halted);
+    CHECK(std::get<2>(tree.state().children).status == Node::State::Idle);
+
+    tree.reset();
+    CHECK(std::get<1>(tree.state().children).status == Node::State::Idle);
+    CHECK(tree.tick(bb) == Status::Running);
+}
+
+TEST_CASE("Static tree - an expired tick budget yields between children") {
+    st::StaticTree<st::seq<st::act<&runA>, st::act<&runB>, st::act<&runC>>> tree;
+    Blackboard bb;
+    TickBudget budget(std::chrono::steady_clock::now() - std::chrono::seconds(1));
+
+    CHECK(tree.tick(bb) == Status::Running);
+    CHECK(tree.tick(bb) == Status::Running);
+    CHECK(tree.tick(bb) == Status::Success);
+    CHECK(budget.yielded());
+    CHECK(calls(bb, "a") == 1);
+    CHECK(calls(bb, "c") == 1);
+}
+
+TEST_CASE("Static tree - embedded in a runtime tree") {
+    using Guarded = st::seq<st::cond<&ready>, st::act<&runA>>;
+    auto tree = Builder()
+                    .selector()
+                    .leaf(st::makeNode<Guarded>())
+                    .action(&runB)
+                    .end()
+                    .build();
+
+    auto &bb = tree.blackboard();
+    bb.set("a", static_cast<int>(Status::Running));
+    CHECK(tree.tick() == Status::Running);
+    CHECK(calls(bb, "a") == 1);
+
+    bb.set("ready", false);
+    tree.reset();
+    CHECK(tree.tick() == Status::Success);
+    CHECK(calls(bb, "a") == 1);
+    CHECK(calls(bb, "b") == 1);
+}
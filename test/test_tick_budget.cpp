@@ -0,0 +1,140 @@
+#include <stateup/stateup.hpp>
+#include <doctest/doctest.h>
+#include <chrono>
+#include <thread>
+
+using namespace stateup::tree;
+using namespace std::chrono_literals;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    void describeSlowSequence(Builder &builder, int &ran) {
+        builder.sequence();
+        for (int i = 0; i < 5; ++i) {
+            builder.action([&ran](Blackboard &) {
+                ++ran;
+                std::this_thread::sleep_for(2ms);
+                return Status::Success;
+            });
+        }
+        builder.end();
+    }
+} // namespace
+
+TEST_CASE("Tick budget - a sequence yields when the deadline passes and resumes") {
+    int ran = 0;
+    Builder builder;
+    describeSlowSequence(builder, ran);
+    auto tree = builder.build();
+
+    CHECK(tree.tick(Clock::now() + 3ms) == Status::Running);
+    CHECK(ran >= 1);
+    CHECK(ran < 5);
+    CHECK(tree.nextWakeup() == Clock::time_point::min()); // cut short, so due again right away
+
+    Status status = Status::Running;
+    for (int i = 0; i < 10 && status == Status::Running; ++i) {
+        status = tree.tickWithin(3ms);
+    }
+    CHECK(status == Status::Success);
+    CHECK(ran == 5); // every child ran exactly once
+}
+
+TEST_CASE("Tick budget - an expired deadline still makes progress") {
+    int iterations = 0;
+    auto tree = Builder()
+                    .forLoop(4, [&iterations](Builder &b) {
+                        b.action([&iterations](Blackboard &) {
+                            ++iterations;
+                            return Status::Success;
+                        });
+                    })
+                    .build();
+
+    const auto past = Clock::now() - 1s;
+    for (int i = 1; i <= 3; ++i) {
+        CHECK(tree.tick(past) == Status::Running);
+        CHECK(iterations == i);
+    }
+    CHECK(tree.tick(past) == Status::Success);
+    CHECK(iterations == 4);
+
+    // Without a deadline the loop finishes in one tick
+    CHECK(tree.tick() == Status::Success);
+    CHECK(iterations == 8);
+}
+
+TEST_CASE("Tick budget - while loops yield between iterations") {
+    auto tree = Builder()
+                    .whileLoop([](Blackboard &bb) { return bb.get<int>("n").value_or(0) < 3; },
+                               [](Builder &b) {
+                                   b.action([](Blackboard &bb) {
+                                       bb.set("n", bb.get<int>("n").value_or(0) + 1);
+                                       return Status::Success;
+                                   });
+                               })
+                    .build();
+
+    const auto past = Clock::now() - 1s;
+    CHECK(tree.tick(past) == Status::Running);
+    CHECK(tree.blackboard().get<int>("n") == 1);
+    CHECK(tree.tick(past) == Status::Running);
+    CHECK(tree.tick(past) == Status::Running); // third iteration ran; the condition is checked next tick
+    CHECK(tree.tick(past) == Status::Success);
+    CHECK(tree.blackboard().get<int>("n") == 3);
+}
+
+TEST_CASE("Tick budget - compiled trees honour the deadline") {
+    int ran = 0;
+    Builder builder;
+    describeSlowSequence(builder, ran);
+    auto compiled = builder.buildCompiled();
+
+    CHECK(compiled.tick(Clock::now() - 1s) == Status::Running);
+    CHECK(ran == 1);
+    CHECK(compiled.tick() == Status::Success);
+    CHECK(ran == 5);
+}
+
+TEST_CASE("Tick monitor - durations, jitter and overruns") {
+    auto tree = Builder()
+                    .action([](Blackboard &bb) {
+                        if (bb.get<bool>("slow").value_or(false))
+                            std::this_thread::sleep_for(3ms);
+                        return Status::Success;
+                    })
+                    .build();
+    CHECK_FALSE(tree.monitoring());
+
+    int overruns = 0;
+    TickMonitor::Duration late{0};
+    tree.monitor().setOverrunCallback([&](const TickMonitor::Overrun &overrun) {
+        ++overruns;
+        late = overrun.late;
+    });
+    CHECK(tree.monitoring());
+
+    for (int i = 0; i < 10; ++i) {
+        tree.tickWithin(1s);
+    }
+    tree.blackboard().set("slow", true);
+    tree.tickWithin(1ms);
+    tree.tick(); // no deadline, never a miss
+
+    auto stats = tree.monitor().stats();
+    CHECK(stats.ticks == 12);
+    CHECK(stats.deadlineTicks == 11);
+    CHECK(stats.misses == 1);
+    CHECK(overruns == 1);
+    CHECK(late >= 1ms);
+    CHECK(stats.max >= 3ms);
+    CHECK(stats.p50 < 3ms);
+    CHECK(stats.p50 <= stats.p90);
+    CHECK(stats.p90 <= stats.p99);
+    CHECK(stats.p99 <= stats.max);
+    CHECK(stats.jitter > TickMonitor::Duration(0));
+
+    tree.monitor().clear();
+    CHECK(tree.monitor().stats().ticks == 0);
+}
@@ -0,0 +1,175 @@
+#include <stateup/stateup.hpp>
+#include <doctest/doctest.h>
+#include <chrono>
+#include <memory>
+
+using namespace stateup::tree;
+using stateup::core::task;
+using namespace std::chrono_literals;
+
+namespace {
+    using Clock = TickClock::Clock;
+
+    // Counts how often the tree asks for the time
+    class CountingClock final : public TickClock {
+      public:
+        Clock::time_point now() const override {
+            ++reads;
+            return Clock::time_point{} + 1h;
+        }
+        mutable int reads = 0;
+    };
+} // namespace
+
+TEST_CASE("Tick clock - simulated clock moves only when told") {
+    SimulatedClock clock;
+    CHECK(clock.now() == Clock::time_point{});
+    clock.advance(90s);
+    CHECK(clock.now() == Clock::time_point{} + 90s);
+    clock.advanceTo(Clock::time_point{} + 30s); // already past
+    CHECK(clock.now() == Clock::time_point{} + 90s);
+    clock.advanceTo(Clock::time_point{} + 2min);
+    CHECK(clock.now() == Clock::time_point{} + 2min);
+    clock.set(Clock::time_point{});
+    CHECK(clock.now() == Clock::time_point{});
+}
+
+TEST_CASE("Tick clock - sampled once per tick, shared by nested ticks") {
+    auto clock = std::make_shared<CountingClock>();
+    Clock::time_point seen[3];
+    auto inner = Builder()
+                     .action([&](Blackboard &) {
+                         seen[2] = TickTime::now();
+                         return Status::Success;
+                     })
+                     .build();
+    auto tree = Builder()
+                    .sequence()
+                    .action([&](Blackboard &) {
+                        seen[0] = TickTime::now();
+                        return Status::Success;
+                    })
+                    .action([&](Blackboard &) {
+                        seen[1] = TickTime::now();
+                        return inner.tick();
+                    })
+                    .end()
+                    .build();
+    tree.setClock(clock);
+
+    CHECK(tree.tick() == Status::Success);
+    CHECK(clock->reads == 1);
+    CHECK(seen[0] == Clock::time_point{} + 1h);
+    CHECK(seen[1] == seen[0]);
+    CHECK(seen[2] == seen[0]); // the clockless inner tree runs on the outer tick's time
+
+    CHECK(tree.tick() == Status::Success);
+    CHECK(clock->reads == 2);
+
+    // A tree without timed nodes never reads its clock
+    auto plain = Builder().action([](Blackboard &) { return Status::Success; }).build();
+    plain.setClock(clock);
+    plain.tick();
+    CHECK(clock->reads == 2);
+}
+
+TEST_CASE("Tick clock - timeout and cooldown fast-forward a simulated day") {
+    auto clock = std::make_shared<SimulatedClock>();
+    int fallbacks = 0;
+    auto tree = Builder()
+                    .selector()
+                    .decorator(decorators::Timeout(3600.0f))
+                    .action([](Blackboard &) { return Status::Running; })
+                    .action([&fallbacks](Blackboard &) {
+                        ++fallbacks;
+                        return Status::Success;
+                    })
+                    .end()
+                    .build();
+    tree.setClock(clock);
+
+    // A tick per simulated minute. The hour-long job times out at minute 60 and every 61 minutes after that (it
+    // restarts on the tick after timing out), each time handing over to the fallback.
+    int succeeded = 0;
+    for (int minute = 0; minute < 24 * 60; ++minute) {
+        succeeded += tree.tick() == Status::Success;
+        clock->advance(1min);
+    }
+    CHECK(succeeded == 23);
+    CHECK(fallbacks == 23);
+
+    // After a success, Cooldown turns the child's other results into failures for ten simulated minutes
+    int calls = 0;
+    auto cooled = Builder()
+                      .decorator(decorators::Cooldown(600.0f))
+                      .action([&calls](Blackboard &) { return ++calls == 1 ? Status::Success : Status::Running; })
+                      .build();
+    cooled.setClock(clock);
+    CHECK(cooled.tick() == Status::Success);
+    clock->advance(9min);
+    CHECK(cooled.tick() == Status::Failure);
+    clock->advance(1min);
+    CHECK(cooled.tick() == Status::Running);
+}
+
+TEST_CASE("Tick clock - debounce and sleeping coroutines wake on simulated time") {
+    auto clock = std::make_shared<SimulatedClock>();
+    int finished = 0;
+    auto tree = Builder()
+                    .sequence()
+                    .debounce(std::chrono::duration_cast<std::chrono::milliseconds>(5min))
+                    .action([](Blackboard &) { return Status::Success; })
+                    .actionTask([&finished](Blackboard &) -> task<Status> {
+                        co_await sleepFor(2h);
+                        ++finished;
+                        co_return Status::Success;
+                    })
+                    .end()
+                    .build();
+    tree.setClock(clock);
+
+    // Step straight to each wakeup instead of sleeping: debounce, then the two-hour sleep
+    int ticks = 0;
+    Status status = Status::Running;
+    while (status == Status::Running && ticks < 10) {
+        if (auto next = tree.nextWakeup())
+            clock->advanceTo(*next);
+        status = tree.tick();
+        ++ticks;
+    }
+    CHECK(status == Status::Success);
+    CHECK(finished == 1);
+    CHECK(clock->now() == Clock::time_point{} + 5min + 2h);
+    CHECK(ticks <= 4);
+}
+
+TEST_CASE("Tick clock - timed transitions run on the state machine's clock") {
+    auto clock = std::make_shared<SimulatedClock>();
+    auto machine = stateup::state::Builder()
+                       .state("night")
+                       .transitionToAfter("day", 12h)
+                       .state("day")
+                       .transitionToAfter("night", 12h)
+                       .initial("night")
+                       .build();
+    machine->setClock(clock);
+    machine->enableTransitionHistory();
+
+    machine->tick();
+    CHECK(machine->getCurrentStateName() == "night");
+    clock->advance(11h);
+    machine->tick();
+    CHECK(machine->getCurrentStateName() == "night");
+    clock->advance(1h);
+    machine->tick();
+    CHECK(machine->getCurrentStateName() == "day");
+    CHECK(machine->getTransitionHistory().back().timestamp == Clock::time_point{} + 12h);
+
+    // Seven simulated days, a tick per simulated hour
+    for (int hour = 0; hour < 7 * 24; ++hour) {
+        clock->advance(1h);
+        machine->tick();
+    }
+    CHECK(machine->getCurrentStateName() == "day");
+    CHECK(machine->getTransitionHistory().size() == 1 + 1 + 14);
+}
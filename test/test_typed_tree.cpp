@@ -0,0 +1,103 @@
+#include <stateup/stateup.hpp>
+#include <doctest/doctest.h>
+
+using namespace stateup;
+using namespace stateup::tree;
+
+namespace {
+    struct Robot {
+        double speed = 0.0;
+        int waypoint = 0;
+        int battery = 100;
+    };
+} // namespace
+
+TEST_CASE("TypedBuilder actions receive the context") {
+    auto tree = TypedBuilder<Robot>()
+                    .sequence()
+                    .action([](Robot &robot) {
+                        robot.speed = 1.5;
+                        return Status::Success;
+                    })
+                    .action([](Robot &robot, Blackboard &bb) {
+                        bb.set("dynamic", robot.waypoint + 1); // fallback to dynamic keys
+                        ++robot.waypoint;
+                        return Status::Success;
+                    })
+                    .action([](Blackboard &bb) { return bb.has("dynamic") ? Status::Success : Status::Failure; })
+                    .end()
+                    .build(Robot{0.0, 4, 100});
+
+    CHECK(tree.tick() == Status::Success);
+    CHECK(tree.context().speed == doctest::Approx(1.5));
+    CHECK(tree.context().waypoint == 5);
+    CHECK(tree.blackboard().get<int>("dynamic").value() == 5);
+    CHECK(&tree.blackboard().context<Robot>() == &tree.context());
+}
+
+TEST_CASE("TypedBuilder branches and decorators keep the context") {
+    auto tree = TypedBuilder<Robot>()
+                    .lockPolicy(LockPolicy::None)
+                    .sequence()
+                    .condition([](Robot &robot) { return robot.battery < 20; },
+                               [](TypedBuilder<Robot> &then) {
+                                   then.action([](Robot &robot) {
+                                       robot.speed = 0.0;
+                                       return Status::Success;
+                                   });
+                               },
+                               [](TypedBuilder<Robot> &otherwise) {
+                                   otherwise.action([](Robot &robot) {
+                                       robot.battery -= 50;
+                                       robot.speed = 2.0;
+                                       return Status::Success;
+                                   });
+                               })
+                    .inverter()
+                    .action([](Robot &robot) { return robot.speed > 0.0 ? Status::Failure : Status::Success; })
+                    .end()
+                    .build();
+
+    CHECK(tree.lockPolicy() == LockPolicy::None);
+    CHECK(tree.tick() == Status::Success);
+    CHECK(tree.context().battery == 50);
+    CHECK(tree.context().speed == doctest::Approx(2.0));
+
+    tree.context().battery = 10;
+    CHECK(tree.tick() == Status::Failure);
+    CHECK(tree.context().speed == doctest::Approx(0.0));
+}
+
+TEST_CASE("Blackboard context lookups are type checked") {
+    Blackboard bb;
+    CHECK(bb.contextPtr<Robot>() == nullptr);
+    CHECK_THROWS_AS(bb.context<Robot>(), std::runtime_error);
+
+    Robot robot;
+    bb.bindContext(&robot);
+    CHECK(bb.contextPtr<Robot>() == &robot);
+    CHECK(bb.contextPtr<int>() == nullptr);
+
+    auto untyped = Builder().action(contextual<Robot>([](Robot &r) { return r.battery > 0 ? Status::Success
+                                                                                              : Status::Failure; }))
+                       .build();
+    CHECK_THROWS_AS(untyped.tick(), std::runtime_error); // nothing bound on this tree
+}
+
+TEST_CASE("TypedStateMachine callbacks reach the context") {
+    auto machine = state::Builder()
+                       .initial("drive")
+                       .state("drive")
+                       .onUpdate(contextual<Robot>([](Robot &robot) { robot.battery -= 30; }))
+                       .transitionTo("charge", contextual<Robot>([](Robot &robot) { return robot.battery < 20; }))
+                       .state("charge")
+                       .onEnter(contextual<Robot>([](Robot &robot) { robot.speed = 0.0; }))
+                       .buildTyped(Robot{1.0, 0, 100});
+
+    for (int i = 0; i < 5; ++i) {
+        machine->tick();
+    }
+    CHECK(machine->getCurrentStateName() == "charge");
+    CHECK(machine->context().battery < 20);
+    CHECK(machine->context().speed == doctest::Approx(0.0));
+}
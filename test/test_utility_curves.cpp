@@ -0,0 +1,157 @@
+#include <stateup/stateup.hpp>
+#include <doctest/doctest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace stateup::tree;
+
+namespace {
+    NodePtr choose(const std::string &name) {
+        return std::make_shared<Action>([name](Blackboard &bb) {
+            bb.set("chosen", name);
+            return Status::Success;
+        });
+    }
+} // namespace
+
+TEST_CASE("ResponseCurve - shapes and clamping") {
+    auto linear = ResponseCurve::linear(2.0f, -0.5f);
+    CHECK(linear(0.5f) == doctest::Approx(0.5f));
+    CHECK(linear(-3.0f) == 0.0f);
+    CHECK(linear(3.0f) == 1.0f);
+
+    auto logistic = ResponseCurve::logistic(10.0f, 2.0f);
+    CHECK(logistic(10.0f) == doctest::Approx(0.5f));
+    CHECK(logistic(20.0f) > 0.99f);
+    CHECK(logistic(0.0f) < 0.01f);
+
+    auto piecewise = ResponseCurve::piecewise({{0.0f, 0.0f}, {1.0f, 1.0f}, {3.0f, 0.2f}});
+    CHECK(piecewise(-1.0f) == 0.0f);
+    CHECK(piecewise(0.5f) == doctest::Approx(0.5f));
+    CHECK(piecewise(2.0f) == doctest::Approx(0.6f));
+    CHECK(piecewise(9.0f) == doctest::Approx(0.2f));
+
+    CHECK_THROWS_AS(ResponseCurve::piecewise({}), std::invalid_argument);
+    CHECK_THROWS_AS(ResponseCurve::piecewise({{1.0f, 0.0f}, {0.0f, 1.0f}}), std::invalid_argument);
+}
+
+TEST_CASE("UtilityModel - a batch scores every agent like scoring them one by one") {
+    UtilityModel model;
+    model.addOption({{"hunger", ResponseCurve::linear()}, {"food", ResponseCurve::logistic(5.0f, -1.0f)}});
+    model.addOption({{"fatigue", ResponseCurve::piecewise({{0.0f, 0.0f}, {0.5f, 0.2f}, {1.0f, 1.0f}})},
+                     {"hunger", ResponseCurve::linear(-1.0f, 1.0f)}});
+    model.addOption({});
+    REQUIRE(model.optionCount() == 3);
+    CHECK(model.inputs() == std::vector<std::string>{"hunger", "food", "fatigue"});
+
+    constexpr size_t kAgents = 37; // not a multiple of any vector width
+    std::vector<Blackboard> boards(kAgents);
+    for (size_t a = 0; a < kAgents; ++a) {
+        boards[a].set("hunger", static_cast<float>(a % 10) / 10.0f);
+        boards[a].set("food", static_cast<float>(a % 7));
+        if (a % 3 != 0)
+            boards[a].set("fatigue", static_cast<float>(a % 5) / 5.0f);
+    }
+
+    std::vector<float> inputs(model.inputCount() * kAgents);
+    for (size_t a = 0; a < kAgents; ++a) {
+        model.gather(boards[a], inputs.data() + a, kAgents);
+    }
+    std::vector<float> batch(model.optionCount() * kAgents);
+    model.scoreBatch(inputs.data(), kAgents, batch.data());
+
+    std::vector<float> one(model.inputCount());
+    std::vector<float> scores(model.optionCount());
+    for (size_t a = 0; a < kAgents; ++a) {
+        model.gather(boards[a], one.data());
+        model.score(one.data(), scores.data());
+        for (size_t o = 0; o < model.optionCount(); ++o) {
+            CHECK(batch[o * kAgents + a] == doctest::Approx(scores[o]));
+        }
+        const float hunger = boards[a].get<float>("hunger").value();
+        CHECK(scores[0] == doctest::Approx(hunger * ResponseCurve::logistic(5.0f, -1.0f)(one[1])));
+        CHECK(scores[2] == 1.0f);
+    }
+}
+
+TEST_CASE("UtilitySelector - considerations are re-scored only when their inputs change") {
+    auto selector = std::make_shared<UtilitySelector>();
+    selector->addChild(choose("eat"), {{"hunger", ResponseCurve::linear()}});
+    selector->addChild(choose("sleep"), {{"fatigue", ResponseCurve::linear()}});
+    int called = 0;
+    selector->addChild(choose("idle"), [&called](Blackboard &) {
+        ++called;
+        return 0.1f;
+    });
+    Tree tree(selector);
+    auto &bb = tree.blackboard();
+
+    bb.set("hunger", 0.8f);
+    bb.set("fatigue", 0.3f);
+    CHECK(tree.tick() == Status::Success);
+    CHECK(bb.get<std::string>("chosen") == "eat");
+    CHECK(selector->scores().modelEvaluations() == 1);
+
+    bb.set("unrelated", 1);
+    tree.tick();
+    CHECK(selector->scores().modelEvaluations() == 1);
+    CHECK(called == 2); // callbacks still run every tick
+
+    bb.set("fatigue", 0.9f);
+    tree.tick();
+    CHECK(selector->scores().modelEvaluations() == 2);
+    CHECK(bb.get<std::string>("chosen") == "sleep");
+
+    bb.set("hunger", -1.0f);
+    bb.set("fatigue", -1.0f);
+    tree.tick();
+    CHECK(bb.get<std::string>("chosen") == "idle");
+}
+
+TEST_CASE("UtilitySelector - hysteresis keeps the last choice until it is clearly beaten") {
+    auto selector = std::make_shared<UtilitySelector>();
+    selector->addChild(choose("eat"), {{"hunger", ResponseCurve::linear()}});
+    selector->addChild(choose("sleep"), {{"fatigue", ResponseCurve::linear()}});
+    selector->setHysteresis(0.2f);
+    Tree tree(selector);
+    auto &bb = tree.blackboard();
+
+    bb.set("hunger", 0.5f);
+    bb.set("fatigue", 0.4f);
+    tree.tick();
+    CHECK(bb.get<std::string>("chosen") == "eat");
+
+    bb.set("fatigue", 0.65f); // ahead, but within the margin
+    tree.tick();
+    CHECK(bb.get<std::string>("chosen") == "eat");
+
+    bb.set("fatigue", 0.75f);
+    tree.tick();
+    CHECK(bb.get<std::string>("chosen") == "sleep");
+
+    bb.set("hunger", 0.6f);
+    tree.tick();
+    CHECK(bb.get<std::string>("chosen") == "sleep");
+}
+
+TEST_CASE("WeightedRandomSelector - considerations as weights") {
+    auto selector = std::make_shared<WeightedRandomSelector>();
+    selector->addChild(choose("flee"), {{"danger", ResponseCurve::linear()}});
+    selector->addChild(choose("graze"), {{"danger", ResponseCurve::linear(-1.0f, 1.0f)}});
+    Tree tree(selector);
+    auto &bb = tree.blackboard();
+
+    bb.set("danger", 1.0f);
+    for (int i = 0; i < 20; ++i) {
+        CHECK(tree.tick() == Status::Success);
+        CHECK(bb.get<std::string>("chosen") == "flee");
+    }
+    CHECK(selector->weights().modelEvaluations() == 1);
+
+    auto empty = std::make_shared<WeightedRandomSelector>();
+    empty->addChild(choose("never"), {{"missing", ResponseCurve::linear()}});
+    Blackboard other;
+    CHECK(empty->tick(other) == Status::Failure);
+}
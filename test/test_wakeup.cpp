@@ -0,0 +1,142 @@
+#include <stateup/stateup.hpp>
+#include <doctest/doctest.h>
+#include <chrono>
+#include <thread>
+
+using namespace stateup::tree;
+using stateup::core::task;
+using namespace std::chrono_literals;
+
+namespace {
+    using Clock = Wakeup::Clock;
+
+    bool dueNow(const Tree &tree) {
+        auto next = tree.nextWakeup();
+        return next && *next <= Clock::now();
+    }
+} // namespace
+
+TEST_CASE("Wakeup - new, finished and polling trees are due immediately") {
+    auto tree = Builder()
+                    .action([](Blackboard &bb) {
+                        int n = bb.get<int>("n").value_or(0);
+                        bb.set("n", n + 1);
+                        return n < 1 ? Status::Running : Status::Success;
+                    })
+                    .build();
+
+    CHECK(dueNow(tree));
+    CHECK(tree.tickWhenReady() == Status::Running);
+    CHECK(dueNow(tree)); // a plain function can only be polled
+    CHECK(tree.tickWhenReady() == Status::Success);
+    CHECK(dueNow(tree));
+}
+
+TEST_CASE("Wakeup - sleeping coroutines are not resumed early") {
+    int resumed = 0;
+    auto tree = Builder()
+                    .actionTask([&resumed](Blackboard &) -> task<Status> {
+                        ++resumed;
+                        co_await sleepFor(30ms);
+                        ++resumed;
+                        co_return Status::Success;
+                    })
+                    .build();
+
+    const auto start = Clock::now();
+    CHECK(tree.tick() == Status::Running);
+    CHECK(resumed == 1);
+    auto next = tree.nextWakeup();
+    REQUIRE(next.has_value());
+    CHECK(*next >= start + 30ms);
+
+    // Ticking early does not resume the coroutine
+    CHECK(tree.tick() == Status::Running);
+    CHECK(tree.tick() == Status::Running);
+    CHECK(resumed == 1);
+
+    CHECK(tree.tickWhenReady() == Status::Success);
+    CHECK(Clock::now() - start >= 30ms);
+    CHECK(resumed == 2);
+}
+
+TEST_CASE("Wakeup - a Signal fired from another thread wakes the tree") {
+    Signal done;
+    int resumed = 0;
+    auto tree = Builder()
+                    .actionTask([&resumed, done](Blackboard &) -> task<Status> {
+                        ++resumed;
+                        co_await done;
+                        ++resumed;
+                        co_return Status::Success;
+                    })
+                    .build();
+
+    CHECK(tree.tick() == Status::Running);
+    CHECK_FALSE(tree.nextWakeup().has_value()); // nothing but the signal can make progress
+    CHECK(tree.tick() == Status::Running);
+    CHECK(resumed == 1);
+
+    std::thread worker([done]() mutable {
+        std::this_thread::sleep_for(20ms);
+        done.fire();
+    });
+    CHECK(tree.tickWhenReady(5s) == Status::Success);
+    CHECK(resumed == 2);
+    worker.join();
+}
+
+TEST_CASE("Wakeup - maxWait bounds the sleep and wake() cuts it short") {
+    Signal never;
+    auto tree = Builder()
+                    .actionTask([never](Blackboard &) -> task<Status> {
+                        co_await never;
+                        co_return Status::Success;
+                    })
+                    .build();
+    CHECK(tree.tick() == Status::Running);
+
+    auto start = Clock::now();
+    CHECK(tree.tickWhenReady(20ms) == Status::Running);
+    CHECK(Clock::now() - start >= 20ms);
+
+    tree.wake();
+    CHECK(dueNow(tree));
+    start = Clock::now();
+    CHECK(tree.tickWhenReady(5s) == Status::Running);
+    CHECK(Clock::now() - start < 1s);
+}
+
+TEST_CASE("Wakeup - futures are polled at the configured interval") {
+    std::promise<Status> promise;
+    auto future = promise.get_future().share();
+    Tree asyncTree(std::make_shared<Action>(Action::AsyncFunc([future](Blackboard &) {
+        return std::async(std::launch::deferred, [future]() { return future.get(); });
+    })));
+    asyncTree.wakeup()->setFuturePollInterval(5ms);
+
+    const auto start = Clock::now();
+    // A deferred future never reports ready to wait_for, so the action keeps polling
+    CHECK(asyncTree.tick() == Status::Running);
+    auto next = asyncTree.nextWakeup();
+    REQUIRE(next.has_value());
+    CHECK(*next >= start + 5ms);
+    promise.set_value(Status::Success);
+}
+
+TEST_CASE("Wakeup - debounce schedules its stability deadline") {
+    auto tree = Builder().debounce(25ms).action([](Blackboard &) { return Status::Success; }).build();
+
+    const auto start = Clock::now();
+    CHECK(tree.tick() == Status::Running);
+    auto next = tree.nextWakeup();
+    REQUIRE(next.has_value());
+    CHECK(*next >= start + 25ms);
+
+    Status status = Status::Running;
+    for (int i = 0; i < 5 && status == Status::Running; ++i) {
+        status = tree.tickWhenReady(1s);
+    }
+    CHECK(status == Status::Success);
+    CHECK(Clock::now() - start >= 25ms);
+}